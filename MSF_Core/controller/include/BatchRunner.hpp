@@ -0,0 +1,106 @@
+/*
+* @file BatchRunner.hpp
+* @brief In-process Monte Carlo batches: many independently seeded replicas of one scenario, run concurrently.
+* The scenario file is parsed once (SCF::parse_settings) and shared read-only; every replica gets its own
+* Controller, and so its own registry, scheduler and clock. Replicas are spread over a ThreadPool, one
+* replica per participant at a time, and each replica ticks serially on the thread that runs it. Entity IDs
+* are per thread (see Entity::get_next_id) and reset for every replica, so a replica numbers its entities
+* exactly like a standalone run.
+*
+* Replica i runs with seed base_seed + i, so any replica can be rerun on its own with --seed. As replicas
+* finish, their outcomes are streamed into BatchStatistics (end time, wall time and the closest approach of
+* every missile to the waypoints); the summary only depends on the set of outcomes, not on the order they
+* finished in, so it is the same for any thread count.
+* @author Brandon Coulter
+* @date 2026-03-25
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ArgParse.hpp"
+#include "Controller.hpp"
+#include "SCF.hpp"
+
+// Samples of named per-replica metrics. add() may be called from any thread.
+class BatchStatistics {
+public:
+    struct Summary {
+        std::size_t count = 0;
+        double mean = 0.0;
+        double stddev = 0.0;
+        double min = 0.0;
+        double p5 = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double max = 0.0;
+    };
+
+    void add(const std::string& metric, double value);
+
+    // Metric names in the order they were first added
+    std::vector<std::string> get_metrics() const;
+    // Summary of the metric's finite samples (count 0 for unknown metrics or only infinite samples).
+    // Percentiles interpolate linearly between the sorted samples.
+    Summary summarize(const std::string& metric) const;
+
+    void report() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::pair<std::string, std::vector<double>>> samples_;
+};
+
+class BatchRunner {
+public:
+    struct ReplicaOutcome {
+        std::size_t index = 0;
+        uint64_t seed = 0;
+        bool ok = false; // False if the replica failed to initialize
+        double wall_ms = 0.0;
+        Controller::RunOutcome run;
+    };
+
+    // options.replicas replicas on options.batch_threads threads (0 = one per core), seeded from options.seed
+    explicit BatchRunner(const ArgParse::Options& options) : options_(options) {}
+
+    // Parse the scenario, run every replica and write the results CSV if one was asked for. Returns false if
+    // the scenario can't be read or any replica failed.
+    bool run();
+
+    // Outcomes in replica order
+    const std::vector<ReplicaOutcome>& get_outcomes() const {
+        return outcomes_;
+    }
+    const BatchStatistics& get_statistics() const {
+        return statistics_;
+    }
+
+    // One row per replica: index, seed, ok, end time, ticks, entities, wall ms, then one closest approach
+    // column per missile
+    bool write_results(const std::string& path) const;
+
+    // Log throughput and the statistics summary
+    void report() const;
+
+    static uint64_t replica_seed(uint64_t base_seed, std::size_t index) {
+        return base_seed + index;
+    }
+
+private:
+    void run_replica(std::size_t index);
+
+    ArgParse::Options options_;
+    std::shared_ptr<const SCF> scenario_;
+    std::vector<ReplicaOutcome> outcomes_; // Sized up front; each replica writes only its own entry
+    BatchStatistics statistics_;
+    std::size_t thread_count_ = 1;
+    double wall_ms_ = 0.0;
+};
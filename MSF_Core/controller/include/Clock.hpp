@@ -54,6 +54,20 @@ public:
         sim_time_seconds_ += dt_seconds;
     }
 
+    // Advance by whole dt steps until sim time reaches target (always at least one step). Rounds
+    // exactly like the same number of advance(dt) calls would. Returns the number of steps taken.
+    uint64_t advance_until(SimTime target_seconds, SimDt dt_seconds) {
+        if (is_sim_time_paused_) {
+            return 0;
+        }
+        uint64_t steps = 0;
+        do {
+            sim_time_seconds_ += dt_seconds;
+            ++steps;
+        } while (sim_time_seconds_ < target_seconds);
+        return steps;
+    }
+
     void pause_sim_time() {
         is_sim_time_paused_ = true;
     }
@@ -9,15 +9,30 @@
 #pragma once
 #include <iostream>
 #include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "Checkpoint.hpp"
 #include "Clock.hpp"
 #include "Scheduler.hpp"
 #include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "MissDistanceTracker.hpp"
+#include "Profiler.hpp"
+#include "RealTimePacer.hpp"
+#include "StateHashRecorder.hpp"
+#include "TickEngine.hpp"
+#include "TickMonitor.hpp"
+#include "TrajectoryRecorder.hpp"
 
 #include "Entity.hpp"
 #include "Missile.hpp"
 #include "SCF.hpp"
+#include "ArgParse.hpp"
 
 class Controller {
 public:
@@ -31,18 +46,91 @@ public:
     void pause();
     void resume();
 
-    // Simulation Initialization
-    void initialize(const std::string& scenario_path);
+    // Simulation Initialization. Returns false (after logging why) if the scenario or checkpoint can't be
+    // loaded. The second form shares a scenario already read with SCF::parse_settings.
+    bool initialize(const ArgParse::Options& options);
+    bool initialize(const ArgParse::Options& options, std::shared_ptr<const SCF> scenario);
     void shutdown();
 
+    // Run as one replica of a batch (call before initialize): serial ticks, no pacing, no output files,
+    // no branches, and the closest approach of every missile to the waypoints is tracked for the outcome.
+    // seed is the replica's random seed.
+    void configure_replica(uint64_t replica_seed);
+    uint64_t get_seed() const {
+        return seed;
+    }
+
+    // Summary of the finished run, filled in by shutdown()
+    struct RunOutcome {
+        double end_time = 0.0;        // Sim time the run ended at
+        uint64_t ticks = 0;           // Tick frames, including fast-forwarded ones
+        std::size_t entity_count = 0; // Entities still registered at the end
+        std::vector<std::pair<std::string, double>> closest_approaches; // Replicas only, see MissDistanceTracker
+    };
+    const RunOutcome& get_outcome() const {
+        return outcome;
+    }
+
+    // Per-tick wall-time histogram and overrun watchdog; the histogram may be read from any thread
+    const TickMonitor& get_tick_monitor() const {
+        return tick_monitor;
+    }
+
 private:
+    // Main loop; returns when the run ends (is_running false) or at the branch point
+    void run_loop();
+    // Capture the world at the branch point, then restore it, apply the branch's overrides and run it to
+    // the end once per <Branch>
+    void run_branches();
+    void report_branches() const;
+
+    // True when the coming ticks can only change through events: no entity is due an update
+    // (paused, or every entity static or asleep) and nothing is queued for the next safe point
+    bool can_fast_forward();
+    // Jump the clock to the next event, trajectory output, checkpoint or branch time
+    void fast_forward();
+
+    void configure_scheduler(const ArgParse::Options& options);
+    // Schedule the end of the run and start the clock at t=0 (not used when restoring)
+    void schedule_shutdown();
+
+    // Rebuild the world from a checkpoint file; false (after logging why) on failure, like a bad SCF
+    bool restore_checkpoint(const std::string& path);
+    void save_checkpoint();
+    // Callbacks of checkpointable events, when first scheduled and when restored
+    EventCallback make_shutdown_event();
+    EventCallback bind_event(const EventTag& tag, EventDescriptionId description_id);
+
     SimulationClock clock;
     SimEventScheduler scheduler;
     EntityRegistry registry;
-    SCF scf = SCF(); // Initialize SCF with reference to the entity registry
+    TickEngine tick_engine; // Serial or parallel entity update step
+    TrajectoryRecorder trajectory_recorder; // Optional <Output><Trajectory/> recording
+    RealTimePacer pacer; // Holds each tick until wall time catches up when real-time pacing is on
+    TickMonitor tick_monitor; // Tick latency histogram and deadline watchdog
+    CheckpointWriter checkpoint_writer; // Periodic full-state checkpoints, written off the loop thread
+    StateHashRecorder state_hasher; // Optional --state-hash per-entity state hashes
+    std::shared_ptr<const SCF> scf; // Parsed scenario; shared read-only between batch replicas
+    MissDistanceTracker miss_tracker; // Replicas only
+    RunOutcome outcome;
 
     msf::SimDt dt = 0.001; // Simulation time step (seconds)
 
     bool is_running = true; // Flag to track if the simulation is running
     bool is_paused = false; // Flag to track if the simulation is paused
+    bool fast_forward_enabled = true; // --no-fast-forward steps through idle ticks one by one
+    uint64_t fast_forward_ticks = 0; // Ticks skipped by fast_forward()
+    bool is_replica = false; // Part of a batch (see configure_replica)
+    uint64_t seed = 0; // Random seed of the run
+
+    // Outcome of one branch, reported at shutdown
+    struct BranchResult {
+        std::string name;
+        double end_time = 0.0;
+        std::size_t entity_count = 0;
+        double wall_ms = 0.0;
+    };
+    double branch_time = std::numeric_limits<double>::infinity(); // Pending branch point, +infinity if none
+    double branch_prefix_ms = 0.0; // Wall time of the shared prefix
+    std::vector<BranchResult> branch_results;
 }; // Controller class definition
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 class ArgParse {
@@ -7,6 +9,25 @@ public:
     struct Options {
         std::string scenario_path = "Test/scenario/basic.xml";
         bool show_help = false;
+        std::size_t tick_threads = 0; // Entity update threads; 0 = use the SCF setting
+        std::string scheduler_backend; // "heap" or "wheel"; empty = use the SCF setting
+        std::string log_level = "debug"; // Runtime log threshold: debug, info, warning, error or off
+        bool profile = false; // Time loop phases, entity classes and event types; summary at shutdown
+        std::string trace_path; // Chrome trace JSON output; implies profile
+        std::size_t trace_ticks = 100; // Ticks captured in the trace
+        bool fast_forward = true; // Jump over ticks where no entity needs integrating
+        double time_scale = -1.0; // Real-time pacing factor, 0 = as fast as possible, < 0 = use the SCF setting
+        double tick_deadline_ms = -1.0; // Tick overrun watchdog threshold (wall ms), 0 = off, < 0 = use the SCF setting
+        std::string checkpoint_path; // Checkpoint file; empty = use the SCF setting
+        double checkpoint_interval = -1.0; // Sim seconds between checkpoints, < 0 = use the SCF setting
+        std::string restore_path; // Resume from this checkpoint instead of the scenario's entities
+        bool branches = true; // Fork the SCF's <Branches> at their branch point; false runs the trunk to the end
+        uint64_t seed = 1; // Random seed of the run; batch replica i uses seed + i
+        std::size_t replicas = 0; // Monte Carlo replicas run side by side, 0 = one ordinary run
+        std::size_t batch_threads = 0; // Threads running replicas, 0 = one per core
+        std::string batch_results_path; // Per-replica outcome CSV; empty = summary only
+        std::string state_hash_path; // Per-entity state hashes for run comparison; empty = off
+        std::size_t state_hash_interval = 100; // Ticks between state hash samples
     };
 
     static bool parse(int argc, char** argv, Options& options, std::string& error_message);
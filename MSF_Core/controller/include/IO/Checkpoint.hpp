@@ -0,0 +1,130 @@
+/*
+* @file Checkpoint.hpp
+* @brief Full-state checkpoints of a running simulation and restoring a run from one.
+* A checkpoint holds everything the loop needs to carry on as if it had never stopped: sim time,
+* timestep, tick engine frame and run seed, every registered entity (class, ID, registry slot and whatever
+* Entity::save_state writes), the registry's slot layout, the entity ID counter and every pending
+* tagged event (see EventTag.hpp). Opaque events have no serializable form and are left out.
+*
+* Checkpoints are captured on the simulation thread at a safe point between ticks (removals applied,
+* requests scheduled, nothing due fired yet), which only serializes into a reused memory buffer.
+* CheckpointWriter's background thread does the file I/O: it writes a temporary file and renames it
+* over the target, so a crash mid-write leaves the previous checkpoint intact. A checkpoint that
+* falls due while the previous one is still being written is skipped rather than waited for.
+*
+* Restoring reads the file into memory and rebuilds the world directly, without parsing the
+* scenario's entities or re-simulating. Layout (host byte order, strings are uint32 length + bytes):
+*   char[8] magic "MSFCKPT", uint32 version
+*   double sim_time, double dt, uint64 tick_frame, uint64 seed, int32 next_entity_id
+*   uint32 class_count, class_count x string
+*   uint32 slot_count, uint32 free_count, free_count x uint32
+*   uint32 entity_count, entity_count x (uint16 class, int32 id, uint32 slot, uint32 state_size, state)
+*   uint32 event_count, event_count x (double time, string description, uint8 kind, int32 entity_id, uint8 argument)
+* Entities are stored in registry (dense) order and events in firing order.
+* @author Brandon Coulter
+* @date 2026-03-24
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EntityRegistry.hpp"
+#include "EventTag.hpp"
+#include "Scheduler.hpp"
+#include "StateStream.hpp"
+
+class Checkpoint {
+public:
+    static constexpr char kMagic[8] = {'M', 'S', 'F', 'C', 'K', 'P', 'T', '\0'};
+    static constexpr uint32_t kVersion = 2;
+
+    // Loop state saved beside the world
+    struct RunState {
+        double sim_time = 0.0;
+        double dt = 0.0;
+        uint64_t tick_frame = 0;
+        uint64_t seed = 0; // Run seed keying the entities' random streams
+    };
+
+    // Builds the callback of a restored event from its tag. An empty callback drops the event.
+    using EventBinder = std::function<EventCallback(const EventTag& tag, EventDescriptionId description_id)>;
+
+    // Serialize the run into out (cleared first). Fails if an entity's class was not registered by
+    // name. skipped_events is set to the number of Opaque events left out.
+    static bool capture(const RunState& run, const EntityRegistry& registry, const SimEventScheduler& scheduler,
+                        StateWriter& out, std::size_t& skipped_events, std::string& error);
+
+    // Rebuild a run from a captured buffer or checkpoint file. registry must be empty, with its classes
+    // registered and the scheduler attached; the scheduler must be empty. Sets the entity ID counter.
+    static bool restore(const char* data, std::size_t size, RunState& run, EntityRegistry& registry,
+                        SimEventScheduler& scheduler, const EventBinder& bind, std::string& error);
+    static bool restore_file(const std::string& path, RunState& run, EntityRegistry& registry,
+                             SimEventScheduler& scheduler, const EventBinder& bind, std::string& error);
+};
+
+class CheckpointWriter {
+public:
+    CheckpointWriter() = default;
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    // Start the writer thread. A checkpoint falls due every interval_seconds of sim time after
+    // start_time; interval 0 only writes when save() is called directly.
+    bool open(const std::string& path, double interval_seconds, double start_time);
+
+    // Capture the run now and hand it to the writer thread. Returns false if the capture failed or
+    // the previous checkpoint is still being written (this one is then skipped).
+    bool save(const Checkpoint::RunState& run, const EntityRegistry& registry, const SimEventScheduler& scheduler);
+
+    // Wait for the write in progress and stop the writer thread.
+    void close();
+
+    // Sim time at which the next checkpoint is due (+infinity while closed or without an interval)
+    double next_checkpoint_time() const;
+    bool is_due(double t) const {
+        return t >= next_checkpoint_time();
+    }
+
+    bool is_open() const {
+        return writer_.joinable();
+    }
+    uint64_t get_checkpoints_written() const;
+
+    // Log how many checkpoints were written and skipped and how long capturing them took
+    void report() const;
+
+private:
+    void run_writer();
+    bool write_file(const std::vector<char>& bytes);
+
+    // Simulation thread state
+    std::string path_;
+    double interval_ = 0.0;
+    uint64_t next_index_ = 0; // Next checkpoint is due at next_index_ * interval_
+    StateWriter capture_;     // Reused capture buffer; swapped with writing_ when handed over
+    uint64_t captured_ = 0;
+    uint64_t skipped_busy_ = 0;
+    double capture_ms_total_ = 0.0;
+    double capture_ms_max_ = 0.0;
+
+    // Hand-off between the simulation thread and the writer
+    mutable std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::vector<char> writing_; // Owned by the writer while busy_
+    double writing_time_ = 0.0;
+    bool busy_ = false;
+    bool stopping_ = false;
+    uint64_t written_ = 0;
+
+    std::thread writer_;
+};
@@ -15,6 +15,8 @@
 #include "Entity.hpp"
 #include "EntityRegistry.hpp"
 #include "EventRequest.hpp"
+#include "EventTag.hpp"
+#include "Logger.hpp"
 #include "Missile.hpp"
 #include "SimTime.hpp"
 #include "Waypoint.hpp"
@@ -27,15 +29,74 @@
 
 class SCF {
 public:
+    // Optional <SimulationSetup> settings beyond the timestep
+    struct SimulationSetup {
+        msf::SimDt timestep = 0.001; // <TimeStepInterval>
+        std::size_t tick_threads = 1; // <ParallelTick threads="n|auto"/>, 1 = serial
+        std::size_t tick_grain = 0;   // <ParallelTick grain="n"/>, 0 = automatic
+        std::string scheduler_backend = "heap"; // <EventScheduler backend="heap|wheel"/>
+        double time_scale = 0.0; // <RealTime scale="x"/>, 0 = as fast as possible
+        double tick_deadline_ms = -1.0; // <TickDeadline ms="x"/>, 0 = off, < 0 = the paced tick period
+    };
+
+    // Optional <Output> settings
+    struct OutputOptions {
+        bool trajectory_enabled = false;     // Set when a <Trajectory file="..."/> element is present
+        std::string trajectory_file;         // <Trajectory file="path.msft"/>
+        double trajectory_rate_hz = 100.0;   // <Trajectory rate="hz"/>, in simulation time
+        std::string checkpoint_file;         // <Checkpoint file="path.ckpt"/>, empty = no checkpoints
+        double checkpoint_interval = 60.0;   // <Checkpoint interval="s"/>, in simulation time
+    };
+
+    // One <Branch name="..."> of a <Branches> block and its <Override entity="..."> elements
+    struct Branch {
+        std::string name;
+        std::vector<XMLParser::XMLNode> overrides; // Valid while this SCF is alive
+    };
+
+    // Optional <Branches at="s">: simulate up to "at" once, then continue each branch from that state
+    struct BranchPlan {
+        double time = -1.0; // Sim time of the branch point, < 0 = no branches
+        std::vector<Branch> branches;
+
+        bool is_enabled() const {
+            return time >= 0.0 && !branches.empty();
+        }
+    };
+
     SCF() = default;
     SCF(const std::string& filepath) : scf_filepath(filepath) {}
 
     ~SCF() = default;
 
-    bool parse_scf(EntityRegistry& registry, msf::SimDt& timestep);
+    // load_entities = false reads only the settings (used when restoring a checkpoint)
+    bool parse_scf(EntityRegistry& registry, msf::SimDt& timestep, bool load_entities = true);
     bool load_scf(const std::string& filepath);
 
-    void parse_entity(EntityRegistry& registry, const XMLParser::XMLNode& entity_node);
+    // parse_scf in two steps: load the file and read its settings once, then create the entities in
+    // any number of registries (create_entities only reads the parsed document)
+    bool parse_settings(msf::SimDt& timestep);
+    bool create_entities(EntityRegistry& registry) const;
+
+    void parse_entity(EntityRegistry& registry, const XMLParser::XMLNode& entity_node) const;
+    void parse_parallel_tick(const XMLParser::XMLNode& parallel_tick_node);
+    void parse_event_scheduler(const XMLParser::XMLNode& event_scheduler_node);
+    void parse_real_time(const XMLParser::XMLNode& real_time_node);
+    void parse_tick_deadline(const XMLParser::XMLNode& tick_deadline_node);
+    void parse_output(const XMLParser::XMLNode& output_node);
+    void parse_checkpoint(const XMLParser::XMLNode& checkpoint_node);
+    void parse_branches(const XMLParser::XMLNode& branches_node);
+    void parse_model_type(Entity& entity, const XMLParser::XMLNode& model_type_node) const;
+    void parse_entity_parameters(Entity& entity, const XMLParser::XMLNode& parameters_node) const;
+    void parse_emplacement(Entity& entity, const XMLParser::XMLNode& emplacement_node) const;
+    void parse_event_triggers(Entity& entity, const XMLParser::XMLNode& event_triggers_node) const;
+
+    // Apply a branch's overrides to the world restored at the branch point
+    bool apply_branch(EntityRegistry& registry, const Branch& branch) const;
+
+    // Trigger events: the tag that lets a checkpoint save one, and its callback (also used on restore)
+    static EventTag make_trigger_tag(const std::string& type, const Entity& entity);
+    static EventCallback make_trigger_callback(EventDescriptionId type_id, Entity& entity, const EventTag& tag);
 
     // Getters and Setters
     void set_scf_filepath(const std::string& filepath) {
@@ -44,6 +105,15 @@ public:
     std::string get_scf_filepath() const {
         return scf_filepath;
     }
+    const SimulationSetup& get_simulation_setup() const {
+        return setup_options;
+    }
+    const OutputOptions& get_output_options() const {
+        return output_options;
+    }
+    const BranchPlan& get_branch_plan() const {
+        return branch_plan;
+    }
 
 protected:
 
@@ -51,4 +121,7 @@ private:
     // Private Variables
     std::string scf_filepath;
     XMLParser parser;
+    SimulationSetup setup_options; // Parsed <SimulationSetup> extras
+    OutputOptions output_options; // Parsed <Output> block
+    BranchPlan branch_plan; // Parsed <Branches> block
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+/*
+* @file StateHashRecorder.hpp
+* @brief Writes a state hash file (see StateHashFile.hpp): per-entity state hashes every K sim ticks.
+* An entity's hash covers its class and everything save_state() writes, i.e. everything a checkpoint
+* would keep, bit for bit. The recorder is also the scheduler's EventObserver and hashes the events
+* fired since the previous sample (time, description, tag), so a run that fires different events, or
+* the same events in a different order, diverges even before any entity state does.
+* Samples fall on ticks that are multiples of K counted from t=0, so a run that fast-forwards
+* (next_sample_time() is one of its targets) or was restored from a checkpoint samples the same ticks
+* as one that didn't. Hashing serializes every entity, so pick K to keep it off the hot path.
+* @author Brandon Coulter
+* @date 2026-03-25
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "EntityRegistry.hpp"
+#include "Scheduler.hpp"
+#include "StateHashFile.hpp"
+#include "StateStream.hpp"
+
+class StateHashRecorder : public EventObserver {
+public:
+    // Create the file and write the header. Samples are taken every interval_ticks ticks of dt.
+    bool open(const std::string& path, uint32_t interval_ticks, double dt);
+
+    // Take a sample if sim time t is on a sampling tick not yet sampled. Call once per tick, after updates.
+    void record(const EntityRegistry& registry, double t);
+
+    void on_event_fired(SimulationClock::SimTime execution_time, EventDescriptionId description_id,
+                        const EventTag& tag) override;
+
+    void close();
+
+    // Sim time at which the next sample is due (+infinity while closed)
+    double next_sample_time() const;
+
+    bool is_open() const {
+        return out_.is_open();
+    }
+    const std::string& get_path() const {
+        return path_;
+    }
+    uint32_t get_interval_ticks() const {
+        return interval_ticks_;
+    }
+    uint64_t get_samples_recorded() const {
+        return samples_recorded_;
+    }
+
+private:
+    uint64_t description_hash(EventDescriptionId description_id);
+
+    std::ofstream out_;
+    std::string path_;
+    uint32_t interval_ticks_ = 1;
+    double dt_ = 0.0;
+    uint64_t next_tick_ = 0; // Earliest tick still to be sampled
+    uint64_t samples_recorded_ = 0;
+    uint64_t event_hash_ = state_hash_format::kSeed; // Events fired since the previous sample
+    uint64_t events_fired_ = 0;
+    StateWriter state_; // Reused serialization buffer
+    std::vector<std::pair<int32_t, uint64_t>> entity_hashes_;
+    std::vector<uint64_t> description_hashes_; // Indexed by EventDescriptionId, 0 until first seen
+};
@@ -0,0 +1,69 @@
+/*
+* @file TrajectoryFormat.hpp
+* @brief On-disk layout of MSF trajectory files (*.msft), shared by TrajectoryRecorder and TrajectoryReader.
+* A file is a fixed header followed by a sequence of self-describing blocks. All values are
+* little-endian and written with their native sizes.
+*
+*   Header : char magic[8] = "MSFTRAJ1", uint32 version, uint32 column_count, double output_interval_s
+*   Block  : uint32 tag, uint32 entity_count, uint64 payload_bytes, payload
+*     ENTS : entity_count x { int32 id, uint16 name_length, char name[name_length] }
+*            Written whenever the set of registered entities changes; applies to the frames after it.
+*     FRAM : double sim_time, int32 ids[entity_count], double columns[column_count][entity_count]
+*            One output sample. Each column is contiguous (columnar), see TrajectoryColumn.
+* Readers skip blocks with unknown tags, so new block types can be added without a version bump.
+* @author Brandon Coulter
+* @date 2026-03-16
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace trajectory_format {
+
+constexpr char kMagic[8] = {'M', 'S', 'F', 'T', 'R', 'A', 'J', '1'};
+constexpr uint32_t kVersion = 1;
+
+constexpr uint32_t make_tag(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(static_cast<unsigned char>(a))
+         | static_cast<uint32_t>(static_cast<unsigned char>(b)) << 8
+         | static_cast<uint32_t>(static_cast<unsigned char>(c)) << 16
+         | static_cast<uint32_t>(static_cast<unsigned char>(d)) << 24;
+}
+
+constexpr uint32_t kEntityTableTag = make_tag('E', 'N', 'T', 'S');
+constexpr uint32_t kFrameTag = make_tag('F', 'R', 'A', 'M');
+
+// Column order inside a FRAM block. Velocities are NaN for entities without physics state.
+enum TrajectoryColumn : uint32_t {
+    kPositionX, kPositionY, kPositionZ,
+    kOrientationW, kOrientationX, kOrientationY, kOrientationZ,
+    kVelocityX, kVelocityY, kVelocityZ,
+    kAngularVelocityX, kAngularVelocityY, kAngularVelocityZ,
+    kColumnCount,
+};
+
+constexpr const char* kColumnNames[kColumnCount] = {
+    "px", "py", "pz", "qw", "qx", "qy", "qz", "vx", "vy", "vz", "wx", "wy", "wz",
+};
+
+#pragma pack(push, 1)
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t column_count;
+    double output_interval;
+};
+
+struct BlockHeader {
+    uint32_t tag;
+    uint32_t entity_count;
+    uint64_t payload_bytes;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(FileHeader) == 24, "Trajectory file header must stay 24 bytes");
+static_assert(sizeof(BlockHeader) == 16, "Trajectory block header must stay 16 bytes");
+
+} // namespace trajectory_format
@@ -0,0 +1,63 @@
+/*
+* @file TrajectoryReader.hpp
+* @brief Streams frames back out of a trajectory file written by TrajectoryRecorder.
+* Frames are read one at a time, so files larger than memory can be post-processed. Entity names
+* from ENTS blocks are tracked as they are encountered.
+* @author Brandon Coulter
+* @date 2026-03-16
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "TrajectoryFormat.hpp"
+
+class TrajectoryReader {
+public:
+    struct Frame {
+        double time = 0.0;
+        std::vector<int32_t> ids;
+        std::vector<double> columns; // column-major, see value()
+
+        std::size_t size() const {
+            return ids.size();
+        }
+        // Column `column` (a trajectory_format::TrajectoryColumn) of the i-th entity in this frame
+        double value(uint32_t column, std::size_t i) const {
+            return columns[column * ids.size() + i];
+        }
+    };
+
+    // Open the file and validate the header
+    bool open(const std::string& path);
+
+    // Read the next frame; returns false at end of file or on a malformed block (see get_error()).
+    bool next_frame(Frame& frame);
+
+    double get_output_interval() const {
+        return output_interval_;
+    }
+    uint32_t get_column_count() const {
+        return column_count_;
+    }
+    // Name of an entity from the most recent entity table, or an empty string if unknown
+    const std::string& entity_name(int32_t id) const;
+
+    const std::string& get_error() const {
+        return error_;
+    }
+
+private:
+    bool fail(const std::string& message);
+
+    std::ifstream file_;
+    double output_interval_ = 0.0;
+    uint32_t column_count_ = 0;
+    std::unordered_map<int32_t, std::string> names_;
+    std::string error_;
+};
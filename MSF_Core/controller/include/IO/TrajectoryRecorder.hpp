@@ -0,0 +1,111 @@
+/*
+* @file TrajectoryRecorder.hpp
+* @brief Samples entity state at a fixed output rate and streams it to a columnar binary file.
+* Sampling runs on the simulation thread and only copies positions, orientations and velocities
+* into a recycled frame buffer; a background thread owns the file and does all of the I/O.
+* The output rate is independent of the simulation timestep. See TrajectoryFormat.hpp for the layout.
+* On ticks that reach an output time the Controller passes the recorder to TickEngine::tick as its
+* TickObserver, so each entity is captured right after its update instead of in a second pass over
+* every entity (which costs about as much as the update itself).
+* @author Brandon Coulter
+* @date 2026-03-16
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "EntityRegistry.hpp"
+#include "PhysicsEntity.hpp"
+#include "TickEngine.hpp"
+#include "TrajectoryFormat.hpp"
+
+class TrajectoryRecorder : public TickObserver {
+public:
+    TrajectoryRecorder() = default;
+    ~TrajectoryRecorder() override;
+
+    TrajectoryRecorder(const TrajectoryRecorder&) = delete;
+    TrajectoryRecorder& operator=(const TrajectoryRecorder&) = delete;
+
+    // Create the file, write the header and start the writer thread. rate_hz is samples per sim second.
+    bool open(const std::string& path, double rate_hz);
+
+    // Take a sample if sim time t has reached the next output time. Call once per tick, after updates.
+    void record(const EntityRegistry& registry, double t);
+
+    // Fused sampling: if t (the sim time after the coming tick) reaches the next output time, start a
+    // frame and return the observer to pass to TickEngine::tick; otherwise return nullptr. Each
+    // entity is captured from on_entity_updated(), then finish_sample() hands the frame to the writer.
+    TickObserver* begin_sample(const EntityRegistry& registry, double t);
+    void on_entity_updated(std::size_t slot, const Entity& entity) override;
+    void finish_sample();
+
+    // Write out everything still queued, close the file and stop the writer thread.
+    void close();
+
+    // Sim time at which the next sample is due (+infinity while closed)
+    double next_sample_time() const;
+
+    bool is_open() const {
+        return writer_.joinable();
+    }
+    double get_output_interval() const {
+        return output_interval_;
+    }
+    // Number of frames handed to the writer so far
+    uint64_t get_frames_recorded() const {
+        return frames_recorded_;
+    }
+
+private:
+    // One output sample (plus an ENTS table when membership changed). The simulation thread fills it
+    // row by row, which keeps each capture to a couple of cache lines; the writer transposes it into
+    // the columnar FRAM layout.
+    struct Frame {
+        double time = 0.0;
+        std::vector<int32_t> ids;
+        std::vector<double> rows; // row-major: rows[i * trajectory_format::kColumnCount + c]
+        std::vector<std::pair<int32_t, std::string>> entity_table; // Empty unless membership changed
+    };
+
+    void capture(std::size_t slot, const Entity& entity);
+    std::unique_ptr<Frame> acquire_frame();
+    void run_writer();
+    void write_frame(const Frame& frame);
+    void write_bytes(const void* data, std::size_t size);
+
+    // Simulation thread state
+    double output_interval_ = 0.0;
+    uint64_t next_sample_index_ = 0; // Next output time is next_sample_index_ * output_interval_
+    uint64_t frames_recorded_ = 0;
+    uint64_t entity_list_revision_ = UINT64_MAX;
+    std::vector<Entity*> entities_;
+    std::vector<const PhysicsEntity*> physics_; // Same order as entities_, nullptr if not a PhysicsEntity
+    std::unique_ptr<Frame> sampling_frame_; // Frame being filled between begin_sample() and finish_sample()
+
+    // Hand-off between the simulation thread and the writer
+    std::mutex mutex_;
+    std::condition_variable frame_ready_;
+    std::condition_variable frame_free_;
+    std::deque<std::unique_ptr<Frame>> pending_;
+    std::vector<std::unique_ptr<Frame>> free_;
+    std::size_t frames_allocated_ = 0;
+    bool stopping_ = false;
+
+    // Writer thread state
+    std::FILE* file_ = nullptr;
+    std::string path_;
+    std::vector<double> columns_; // Transpose buffer for the FRAM payload
+    bool write_failed_ = false;
+    std::thread writer_;
+};
@@ -1,93 +1,126 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <map>
-#include <optional>
-#include <memory>
 
 /**
  * @brief Lightweight XML parsing utility for reading and navigating XML documents
- * 
+ *
  * Simple, self-contained XML parser with no external dependencies.
  * Provides interface for:
  * - Loading XML files
  * - Finding elements by name and attributes
  * - Extracting element values and attributes
  * - Iterating through child elements
+ *
+ * Parsing is in situ: load_file memory-maps the file (load_string keeps one copy of the text) and
+ * names, attribute values and text are string_views into that buffer, never copied while parsing.
+ * Every element is a slot in one node arena and every attribute an entry in one flat vector, so a
+ * document costs a handful of allocations however many elements it has. Strings are only built
+ * when an XMLNode getter returns one. Entity and character references are not expanded.
  */
 class XMLParser {
+private:
+    struct Document;
+
 public:
-    // Internal XML Element Node structure
-    struct XMLElement {
-        std::string name;
-        std::string text;
-        std::map<std::string, std::string> attributes;
-        std::vector<std::shared_ptr<XMLElement>> children;
-        
-        // Find first child by name
-        std::shared_ptr<XMLElement> find_child(const std::string& child_name) const;
-        
-        // Find all children by name
-        std::vector<std::shared_ptr<XMLElement>> find_children(const std::string& child_name) const;
-    };
-    
-    // Represents a node in the XML tree
+    // Represents a node in the XML tree. A node is a view into its parser's document: it stays valid
+    // while that XMLParser (or a copy of it) is alive and hasn't loaded another document.
     class XMLNode {
     public:
-        XMLNode(std::shared_ptr<XMLElement> element = nullptr) : element_(element) {}
-        
+        XMLNode() = default;
+
         // Get attribute value
         std::optional<std::string> get_attribute(const std::string& attr_name) const;
-        
+
         // Get element text content
         std::optional<std::string> get_text() const;
-        
+
         // Get child element by name
         XMLNode get_child(const std::string& child_name) const;
-        
+
         // Get all child elements with a given name
         std::vector<XMLNode> get_children(const std::string& child_name) const;
-        
+
         // Check if node is valid
-        bool is_valid() const { return element_ != nullptr; }
-        
+        bool is_valid() const { return document_ != nullptr; }
+
         // Get element name
         std::string get_name() const;
-        
+
     private:
         friend class XMLParser;
-        std::shared_ptr<XMLElement> element_;
+        XMLNode(const Document* document, uint32_t index) : document_(document), index_(index) {}
+
+        const Document* document_ = nullptr;
+        uint32_t index_ = 0; // Slot in document_->nodes
     };
-    
+
 public:
     XMLParser() = default;
     ~XMLParser() = default;
-    
+
     // Load XML from file
     bool load_file(const std::string& filepath);
-    
+
     // Load XML from string content
     bool load_string(const std::string& xml_content);
-    
+
     // Get root element
     XMLNode get_root() const;
-    
+
     // Find first element by name (from root)
     XMLNode find_element(const std::string& element_name) const;
-    
+
     // Get error message if load failed
     std::string get_error() const { return error_message_; }
-    
+
 private:
-    std::shared_ptr<XMLElement> root_;
+    static constexpr uint32_t kNoNode = UINT32_MAX;
+
+    // One element. Children form a singly linked list through the arena, in document order.
+    struct Node {
+        std::string_view name;
+        std::string_view text; // Last non-blank text run, trimmed
+        uint32_t first_attribute = 0; // Range in Document::attributes
+        uint32_t attribute_count = 0;
+        uint32_t first_child = kNoNode;
+        uint32_t next_sibling = kNoNode;
+    };
+
+    struct Attribute {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    // The parsed text and everything pointing into it. The root, if any, is nodes[0].
+    struct Document {
+        Document() = default;
+        Document(const Document&) = delete;
+        Document& operator=(const Document&) = delete;
+        ~Document();
+
+        std::string_view content;
+        std::string owned_content; // load_string's copy (or the file, when it can't be mapped)
+        void* mapping = nullptr;   // load_file's mapping of the file
+        std::size_t mapping_size = 0;
+        std::vector<Node> nodes;   // Node arena
+        std::vector<Attribute> attributes;
+    };
+
+    std::shared_ptr<const Document> document_;
     std::string error_message_;
-    
-    // Parsing helpers
-    std::shared_ptr<XMLElement> parse_element(const std::string& content, size_t& pos);
-    std::string parse_tag_name(const std::string& content, size_t& pos);
-    std::map<std::string, std::string> parse_attributes(const std::string& content, size_t& pos);
-    std::string parse_text_content(const std::string& content, size_t& pos);
-    void skip_whitespace(const std::string& content, size_t& pos);
-    void skip_comment(const std::string& content, size_t& pos);
+
+    // Parsing helpers. The parse runs over document.content; pos is an offset into it.
+    bool parse(std::shared_ptr<Document> document);
+    uint32_t parse_element(Document& document, size_t& pos);
+    std::string_view parse_tag_name(std::string_view content, size_t& pos);
+    bool parse_attributes(Document& document, uint32_t index, size_t& pos);
+    std::string_view parse_text_content(std::string_view content, size_t& pos);
+    void skip_whitespace(std::string_view content, size_t& pos);
+    void skip_comment(std::string_view content, size_t& pos);
 };
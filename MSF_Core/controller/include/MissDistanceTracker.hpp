@@ -0,0 +1,89 @@
+/*
+* @file MissDistanceTracker.hpp
+* @brief Closest approach of every missile to the scenario's waypoints over a run.
+* observe() is called after each entity update; it measures every Missile against every Waypoint and
+* keeps the smallest distance seen per missile (by name, so missiles removed mid-run keep their result).
+* Distances are only sampled on ticks, so the result is exact to within one tick of missile travel.
+* Batch runs use it as the per-replica miss distance outcome.
+* @author Brandon Coulter
+* @date 2026-03-25
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "EntityRegistry.hpp"
+#include "Missile.hpp"
+#include "Waypoint.hpp"
+
+class MissDistanceTracker {
+public:
+    void observe(const EntityRegistry& registry) {
+        if (registry.get_revision() != revision_) {
+            rebuild(registry);
+        }
+        for (const Tracked& tracked : missiles_) {
+            const Vec3 position = tracked.missile->get_position();
+            double& closest = closest_[tracked.result].second;
+            for (const Vec3& target : targets_) {
+                const double distance = (position - target).magnitude();
+                if (distance < closest) {
+                    closest = distance;
+                }
+            }
+        }
+    }
+
+    // (missile name, closest approach in m) for every missile seen, in order of first appearance.
+    // +infinity for missiles that never shared a tick with a waypoint.
+    const std::vector<std::pair<std::string, double>>& get_closest_approaches() const {
+        return closest_;
+    }
+
+    void clear() {
+        missiles_.clear();
+        targets_.clear();
+        closest_.clear();
+        revision_ = std::numeric_limits<uint64_t>::max();
+    }
+
+private:
+    struct Tracked {
+        const Missile* missile; // Valid until the registry revision changes
+        std::size_t result;     // Index into closest_
+    };
+
+    // Registrations, removals and activity changes move the revision; waypoints are re-read then too
+    void rebuild(const EntityRegistry& registry) {
+        missiles_.clear();
+        targets_.clear();
+        registry.for_each_entity([this](const Entity& entity) {
+            if (const auto* missile = dynamic_cast<const Missile*>(&entity)) {
+                missiles_.push_back(Tracked{missile, result_index(missile->get_name())});
+            } else if (dynamic_cast<const Waypoint*>(&entity) != nullptr) {
+                targets_.push_back(entity.get_position());
+            }
+        });
+        revision_ = registry.get_revision();
+    }
+
+    std::size_t result_index(const std::string& name) {
+        for (std::size_t i = 0; i < closest_.size(); ++i) {
+            if (closest_[i].first == name) {
+                return i;
+            }
+        }
+        closest_.emplace_back(name, std::numeric_limits<double>::infinity());
+        return closest_.size() - 1;
+    }
+
+    std::vector<Tracked> missiles_;
+    std::vector<Vec3> targets_;
+    std::vector<std::pair<std::string, double>> closest_;
+    uint64_t revision_ = std::numeric_limits<uint64_t>::max();
+};
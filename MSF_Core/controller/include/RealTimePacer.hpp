@@ -0,0 +1,76 @@
+/*
+* @file RealTimePacer.hpp
+* @brief Locks simulation time to wall time at a fixed scale factor.
+* After each tick the Controller calls wait(): the pacer holds the loop until the wall clock reaches
+* the wall time of the new sim time, measured from an anchor taken when pacing starts. Waits sleep
+* until shortly before the deadline and spin the rest, because a plain sleep wakes up tens to
+* hundreds of microseconds late depending on the OS timer slack.
+* A tick that finishes after its deadline is an overrun. The loop then runs unthrottled until it
+* has caught up, unless it is more than kMaxLagSeconds behind, in which case the backlog is dropped
+* and the anchor moves to the present (a resync).
+* @author Brandon Coulter
+* @date 2026-03-23
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "Clock.hpp"
+
+class RealTimePacer {
+public:
+    using WallClock = SimulationClock::WallClock;
+
+    static constexpr double kMinTimeScale = 0.1;
+    static constexpr double kMaxTimeScale = 100.0;
+    // Falling further behind than this (wall seconds) drops the backlog instead of catching up
+    static constexpr double kMaxLagSeconds = 0.25;
+    // Default length of the busy-wait that ends every wait
+    static constexpr std::chrono::microseconds kDefaultSpinThreshold{200};
+
+    struct Stats {
+        uint64_t waits = 0;    // Calls to wait()
+        uint64_t slept = 0;    // Waits that reached their deadline early and held the loop
+        uint64_t overruns = 0; // Ticks that finished after their deadline
+        uint64_t resyncs = 0;  // Overruns that dropped the backlog
+        double total_lateness_ms = 0.0; // Deadline to finish, summed over overruns
+        double max_lateness_ms = 0.0;
+        double total_wake_error_us = 0.0; // Deadline to wake-up, summed over slept waits
+        double max_wake_error_us = 0.0;
+    };
+
+    // Run sim time at time_scale times wall time; 0 turns pacing off. Returns false and leaves the
+    // pacer unchanged if time_scale is outside [kMinTimeScale, kMaxTimeScale].
+    bool configure(double time_scale, std::chrono::microseconds spin_threshold = kDefaultSpinThreshold);
+
+    bool is_enabled() const {
+        return time_scale_ > 0.0;
+    }
+    double get_time_scale() const {
+        return time_scale_;
+    }
+
+    // Anchor the clock's current sim time to the current wall time and clear the statistics
+    void start(const SimulationClock& clock);
+
+    // Block until wall time reaches the clock's sim time. No-op while pacing is off.
+    void wait(const SimulationClock& clock);
+
+    const Stats& get_stats() const {
+        return stats_;
+    }
+
+    // Log the overrun and wake-up statistics
+    void report() const;
+
+private:
+    WallClock::time_point deadline(double sim_time) const;
+
+    double time_scale_ = 0.0;
+    std::chrono::nanoseconds spin_threshold_ = kDefaultSpinThreshold;
+    WallClock::time_point anchor_wall_{};
+    double anchor_sim_ = 0.0;
+    Stats stats_;
+};
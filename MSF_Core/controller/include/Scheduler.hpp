@@ -1,37 +1,333 @@
 // Event Scheduler class definition
 
 #pragma once
-#include <queue>
-#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
 #include "Clock.hpp"
+#include "EventHandle.hpp"
+#include "EventRequest.hpp"
+#include "EventTag.hpp"
+#include "Logger.hpp"
+#include "ObjectPool.hpp"
+#include "Profiler.hpp"
+#include "TimingWheel.hpp"
 
 
+// Told about every event as it fires, just before its callback runs (e.g. to hash the event stream)
+class EventObserver {
+public:
+    virtual ~EventObserver() = default;
+    virtual void on_event_fired(SimulationClock::SimTime execution_time, EventDescriptionId description_id,
+                                const EventTag& tag) = 0;
+};
+
 class SimEventScheduler {
 public:
-    // Schedule an event to be executed after a certain delay (in seconds of sim time)
-    void schedule_event(SimulationClock& clock, std::function<void()> event, SimulationClock::SimDt delay_seconds) {
+    // Storage backing the pending event set. Both fire events in (execution time, scheduling order).
+    enum class Backend {
+        BinaryHeap,  // Binary min-heap, O(log n) push/pop
+        TimingWheel, // Hierarchical wheel keyed to the simulation tick, O(1) push/pop
+    };
+
+    // Select the backend and the tick width the timing wheel buckets by (normally the sim dt).
+    // Pending events are carried over to the new backend.
+    void configure(Backend new_backend, SimulationClock::SimDt tick_seconds) {
+        std::vector<ScheduledEvent> pending;
+        if (backend == Backend::BinaryHeap) {
+            std::swap(pending, event_heap);
+        } else {
+            pending = event_wheel.drain();
+        }
+
+        backend = new_backend;
+        event_wheel.set_tick(tick_seconds);
+        stale_entries = 0;
+        for (auto& scheduled_event : pending) {
+            if (is_live(scheduled_event)) {
+                push(std::move(scheduled_event));
+            }
+        }
+    }
+
+    Backend get_backend() const {
+        return backend;
+    }
+
+    // Observer of fired events, nullptr for none
+    void set_observer(EventObserver* event_observer) {
+        observer = event_observer;
+    }
+
+    // Pre-size the event node pool and heap so the first `count` pending events do not allocate
+    void reserve(size_t count) {
+        event_nodes.reserve(count);
+        event_heap.reserve(count);
+    }
+
+    // Schedule an event to be executed after a certain delay (in seconds of sim time).
+    // The callback is moved into a pooled node; nothing is allocated once the pool is warm.
+    // The returned handle can cancel or reschedule the event until it fires.
+    // tag describes what the callback does for checkpoints (see EventTag.hpp).
+    EventHandle schedule_event(SimulationClock& clock, EventCallback event, SimulationClock::SimDt delay_seconds,
+                               EventDescriptionId description_id = kNoEventDescription, EventTag tag = {}) {
         SimulationClock::SimTime execution_time = clock.now() + delay_seconds;
-        event_queue.push({execution_time, event});
-        std::cout << "[DEBUG] Scheduling event for sim time: " << execution_time << "s (now: " << clock.now() 
-                  << "s, delay: " << delay_seconds << "s), queue size: " << event_queue.size() << std::endl;
+        MSF_LOG_DEBUG("Scheduling event for sim time: {}s (now: {}s, delay: {}s), queue size: {}", execution_time,
+                      clock.now(), delay_seconds, size() + 1);
+        return schedule_event_at(execution_time, std::move(event), description_id, tag);
+    }
+
+    // Same, at an absolute sim time. Used to restore checkpointed events at exactly their saved time.
+    EventHandle schedule_event_at(SimulationClock::SimTime execution_time, EventCallback event,
+                                  EventDescriptionId description_id = kNoEventDescription, EventTag tag = {}) {
+        const uint64_t sequence = next_sequence++;
+        const uint32_t node = event_nodes.acquire(std::move(event), description_id, sequence, execution_time, tag);
+        push({execution_time, sequence, node});
+        return EventHandle{node, event_nodes.generation(node)};
     }
+
+    // Cancel a pending event in O(1). The callback (and anything it captured) is destroyed now;
+    // the queue entry is dropped lazily when it reaches the front or during compaction.
+    // Returns false if the event already fired, was cancelled, or the handle is empty.
+    bool cancel(EventHandle handle) {
+        if (!is_pending(handle)) {
+            return false;
+        }
+        event_nodes.release(handle.index);
+        ++stale_entries;
+        maybe_compact();
+        return true;
+    }
+
+    // Move a pending event to now + delay_seconds, keeping its handle valid. The old queue entry
+    // becomes stale, so this is O(1) on the wheel and O(log n) on the heap.
+    bool reschedule(SimulationClock& clock, EventHandle handle, SimulationClock::SimDt delay_seconds) {
+        if (!is_pending(handle)) {
+            return false;
+        }
+        EventNode& node = event_nodes[handle.index];
+        node.sequence = next_sequence++;
+        node.execution_time = clock.now() + delay_seconds;
+        push({node.execution_time, node.sequence, handle.index});
+        ++stale_entries;
+        maybe_compact();
+        return true;
+    }
+
+    // True while the event behind handle is still waiting to fire
+    bool is_pending(EventHandle handle) const {
+        return handle.is_valid() && event_nodes.is_current(handle.index, handle.generation);
+    }
+
     // Process events that are due for execution
     void process_events(SimulationClock& clock) {
         SimulationClock::SimTime current_time = clock.now();
-        while (!event_queue.empty() && event_queue.top().execution_time <= current_time) {
-            auto event = event_queue.top().event;
-            event_queue.pop();
-            event(); // Execute the event
+        processing = true;
+        if (backend == Backend::TimingWheel) {
+            event_wheel.process(current_time, [this](ScheduledEvent&& scheduled_event) {
+                if (is_live(scheduled_event)) {
+                    fire(scheduled_event.node);
+                } else {
+                    --stale_entries;
+                }
+            });
+        } else {
+            while (!event_heap.empty() && event_heap.front().execution_time <= current_time) {
+                const ScheduledEvent scheduled_event = heap_pop();
+                if (is_live(scheduled_event)) {
+                    fire(scheduled_event.node);
+                } else {
+                    --stale_entries;
+                }
+            }
+        }
+        processing = false;
+        maybe_compact();
+    }
+
+    // Drop every pending event without firing it, e.g. before restoring another state into this scheduler
+    void clear() {
+        for (uint32_t node = 0; node < event_nodes.capacity(); ++node) {
+            if (event_nodes.is_live(node)) {
+                event_nodes.release(node);
+            }
+        }
+        event_heap.clear();
+        event_wheel.drain();
+        stale_entries = 0;
+    }
+
+    // Number of pending (not cancelled) events
+    size_t size() const {
+        return event_nodes.size();
+    }
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // Absolute sim time of the earliest pending event (+infinity when nothing is pending)
+    SimulationClock::SimTime next_event_time() {
+        if (backend == Backend::TimingWheel) {
+            return event_wheel.next_execution_time([this](const ScheduledEvent& scheduled_event) {
+                return is_live(scheduled_event);
+            });
         }
+        // Drop cancelled entries sitting on top of the heap
+        while (!event_heap.empty() && !is_live(event_heap.front())) {
+            heap_pop();
+            --stale_entries;
+        }
+        return event_heap.empty() ? std::numeric_limits<double>::infinity() : event_heap.front().execution_time;
+    }
+
+    // A pending event as seen by a checkpoint
+    struct PendingEvent {
+        SimulationClock::SimTime execution_time;
+        EventDescriptionId description_id;
+        EventTag tag;
+    };
+
+    // Every pending event in firing order (execution time, then scheduling order)
+    std::vector<PendingEvent> get_pending_events() const {
+        std::vector<std::pair<uint64_t, uint32_t>> order; // (sequence, node)
+        order.reserve(event_nodes.size());
+        for (uint32_t node = 0; node < event_nodes.capacity(); ++node) {
+            if (event_nodes.is_live(node)) {
+                order.emplace_back(event_nodes[node].sequence, node);
+            }
+        }
+        std::sort(order.begin(), order.end(), [this](const auto& a, const auto& b) {
+            const SimulationClock::SimTime a_time = event_nodes[a.second].execution_time;
+            const SimulationClock::SimTime b_time = event_nodes[b.second].execution_time;
+            return a_time != b_time ? a_time < b_time : a.first < b.first;
+        });
+
+        std::vector<PendingEvent> pending;
+        pending.reserve(order.size());
+        for (const auto& entry : order) {
+            const EventNode& node = event_nodes[entry.second];
+            pending.push_back(PendingEvent{node.execution_time, node.description_id, node.tag});
+        }
+        return pending;
+    }
+
+    // Parse a backend name ("heap" or "wheel"); returns false for anything else.
+    static bool parse_backend(const std::string& name, Backend& out) {
+        if (name == "heap" || name == "binary_heap") {
+            out = Backend::BinaryHeap;
+            return true;
+        }
+        if (name == "wheel" || name == "timing_wheel") {
+            out = Backend::TimingWheel;
+            return true;
+        }
+        return false;
     }
+
 private:
+    // Pooled payload of a scheduled event. The queues only move the small ScheduledEvent key around.
+    struct EventNode {
+        EventNode(EventCallback&& callback, EventDescriptionId description, uint64_t live_sequence,
+                  SimulationClock::SimTime time, EventTag event_tag)
+            : event(std::move(callback)), description_id(description), sequence(live_sequence), execution_time(time),
+              tag(event_tag) {}
+
+        EventCallback event; // The event to execute
+        EventDescriptionId description_id; // Interned description for logging
+        uint64_t sequence; // Sequence of the queue entry currently representing this event
+        SimulationClock::SimTime execution_time; // Time of that queue entry
+        EventTag tag; // What event does, for checkpoints
+    };
+
     struct ScheduledEvent {
         SimulationClock::SimTime execution_time; // Absolute sim time (seconds) when event should execute
-        std::function<void()> event; // The event to execute
-        // Comparator for priority queue (earliest execution time has highest priority)
+        uint64_t sequence; // Scheduling order, breaks ties between events at the same time (FIFO)
+        uint32_t node; // Index of the EventNode in event_nodes
+        // Comparator for the heap (earliest execution time has highest priority)
         bool operator<(const ScheduledEvent& other) const {
-            return execution_time > other.execution_time; // Min-heap based on execution time
+            if (execution_time != other.execution_time) {
+                return execution_time > other.execution_time; // Min-heap based on execution time
+            }
+            return sequence > other.sequence;
         }
     };
-    std::priority_queue<ScheduledEvent> event_queue; // Priority queue to manage scheduled events
-};
\ No newline at end of file
+
+    // A queue entry is live if its node still exists and was not rescheduled since the entry was
+    // pushed. Sequences are never reused, so a recycled node can't revive an old entry.
+    bool is_live(const ScheduledEvent& scheduled_event) const {
+        return event_nodes.is_live(scheduled_event.node)
+            && event_nodes[scheduled_event.node].sequence == scheduled_event.sequence;
+    }
+
+    // Recycle the node before running the callback so the firing event's own handle already reads
+    // as not pending. Moving the callback out is safe: pooled nodes never move while we hold them.
+    void fire(uint32_t node) {
+        EventCallback event = std::move(event_nodes[node].event);
+        [[maybe_unused]] const EventDescriptionId description_id = event_nodes[node].description_id;
+        if (observer != nullptr) {
+            observer->on_event_fired(event_nodes[node].execution_time, description_id, event_nodes[node].tag);
+        }
+        event_nodes.release(node);
+        MSF_PROFILE_SCOPE_CATEGORY(MSF_PROFILE_ACTIVE() ? profile_event_name(description_id) : nullptr,
+                                   msf::ProfileCategory::EventType);
+        event(); // Execute the event
+    }
+
+    // Profiler timer name for an event description, interned once per id
+    const char* profile_event_name(EventDescriptionId description_id) {
+        if (description_id >= profile_event_names.size()) {
+            profile_event_names.resize(description_id + 1, nullptr);
+        }
+        const char*& name = profile_event_names[description_id];
+        if (name == nullptr) {
+            const std::string& description = event_description_name(description_id);
+            name = msf::Profiler::instance().intern(description.empty() ? "(unnamed)" : description);
+        }
+        return name;
+    }
+
+    void push(ScheduledEvent&& scheduled_event) {
+        if (backend == Backend::TimingWheel) {
+            event_wheel.push(std::move(scheduled_event));
+        } else {
+            event_heap.push_back(scheduled_event);
+            std::push_heap(event_heap.begin(), event_heap.end());
+        }
+    }
+
+    ScheduledEvent heap_pop() {
+        std::pop_heap(event_heap.begin(), event_heap.end());
+        const ScheduledEvent scheduled_event = event_heap.back();
+        event_heap.pop_back();
+        return scheduled_event;
+    }
+
+    // Purge stale entries once they outnumber the live ones, so mass cancellation (e.g. despawning
+    // thousands of entities) cannot grow the queue without bound.
+    // Skipped while callbacks are running, since the wheel may hold a batch of entries outside its slots.
+    void maybe_compact() {
+        if (processing || stale_entries < 1024 || stale_entries < event_nodes.size()) {
+            return;
+        }
+        auto is_stale = [this](const ScheduledEvent& scheduled_event) { return !is_live(scheduled_event); };
+        if (backend == Backend::TimingWheel) {
+            event_wheel.erase_if(is_stale);
+        } else {
+            event_heap.erase(std::remove_if(event_heap.begin(), event_heap.end(), is_stale), event_heap.end());
+            std::make_heap(event_heap.begin(), event_heap.end());
+        }
+        stale_entries = 0;
+    }
+
+    Backend backend = Backend::BinaryHeap;
+    uint64_t next_sequence = 0; // Monotonic counter stamped on every scheduled event
+    size_t stale_entries = 0; // Queue entries left behind by cancel/reschedule
+    bool processing = false; // True while process_events is firing callbacks
+    EventObserver* observer = nullptr; // Told about every fired event, see set_observer
+    std::vector<const char*> profile_event_names; // Indexed by EventDescriptionId, filled while profiling
+    msf::ObjectPool<EventNode> event_nodes; // Recycled storage for callbacks of pending events
+    std::vector<ScheduledEvent> event_heap; // Binary min-heap of scheduled events
+    TimingWheel<ScheduledEvent> event_wheel; // Timing wheel alternative to the heap
+};
@@ -0,0 +1,147 @@
+/*
+* @file TickEngine.hpp
+* @brief Runs the per-tick entity update step, serially or across a work-stealing thread pool.
+* Both paths walk a flat snapshot of the registry (collect_entities(), physics entities in
+* PhysicsStore slot order); the parallel path hands index ranges of it to msf::ThreadPool.
+* Entity::update(t, dt) may only mutate the entity it is called on, so both paths produce
+* bit-identical state regardless of how the list is split or which thread runs which range.
+* PhysicsEntity integration is deferred to a single pass over the PhysicsStore arrays once all
+* updates have run.
+* The snapshot is grouped by concrete class; runs of classes registered with the registry are
+* updated through their statically-typed loop (EntityRegistry::UpdateBatchFn) unless an observer
+* or the profiler needs per-entity hooks, in which case every entity goes through the virtual call.
+* Sleeping and static entities sit at the end of the snapshot and are skipped entirely: they are
+* not updated and their PhysicsStore slots are not visited by the integration pass. An observer
+* still sees them, so trajectory samples cover every entity.
+* Entities with an update rate (Entity::set_update_rate) run in harmonic rate groups: the rate is
+* rounded up to dt * 2^k, and a group-k entity is updated (and integrated) with dt * 2^k on every
+* 2^k-th tick only. Each group is split into 2^k phases by registry slot, so a slow group's load is
+* spread evenly over its frames instead of landing on one tick. Between its frames such an entity's
+* state is up to (2^k - 1) ticks ahead of the clock.
+* @author Brandon Coulter
+* @date 2026-03-08
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "EntityRegistry.hpp"
+#include "ThreadPool.hpp"
+
+// Optional hook run on each entity right after its update, while its state is still in cache
+// (and on each inactive entity, which is not updated).
+// slot is the entity's index in registry iteration order (the collect_entities() order). On the
+// parallel path calls for different slots run concurrently, so implementations may only touch
+// per-slot storage.
+class TickObserver {
+public:
+    virtual ~TickObserver() = default;
+    virtual void on_entity_updated(std::size_t slot, const Entity& entity) = 0;
+};
+
+class TickEngine {
+public:
+    // thread_count <= 1 selects the serial path. grain == 0 lets the pool pick a chunk size.
+    void configure(std::size_t thread_count, std::size_t grain);
+
+    // Call update(t, dt) on every active entity due this tick (with its rate group's dt), then
+    // observer->on_entity_updated() on every entity if given.
+    void tick(EntityRegistry& registry, double t, double dt, TickObserver* observer = nullptr);
+
+    // Account for ticks the controller skipped while no entity was active, so rate groups stay on
+    // the frames they would have had if those ticks had run
+    void skip_ticks(uint64_t ticks) {
+        frame_ += ticks;
+    }
+
+    // Ticks run or skipped so far. Checkpoints save it so rate groups resume on the same frames.
+    uint64_t get_frame() const {
+        return frame_;
+    }
+    void set_frame(uint64_t frame) {
+        frame_ = frame;
+    }
+
+    // Use the registry's per-class update loops (default) or virtual-dispatch every entity
+    void set_bucketed_dispatch(bool enabled) {
+        bucketed_dispatch_ = enabled;
+    }
+    bool is_bucketed_dispatch() const {
+        return bucketed_dispatch_;
+    }
+
+    // Slowest single Entity::update of the last tick, for attributing deadline overruns. Tracking
+    // times every update individually (and so bypasses the per-class loops); it is off by default.
+    struct SlowestUpdate {
+        const Entity* entity = nullptr; // Valid until the registry's next safe point
+        uint64_t ns = 0;
+    };
+    void set_track_slowest(bool enabled) {
+        track_slowest_ = enabled;
+    }
+    bool is_tracking_slowest() const {
+        return track_slowest_;
+    }
+    SlowestUpdate get_slowest_update() const {
+        return slowest_;
+    }
+
+    // Print tick count, average tick time and per-thread scaling numbers.
+    void report() const;
+
+    // Coarsest rate group: entities are updated at least every kMaxRateDivisor ticks
+    static constexpr uint32_t kMaxRateDivisor = 1024;
+    // Tick divisor of the rate group for rate_hz at base timestep dt (1 = every tick)
+    static uint32_t rate_divisor(double rate_hz, double dt);
+
+    bool is_parallel() const {
+        return pool_ != nullptr;
+    }
+    std::size_t get_thread_count() const {
+        return pool_ ? pool_->size() : 1;
+    }
+
+private:
+    // Contiguous range of the snapshot updated on the same frames with the same dt. divisor == 0
+    // marks the trailing block of inactive entities, which is never due.
+    struct RateBlock {
+        uint32_t divisor; // Ticks between updates (a power of two)
+        uint32_t phase;   // Due when frame % divisor == phase
+        std::size_t begin;
+        std::size_t end;
+        std::vector<EntityRegistry::UpdateRun> runs; // Class runs within [begin, end)
+        std::vector<uint32_t> slots; // Sorted PhysicsStore slots of the block's entities
+    };
+
+    // Snapshot the registry and split its active entities into rate blocks
+    void build_rate_blocks(EntityRegistry& registry, double dt);
+    // Update (if due) and/or observe one block, serially or on the pool
+    void run_block(const RateBlock& block, bool due, double t, double block_dt, TickObserver* observer,
+                   bool profiled, bool bucketed, bool timed);
+    // Merge a chunk's slowest update into slowest_
+    void note_slowest(const SlowestUpdate& candidate);
+
+    std::unique_ptr<msf::ThreadPool> pool_;
+    std::size_t grain_ = 0;
+    bool bucketed_dispatch_ = true;
+
+    // Flat snapshot of the registry, rebuilt only when the registry, its revision or dt changes
+    std::vector<Entity*> tick_list_;
+    std::vector<RateBlock> blocks_; // Cover tick_list_ in order
+    const EntityRegistry* tick_list_registry_ = nullptr;
+    uint64_t tick_list_revision_ = UINT64_MAX;
+    double tick_list_dt_ = 0.0;
+    uint64_t frame_ = 0; // Ticks run so far; selects the due phase of each rate group
+
+    // Update-phase timing
+    uint64_t ticks_ = 0;
+    uint64_t update_wall_ns_ = 0;
+    bool track_slowest_ = false;
+    SlowestUpdate slowest_; // Of the current tick, merged from every chunk under slowest_mutex_
+    std::mutex slowest_mutex_;
+};
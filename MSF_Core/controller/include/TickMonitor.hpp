@@ -0,0 +1,121 @@
+/*
+* @file TickMonitor.hpp
+* @brief Per-tick wall-time histogram and deadline watchdog for the Controller loop.
+* Every loop iteration is timed from begin_tick() to end_tick(), excluding the real-time pacing
+* wait, into a msf::LatencyHistogram, so tail latencies (p99, p99.9, max) are available while the
+* simulation runs and in the shutdown summary.
+* With a deadline set, the loop also marks the end of each phase and the TickEngine times every
+* entity update. A tick that runs past the deadline is an overrun: it is logged with the phase that
+* took longest and the slowest entity update of that tick, and the slowest overruns are kept for
+* the shutdown report.
+* @author Brandon Coulter
+* @date 2026-03-23
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "LatencyHistogram.hpp"
+#include "TickEngine.hpp"
+
+class TickMonitor {
+public:
+    using WallClock = std::chrono::steady_clock;
+
+    static constexpr std::size_t kMaxPhases = 8;
+    static constexpr std::size_t kKeptOverruns = 16;  // Slowest overruns kept for the report
+    static constexpr uint64_t kLoggedOverruns = 20;   // Overruns logged as they happen; later ones are only counted
+
+    struct Overrun {
+        uint64_t tick = 0;
+        double sim_time = 0.0;
+        uint64_t duration_ns = 0;
+        const char* phase = "";  // Phase that took longest
+        uint64_t phase_ns = 0;
+        int entity_id = -1;      // Slowest entity update of the tick, -1 if none was timed
+        std::string entity_name;
+        uint64_t entity_ns = 0;
+    };
+
+    // Overrun threshold in wall nanoseconds per tick; 0 turns the watchdog off (the histogram stays on)
+    void set_deadline(uint64_t deadline_ns) {
+        deadline_ns_ = deadline_ns;
+    }
+    uint64_t get_deadline_ns() const {
+        return deadline_ns_;
+    }
+    bool is_watching() const {
+        return deadline_ns_ > 0;
+    }
+
+    void begin_tick(double sim_time) {
+        sim_time_ = sim_time;
+        phase_count_ = 0;
+        tick_start_ = WallClock::now();
+        phase_start_ = tick_start_;
+    }
+
+    // Close the phase that began at the previous mark. Only timed while watching; name must be a literal.
+    void end_phase(const char* name) {
+        if (!is_watching() || phase_count_ == kMaxPhases) {
+            return;
+        }
+        const WallClock::time_point now = WallClock::now();
+        phases_[phase_count_++] = Phase{name, elapsed_ns(phase_start_, now)};
+        phase_start_ = now;
+    }
+
+    // Record the tick. slowest is the TickEngine's slowest update of the tick (if it tracked one).
+    void end_tick(const TickEngine::SlowestUpdate& slowest = {}) {
+        const uint64_t duration_ns = elapsed_ns(tick_start_, WallClock::now());
+        histogram_.record(duration_ns);
+        if (is_watching() && duration_ns > deadline_ns_) {
+            record_overrun(duration_ns, slowest);
+        }
+        ++tick_;
+    }
+
+    // Safe to read from another thread while the loop runs
+    const msf::LatencyHistogram& get_histogram() const {
+        return histogram_;
+    }
+    uint64_t get_overrun_count() const {
+        return overrun_count_.load(std::memory_order_relaxed);
+    }
+    // Slowest overruns so far, slowest first. Loop thread only.
+    std::vector<Overrun> get_worst_overruns() const;
+
+    // Log the latency percentiles and, while watching, the overrun summary
+    void report() const;
+
+private:
+    struct Phase {
+        const char* name;
+        uint64_t ns;
+    };
+
+    static uint64_t elapsed_ns(WallClock::time_point from, WallClock::time_point to) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+    }
+
+    void record_overrun(uint64_t duration_ns, const TickEngine::SlowestUpdate& slowest);
+
+    uint64_t deadline_ns_ = 0;
+    msf::LatencyHistogram histogram_;
+    std::atomic<uint64_t> overrun_count_{0};
+    std::vector<Overrun> worst_; // At most kKeptOverruns, unordered
+
+    // Current tick
+    uint64_t tick_ = 0;
+    double sim_time_ = 0.0;
+    WallClock::time_point tick_start_{};
+    WallClock::time_point phase_start_{};
+    std::array<Phase, kMaxPhases> phases_{};
+    std::size_t phase_count_ = 0;
+};
@@ -0,0 +1,270 @@
+// Hierarchical timing wheel used by SimEventScheduler
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// TimingWheel
+//  - Buckets entries by simulation tick (floor(execution_time / tick)).
+//  - kLevels wheels of kSlots slots each; level L slot s holds entries whose tick shares every digit
+//    above L with the cursor and has digit s at level L. Entries cascade one level down each time the
+//    cursor crosses a slot boundary, so push and per-tick advance are O(1) amortized.
+//  - Entries further out than kSlots^kLevels ticks park in an overflow list until the cursor gets close.
+//  - Entry must expose `execution_time` (seconds) and `sequence` (FIFO tie-break for equal times).
+template <typename Entry>
+class TimingWheel {
+public:
+    static constexpr unsigned kSlotBits = 8;
+    static constexpr std::size_t kSlots = std::size_t{1} << kSlotBits;
+    static constexpr unsigned kLevels = 4;
+
+    explicit TimingWheel(double tick_seconds = 0.001) {
+        set_tick(tick_seconds);
+    }
+
+    // Change the bucket width. Only valid while the wheel is empty.
+    void set_tick(double tick_seconds) {
+        tick_seconds_ = tick_seconds > 0.0 ? tick_seconds : 0.001;
+    }
+
+    double get_tick() const {
+        return tick_seconds_;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    void push(Entry entry) {
+        insert(std::move(entry), tick_index(entry.execution_time));
+        ++size_;
+    }
+
+    // Fire every entry with execution_time <= now in (execution_time, sequence) order.
+    // fire(Entry&&) may push new entries; ones that are already due are fired in the same call.
+    // Entries are handed to fire() even if the owner has since cancelled them; fire() decides.
+    template <typename Fire>
+    void process(double now, Fire&& fire) {
+        const uint64_t target = tick_index(now);
+        while (true) {
+            fire_due_slot(now, fire);
+
+            if (cursor_ >= target) {
+                break;
+            }
+            if (size_ == 0) {
+                // Nothing left to cascade; jump straight to the target tick.
+                cursor_ = target;
+                break;
+            }
+
+            // Entries left in the slot are only possible through rounding at the bucket edge;
+            // carry them into the next tick instead of dropping them.
+            take_all(wheels_[0][cursor_ & kSlotMask], carry_);
+            advance_cursor();
+            for (auto& entry : carry_) {
+                insert(std::move(entry), cursor_);
+            }
+            carry_.clear();
+        }
+    }
+
+    // Earliest pending execution time, or +infinity when empty.
+    double next_execution_time() const {
+        return next_execution_time([](const Entry&) { return true; });
+    }
+
+    // Earliest execution time among entries for which is_live(entry) holds (skips cancelled ones).
+    template <typename IsLive>
+    double next_execution_time(IsLive&& is_live) const {
+        if (size_ == 0) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        for (unsigned level = 0; level < kLevels; ++level) {
+            const std::size_t digit = static_cast<std::size_t>((cursor_ >> (kSlotBits * level)) & kSlotMask);
+            // Level 0 still holds the cursor's own slot; higher levels already cascaded theirs.
+            for (std::size_t slot = (level == 0 ? digit : digit + 1); slot < kSlots; ++slot) {
+                const double earliest = min_time(wheels_[level][slot], is_live);
+                if (earliest != std::numeric_limits<double>::infinity()) {
+                    return earliest;
+                }
+            }
+        }
+        return min_time(overflow_, is_live);
+    }
+
+    // Remove every entry for which pred(entry) holds. O(slots + entries); used to purge cancelled
+    // entries in bulk instead of waiting for their tick.
+    template <typename Pred>
+    std::size_t erase_if(Pred&& pred) {
+        std::size_t erased = 0;
+        auto erase_from = [&](std::vector<Entry>& entries) {
+            const auto end = std::remove_if(entries.begin(), entries.end(), pred);
+            erased += static_cast<std::size_t>(entries.end() - end);
+            entries.erase(end, entries.end());
+        };
+        for (auto& level : wheels_) {
+            for (auto& slot : level) {
+                erase_from(slot);
+            }
+        }
+        erase_from(overflow_);
+        size_ -= erased;
+        return erased;
+    }
+
+    // Remove and return every pending entry (unordered). Used to migrate between backends.
+    std::vector<Entry> drain() {
+        std::vector<Entry> out;
+        out.reserve(size_);
+        for (auto& level : wheels_) {
+            for (auto& slot : level) {
+                for (auto& entry : slot) {
+                    out.push_back(std::move(entry));
+                }
+                slot.clear();
+            }
+        }
+        for (auto& entry : overflow_) {
+            out.push_back(std::move(entry));
+        }
+        overflow_.clear();
+        size_ = 0;
+        return out;
+    }
+
+private:
+    static constexpr uint64_t kSlotMask = kSlots - 1;
+
+    uint64_t tick_index(double time) const {
+        const double ticks = std::floor(time / tick_seconds_);
+        if (!(ticks > 0.0)) {
+            return 0;
+        }
+        if (ticks >= 1.8e19) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        return static_cast<uint64_t>(ticks);
+    }
+
+    template <typename IsLive>
+    static double min_time(const std::vector<Entry>& entries, IsLive& is_live) {
+        double earliest = std::numeric_limits<double>::infinity();
+        for (const auto& entry : entries) {
+            if (is_live(entry)) {
+                earliest = std::min(earliest, entry.execution_time);
+            }
+        }
+        return earliest;
+    }
+
+    static bool fires_before(const Entry& a, const Entry& b) {
+        if (a.execution_time != b.execution_time) {
+            return a.execution_time < b.execution_time;
+        }
+        return a.sequence < b.sequence;
+    }
+
+    // Move every entry of from into to (cleared first). Both vectors keep their capacity, so once
+    // the wheel has seen its peak load no slot or scratch buffer reallocates again.
+    static void take_all(std::vector<Entry>& from, std::vector<Entry>& to) {
+        to.clear();
+        for (auto& entry : from) {
+            to.push_back(std::move(entry));
+        }
+        from.clear();
+    }
+
+    // Place an entry in the lowest level whose higher digits match the cursor.
+    void insert(Entry&& entry, uint64_t tick) {
+        tick = std::max(tick, cursor_);
+        for (unsigned level = 0; level < kLevels; ++level) {
+            const unsigned shift = kSlotBits * (level + 1);
+            if ((tick >> shift) == (cursor_ >> shift)) {
+                wheels_[level][(tick >> (kSlotBits * level)) & kSlotMask].push_back(std::move(entry));
+                return;
+            }
+        }
+        overflow_.push_back(std::move(entry));
+    }
+
+    void advance_cursor() {
+        ++cursor_;
+
+        // Crossing the top of the wheel: pull overflow entries that are now in range.
+        if ((cursor_ & ((uint64_t{1} << (kSlotBits * kLevels)) - 1)) == 0 && !overflow_.empty()) {
+            std::vector<Entry> pending;
+            std::swap(pending, overflow_);
+            for (auto& entry : pending) {
+                insert(std::move(entry), tick_index(entry.execution_time));
+            }
+        }
+
+        // Cascade from the highest boundary crossed down to level 1.
+        for (unsigned level = kLevels - 1; level >= 1; --level) {
+            const uint64_t low_mask = (uint64_t{1} << (kSlotBits * level)) - 1;
+            if ((cursor_ & low_mask) != 0) {
+                continue;
+            }
+            std::vector<Entry>& slot = wheels_[level][(cursor_ >> (kSlotBits * level)) & kSlotMask];
+            if (slot.empty()) {
+                continue;
+            }
+            take_all(slot, cascade_);
+            for (auto& entry : cascade_) {
+                insert(std::move(entry), tick_index(entry.execution_time));
+            }
+            cascade_.clear();
+        }
+    }
+
+    template <typename Fire>
+    void fire_due_slot(double now, Fire& fire) {
+        std::vector<Entry>& slot = wheels_[0][cursor_ & kSlotMask];
+        while (!slot.empty()) {
+            // Take the slot so callbacks can push into it while we fire.
+            take_all(slot, batch_);
+            std::sort(batch_.begin(), batch_.end(), fires_before);
+
+            std::size_t fired = 0;
+            for (auto& entry : batch_) {
+                if (entry.execution_time > now) {
+                    slot.push_back(std::move(entry));
+                    continue;
+                }
+                --size_;
+                ++fired;
+                fire(std::move(entry));
+            }
+            batch_.clear();
+
+            if (fired == 0) {
+                break;
+            }
+        }
+    }
+
+    double tick_seconds_ = 0.001;
+    uint64_t cursor_ = 0; // Tick index of level-0 slot currently being processed
+    std::size_t size_ = 0;
+
+    std::array<std::array<std::vector<Entry>, kSlots>, kLevels> wheels_{};
+    std::vector<Entry> overflow_;
+
+    // Scratch buffers kept around so steady-state processing does not reallocate
+    std::vector<Entry> batch_;
+    std::vector<Entry> carry_;
+    std::vector<Entry> cascade_;
+};
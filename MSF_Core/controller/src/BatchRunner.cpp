@@ -0,0 +1,222 @@
+#include "BatchRunner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+
+#include "Logger.hpp"
+#include "ThreadPool.hpp"
+
+namespace {
+
+// Linear interpolation between the closest ranks of sorted samples
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.size() == 1) {
+        return sorted.front();
+    }
+    const double rank = p / 100.0 * static_cast<double>(sorted.size() - 1);
+    const std::size_t below = static_cast<std::size_t>(rank);
+    const std::size_t above = std::min(below + 1, sorted.size() - 1);
+    return sorted[below] + (rank - static_cast<double>(below)) * (sorted[above] - sorted[below]);
+}
+
+std::string miss_metric(const std::string& missile_name) {
+    return "miss_distance[" + missile_name + "]";
+}
+
+} // namespace
+
+void BatchStatistics::add(const std::string& metric, double value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(samples_.begin(), samples_.end(), [&metric](const auto& entry) {
+        return entry.first == metric;
+    });
+    if (it == samples_.end()) {
+        samples_.emplace_back(metric, std::vector<double>());
+        it = samples_.end() - 1;
+    }
+    it->second.push_back(value);
+}
+
+std::vector<std::string> BatchStatistics::get_metrics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> metrics;
+    metrics.reserve(samples_.size());
+    for (const auto& entry : samples_) {
+        metrics.push_back(entry.first);
+    }
+    return metrics;
+}
+
+BatchStatistics::Summary BatchStatistics::summarize(const std::string& metric) const {
+    std::vector<double> sorted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& entry : samples_) {
+            if (entry.first == metric) {
+                std::copy_if(entry.second.begin(), entry.second.end(), std::back_inserter(sorted),
+                             [](double value) { return std::isfinite(value); });
+                break;
+            }
+        }
+    }
+    Summary summary;
+    if (sorted.empty()) {
+        return summary;
+    }
+
+    // Sorting first makes the sums independent of the order replicas finished in
+    std::sort(sorted.begin(), sorted.end());
+    double sum = 0.0;
+    for (const double value : sorted) {
+        sum += value;
+    }
+    summary.count = sorted.size();
+    summary.mean = sum / static_cast<double>(sorted.size());
+    double squares = 0.0;
+    for (const double value : sorted) {
+        squares += (value - summary.mean) * (value - summary.mean);
+    }
+    summary.stddev = sorted.size() > 1 ? std::sqrt(squares / static_cast<double>(sorted.size() - 1)) : 0.0;
+    summary.min = sorted.front();
+    summary.p5 = percentile(sorted, 5.0);
+    summary.p50 = percentile(sorted, 50.0);
+    summary.p95 = percentile(sorted, 95.0);
+    summary.max = sorted.back();
+    return summary;
+}
+
+void BatchStatistics::report() const {
+    for (const std::string& metric : get_metrics()) {
+        const Summary summary = summarize(metric);
+        if (summary.count == 0) {
+            MSF_LOG_INFO("  {}: no finite samples", metric);
+            continue;
+        }
+        MSF_LOG_INFO("  {}: n={} mean {:.6g} sd {:.6g} | min {:.6g} p5 {:.6g} p50 {:.6g} p95 {:.6g} max {:.6g}", metric,
+                     summary.count, summary.mean, summary.stddev, summary.min, summary.p5, summary.p50, summary.p95,
+                     summary.max);
+    }
+}
+
+bool BatchRunner::run() {
+    auto scenario = std::make_shared<SCF>(options_.scenario_path);
+    msf::SimDt timestep = 0.001;
+    if (!scenario->parse_settings(timestep)) {
+        MSF_LOG_ERROR("Failed to parse SCF file: {}", scenario->get_scf_filepath());
+        return false;
+    }
+    scenario_ = std::move(scenario);
+    if (scenario_->get_branch_plan().is_enabled()) {
+        MSF_LOG_WARNING("Batch replicas ignore the scenario's <Branches>");
+    }
+
+    outcomes_.assign(options_.replicas, ReplicaOutcome{});
+    msf::ThreadPool pool(options_.batch_threads);
+    thread_count_ = pool.size();
+    MSF_LOG_INFO("Running {} replicas of {} on {} threads (seeds {}..{})", options_.replicas,
+                 scenario_->get_scf_filepath(), thread_count_, replica_seed(options_.seed, 0),
+                 replica_seed(options_.seed, options_.replicas - 1));
+
+    const auto start = std::chrono::steady_clock::now();
+    pool.parallel_for(options_.replicas, 1, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t index = begin; index < end; ++index) {
+            run_replica(index);
+        }
+    });
+    wall_ms_ = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    report();
+    bool ok = std::all_of(outcomes_.begin(), outcomes_.end(), [](const ReplicaOutcome& outcome) {
+        return outcome.ok;
+    });
+    if (!options_.batch_results_path.empty()) {
+        ok = write_results(options_.batch_results_path) && ok;
+    }
+    return ok;
+}
+
+void BatchRunner::run_replica(std::size_t index) {
+    const auto start = std::chrono::steady_clock::now();
+    ReplicaOutcome& outcome = outcomes_[index];
+    outcome.index = index;
+    outcome.seed = replica_seed(options_.seed, index);
+
+    // Same entity IDs as a standalone run. The calling thread also runs replicas, so its counter is put back.
+    const int caller_next_id = Entity::get_next_id();
+    Entity::set_next_id(0);
+    {
+        Controller controller;
+        controller.configure_replica(outcome.seed);
+        if (controller.initialize(options_, scenario_)) {
+            controller.run();
+            outcome.ok = true;
+            outcome.run = controller.get_outcome();
+        }
+    }
+    Entity::set_next_id(caller_next_id);
+    if (!outcome.ok) {
+        MSF_LOG_ERROR("Replica {} failed to initialize", index);
+        return;
+    }
+
+    outcome.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    statistics_.add("end_time", outcome.run.end_time);
+    statistics_.add("wall_ms", outcome.wall_ms);
+    for (const auto& approach : outcome.run.closest_approaches) {
+        statistics_.add(miss_metric(approach.first), approach.second);
+    }
+}
+
+bool BatchRunner::write_results(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        MSF_LOG_ERROR("Failed to open batch results file {}", path);
+        return false;
+    }
+
+    // One column per missile seen in any replica, in order of first appearance
+    std::vector<std::string> missiles;
+    for (const ReplicaOutcome& outcome : outcomes_) {
+        for (const auto& approach : outcome.run.closest_approaches) {
+            if (std::find(missiles.begin(), missiles.end(), approach.first) == missiles.end()) {
+                missiles.push_back(approach.first);
+            }
+        }
+    }
+
+    out << "replica,seed,ok,end_time,ticks,entities,wall_ms";
+    for (const std::string& missile : missiles) {
+        out << "," << miss_metric(missile);
+    }
+    out << "\n" << std::setprecision(17);
+    for (const ReplicaOutcome& outcome : outcomes_) {
+        out << outcome.index << "," << outcome.seed << "," << (outcome.ok ? 1 : 0) << "," << outcome.run.end_time
+            << "," << outcome.run.ticks << "," << outcome.run.entity_count << "," << outcome.wall_ms;
+        for (const std::string& missile : missiles) {
+            out << ",";
+            const auto it = std::find_if(outcome.run.closest_approaches.begin(), outcome.run.closest_approaches.end(),
+                                         [&missile](const auto& approach) { return approach.first == missile; });
+            if (it != outcome.run.closest_approaches.end() && std::isfinite(it->second)) {
+                out << it->second;
+            }
+        }
+        out << "\n";
+    }
+    MSF_LOG_INFO("Wrote {} replica outcomes to {}", outcomes_.size(), path);
+    return static_cast<bool>(out);
+}
+
+void BatchRunner::report() const {
+    const std::size_t failed = static_cast<std::size_t>(std::count_if(
+        outcomes_.begin(), outcomes_.end(), [](const ReplicaOutcome& outcome) { return !outcome.ok; }));
+    const double per_hour = wall_ms_ > 0.0 ? static_cast<double>(outcomes_.size()) / wall_ms_ * 3.6e6 : 0.0;
+    MSF_LOG_INFO("Batch: {} replicas ({} failed) in {:.1f} ms on {} threads, {:.0f} replicas/hour", outcomes_.size(),
+                 failed, wall_ms_, thread_count_, per_hour);
+    statistics_.report();
+}
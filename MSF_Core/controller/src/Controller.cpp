@@ -1,78 +1,481 @@
 #include "Controller.hpp"
 
-void Controller::initialize(const std::string& scenario_path) {
-    std::cout << "[INFO] Initializing Simulation Controller" << std::endl;
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Output file of one branch: "run.msft" becomes "run.<branch>.msft"
+std::string branch_output_path(const std::string& path, const std::string& branch_name) {
+    const std::size_t slash = path.find_last_of('/');
+    const std::size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return path + "." + branch_name;
+    }
+    return path.substr(0, dot) + "." + branch_name + path.substr(dot);
+}
+
+} // namespace
+
+bool Controller::initialize(const ArgParse::Options& options) {
+    auto scenario = std::make_shared<SCF>(options.scenario_path);
+    msf::SimDt timestep = dt;
+    if (!scenario->parse_settings(timestep)) {
+        MSF_LOG_ERROR("Failed to parse SCF file: {}", scenario->get_scf_filepath());
+        msf::Logger::instance().flush();
+        return false;
+    }
+    return initialize(options, std::move(scenario));
+}
+
+bool Controller::initialize(const ArgParse::Options& options, std::shared_ptr<const SCF> scenario) {
+    MSF_LOG_INFO("Initializing Simulation Controller");
+    scf = std::move(scenario);
+    dt = scf->get_simulation_setup().timestep;
+    if (!is_replica) {
+        seed = options.seed;
+    }
+
+    if (options.profile && !is_replica) {
+#if MSF_PROFILING
+        msf::Profiler& profiler = msf::Profiler::instance();
+        profiler.set_enabled(true);
+        if (!options.trace_path.empty()) {
+            profiler.enable_trace(options.trace_path, options.trace_ticks);
+        }
+#else
+        MSF_LOG_WARNING("Profiling was compiled out (meson -Dprofiling=false); ignoring --profile/--trace.");
+#endif
+    }
 
     // Register All Entity Classes
     registry.register_classes();
+    registry.attach_scheduler(scheduler); // Entity events are cancelled when their entity is removed
+    registry.set_run_seed(seed); // Keys every entity's random streams
 
-    scf.set_scf_filepath(scenario_path);
-    if (!scf.parse_scf(registry, dt)) {
-        std::cerr << "[ERROR] Failed to parse SCF file: " << scf.get_scf_filepath() << std::endl;
-        exit(EXIT_FAILURE);
+    // When restoring, the scenario file only provides settings; entities and events come from the checkpoint
+    const bool restoring = !options.restore_path.empty();
+    if (!restoring && !scf->create_entities(registry)) {
+        MSF_LOG_ERROR("Failed to parse SCF file: {}", scf->get_scf_filepath());
+        msf::Logger::instance().flush();
+        return false;
+    }
+    if (restoring && !restore_checkpoint(options.restore_path)) {
+        return false;
+    }
+
+    if (is_replica) {
+        // Replicas run side by side: one thread each, no pacing and no output files of their own
+        tick_engine.configure(1, 0);
+        fast_forward_enabled = options.fast_forward;
+        configure_scheduler(options);
+        if (!restoring) {
+            schedule_shutdown();
+        }
+        return true;
     }
 
     registry.print_all_entities();
 
-    scheduler.schedule_event(clock, [this]() {
-        std::cout << "[EVENT] Scheduled Shutdown Event Triggered at t=" << clock.now() << "s" << std::endl;
-        is_running = false; // Stop the main loop after this event
-        shutdown();
-    }, 120.0);
+    // Command line thread count wins over the SCF <ParallelTick> element
+    const SCF::SimulationSetup& setup = scf->get_simulation_setup();
+    const std::size_t tick_threads = options.tick_threads > 0 ? options.tick_threads : setup.tick_threads;
+    tick_engine.configure(tick_threads, setup.tick_grain);
+    fast_forward_enabled = options.fast_forward;
+
+    // Real-time pacing: command line wins over <RealTime scale="x"/>, 0 runs as fast as possible
+    const double time_scale = options.time_scale >= 0.0 ? options.time_scale : setup.time_scale;
+    pacer.configure(time_scale);
+    if (pacer.is_enabled()) {
+        MSF_LOG_INFO("Real-time pacing at {}x wall time", time_scale);
+    }
+
+    // Overrun watchdog: command line, then <TickDeadline ms="x"/>, then the paced tick period
+    double deadline_ms = options.tick_deadline_ms >= 0.0 ? options.tick_deadline_ms : setup.tick_deadline_ms;
+    if (deadline_ms < 0.0) {
+        deadline_ms = pacer.is_enabled() ? dt / pacer.get_time_scale() * 1e3 : 0.0;
+    }
+    tick_monitor.set_deadline(static_cast<uint64_t>(deadline_ms * 1e6));
+    tick_engine.set_track_slowest(tick_monitor.is_watching()); // Attributes overruns to an entity
+    if (tick_monitor.is_watching()) {
+        MSF_LOG_INFO("Tick deadline watchdog: {} ms", deadline_ms);
+    }
+
+    configure_scheduler(options);
+
+    // A restored run already has its shutdown event and clock
+    if (!restoring) {
+        schedule_shutdown();
+    }
+
+    const SCF::OutputOptions& output = scf->get_output_options();
+    if (output.trajectory_enabled && trajectory_recorder.open(output.trajectory_file, output.trajectory_rate_hz)) {
+        trajectory_recorder.record(registry, clock.now()); // Initial state (at the checkpoint time when restored)
+    }
+
+    // Checkpoints: command line, then <Output><Checkpoint/>
+    const std::string& checkpoint_path = options.checkpoint_path.empty() ? output.checkpoint_file
+                                                                         : options.checkpoint_path;
+    if (!checkpoint_path.empty()) {
+        const double interval = options.checkpoint_interval > 0.0 ? options.checkpoint_interval
+                                                                  : output.checkpoint_interval;
+        checkpoint_writer.open(checkpoint_path, interval, clock.now());
+    }
+
+    if (!options.state_hash_path.empty() &&
+        state_hasher.open(options.state_hash_path, static_cast<uint32_t>(options.state_hash_interval), dt)) {
+        scheduler.set_observer(&state_hasher);
+        state_hasher.record(registry, clock.now());
+    }
+
+    // Branches fork at the first safe point at or after their branch time
+    const SCF::BranchPlan& branch_plan = scf->get_branch_plan();
+    if (options.branches && branch_plan.is_enabled()) {
+        branch_time = branch_plan.time;
+        MSF_LOG_INFO("{} branches fork at t={}s", branch_plan.branches.size(), branch_time);
+    }
+    return true;
+}
+
+void Controller::configure_scheduler(const ArgParse::Options& options) {
+    // Same precedence as the tick threads; the wheel buckets events by the sim timestep
+    const std::string& backend_name = options.scheduler_backend.empty() ? scf->get_simulation_setup().scheduler_backend
+                                                                       : options.scheduler_backend;
+    SimEventScheduler::Backend backend = SimEventScheduler::Backend::BinaryHeap;
+    SimEventScheduler::parse_backend(backend_name, backend);
+    scheduler.configure(backend, dt);
+    MSF_LOG_INFO("Event scheduler backend: {}", backend_name);
+}
+
+void Controller::schedule_shutdown() {
+    EventTag shutdown_tag;
+    shutdown_tag.kind = EventKind::Shutdown;
+    scheduler.schedule_event(clock, make_shutdown_event(), 120.0, intern_event_description("SHUTDOWN"), shutdown_tag);
 
     // Reset simulation time to 0 seconds
     clock.reset(0.0);
 }
 
+void Controller::configure_replica(uint64_t replica_seed) {
+    is_replica = true;
+    seed = replica_seed;
+}
+
+bool Controller::restore_checkpoint(const std::string& path) {
+    const auto start = SimulationClock::WallClock::now();
+    Checkpoint::RunState run;
+    std::string error;
+    const auto bind = [this](const EventTag& tag, EventDescriptionId description_id) {
+        return bind_event(tag, description_id);
+    };
+    if (!Checkpoint::restore_file(path, run, registry, scheduler, bind, error)) {
+        MSF_LOG_ERROR("Failed to restore checkpoint {}: {}", path, error);
+        msf::Logger::instance().flush();
+        return false;
+    }
+    if (run.dt != dt) {
+        MSF_LOG_WARNING("Checkpoint timestep {} s overrides the scenario's {} s", run.dt, dt);
+    }
+    dt = run.dt;
+    if (run.seed != seed) {
+        MSF_LOG_WARNING("Checkpoint seed {} overrides --seed {}", run.seed, seed);
+    }
+    seed = run.seed; // Random draws carry on exactly as in the checkpointed run
+    registry.set_run_seed(seed);
+    clock.reset(run.sim_time);
+    tick_engine.set_frame(run.tick_frame);
+    MSF_LOG_INFO("Restored checkpoint {} at t={}s: {} entities, {} events in {:.3f} ms", path, run.sim_time,
+                 registry.get_entity_count(), scheduler.size(),
+                 std::chrono::duration<double, std::milli>(SimulationClock::WallClock::now() - start).count());
+    return true;
+}
+
+void Controller::save_checkpoint() {
+    Checkpoint::RunState run;
+    run.sim_time = clock.now();
+    run.dt = dt;
+    run.tick_frame = tick_engine.get_frame();
+    run.seed = seed;
+    checkpoint_writer.save(run, registry, scheduler);
+}
+
+EventCallback Controller::make_shutdown_event() {
+    return [this]() {
+        MSF_LOG(msf::LogLevel::Info, "EVENT", "Scheduled Shutdown Event Triggered at t={}s", clock.now());
+        is_running = false; // Stop the main loop after this event (or end the current branch)
+    };
+}
+
+EventCallback Controller::bind_event(const EventTag& tag, EventDescriptionId description_id) {
+    switch (tag.kind) {
+    case EventKind::Shutdown:
+        return make_shutdown_event();
+    case EventKind::Trigger:
+        if (std::shared_ptr<Entity> entity = registry.get_entity(tag.entity_id)) {
+            return SCF::make_trigger_callback(description_id, *entity, tag);
+        }
+        return {};
+    case EventKind::Opaque:
+        break;
+    }
+    return {};
+}
+
 void Controller::run() {
+    run_loop();
+    if (is_running) {
+        run_branches(); // The loop stopped at the branch point
+    }
+    shutdown();
+}
+
+void Controller::run_loop() {
+    pacer.start(clock);
+
     // Main application loop
     while (is_running) {
+        MSF_PROFILE_TICK();
+        MSF_PROFILE_SCOPE("tick");
+        tick_monitor.begin_tick(clock.now());
+
+        // 0) Safe point: entities that shut down during the last tick leave the registry before their
+        //    requests can be scheduled or their events can fire
+        {
+            MSF_PROFILE_SCOPE("apply_removals");
+            registry.apply_pending_removals();
+        }
+        tick_monitor.end_phase("apply_removals");
+
         // 1) Schedule any new events requested by entities (uses ABSOLUTE sim time)
-        registry.schedule_entitiy_events(scheduler, clock);
+        {
+            MSF_PROFILE_SCOPE("schedule_requests");
+            registry.schedule_entitiy_events(scheduler, clock);
+        }
+        tick_monitor.end_phase("schedule_requests");
+
+        // Checkpoints are taken here: removals are applied, requests scheduled and nothing due has fired
+        if (checkpoint_writer.is_due(clock.now())) {
+            MSF_PROFILE_SCOPE("checkpoint");
+            save_checkpoint();
+            tick_monitor.end_phase("checkpoint");
+        }
+
+        // Branch point: the shared prefix ends here, each branch resumes from this same safe point
+        if (clock.now() >= branch_time) {
+            return;
+        }
 
         // 2) Execute any due scheduled events at the CURRENT simulation time
-        scheduler.process_events(clock);
+        {
+            MSF_PROFILE_SCOPE("process_events");
+            scheduler.process_events(clock);
+        }
+        tick_monitor.end_phase("process_events");
+        if (!is_running) {
+            break; // Shutdown event
+        }
 
-        // 3) If paused, do not tick entities but still advance time so scheduled events can fire
+        // 3) Nothing to integrate: jump straight to the next event instead of stepping through idle ticks
+        if (can_fast_forward()) {
+            MSF_PROFILE_SCOPE("fast_forward");
+            fast_forward();
+            tick_monitor.end_phase("fast_forward");
+            tick_monitor.end_tick();
+            pacer.wait(clock); // Sleeps through the whole idle stretch when paced
+            continue;
+        }
+
+        // 4) If paused, do not tick entities but still advance time so scheduled events can fire
         if (!is_paused) {
-            // 4) Tick entities (your Entity base/derived classes should implement update(t, dt))
-            const double t = clock.now();
-            registry.for_each_entity([&](Entity& e) {
-                e.update(t, dt);
-            });
+            MSF_PROFILE_SCOPE("entity_update");
+            // 5) Tick entities (your Entity base/derived classes should implement update(t, dt)).
+            //    Serial or split across the tick engine's thread pool; results are identical.
+            //    When this tick reaches a trajectory output time, each entity is sampled right after its update.
+            TickObserver* sampler = trajectory_recorder.begin_sample(registry, clock.now() + dt);
+            tick_engine.tick(registry, clock.now(), dt, sampler);
+            trajectory_recorder.finish_sample();
+            if (is_replica) {
+                miss_tracker.observe(registry);
+            }
         }
+        tick_monitor.end_phase("entity_update");
 
-        // 5) Advance simulation time deterministically (even when paused)
+        // 6) Advance simulation time deterministically (even when paused)
         clock.advance(dt);
 
+        // 7) While paused nothing is updated, so keep the output rate with a plain sample (no-op otherwise)
+        if (is_paused) {
+            MSF_PROFILE_SCOPE("trajectory");
+            trajectory_recorder.record(registry, clock.now());
+        }
+        state_hasher.record(registry, clock.now()); // Every K ticks with --state-hash (no-op otherwise)
+        tick_monitor.end_phase("trajectory");
+        tick_monitor.end_tick(is_paused ? TickEngine::SlowestUpdate{} : tick_engine.get_slowest_update());
+
+        // 8) Real-time pacing: hold until wall time reaches the new sim time (no-op when unpaced)
+        if (pacer.is_enabled()) {
+            MSF_PROFILE_SCOPE("pacing");
+            pacer.wait(clock);
+        }
+
         // Optional: wall-clock logging every ~1 second of wall time
         if (clock.get_elapsed_wall_time_ms().count() > 1000.0) {
-            std::cout << "[INFO] SimTime: " << clock.now() << " s | dt: " << dt
-                      << " s | Registered Entities: " << registry.get_entity_count() << std::endl;
+            MSF_LOG_INFO("SimTime: {} s | dt: {} s | Registered Entities: {} | Tick p99: {:.3f} us", clock.now(), dt,
+                         registry.get_entity_count(), tick_monitor.get_histogram().percentile(99.0) / 1e3);
             clock.reset_elapsed_wall_time();
         }
     }
+}
 
-    shutdown();
+void Controller::run_branches() {
+    const SCF::BranchPlan& plan = scf->get_branch_plan();
+    branch_prefix_ms = clock.get_total_elapsed_wall_time_ms().count(); // The clock was last reset at t=0 (or the restore)
+    branch_time = std::numeric_limits<double>::infinity();
+
+    // The shared prefix as an in-memory checkpoint, restored once per branch
+    Checkpoint::RunState fork_state;
+    fork_state.sim_time = clock.now();
+    fork_state.dt = dt;
+    fork_state.tick_frame = tick_engine.get_frame();
+    fork_state.seed = seed;
+    StateWriter prefix;
+    std::size_t skipped_events = 0;
+    std::string error;
+    if (!Checkpoint::capture(fork_state, registry, scheduler, prefix, skipped_events, error)) {
+        MSF_LOG_ERROR("Cannot branch at t={}s: {}", fork_state.sim_time, error);
+        return;
+    }
+    if (skipped_events > 0) {
+        MSF_LOG_WARNING("{} untagged events are not carried into the branches", skipped_events);
+    }
+    MSF_LOG_INFO("Shared prefix to t={}s took {:.1f} ms; running {} branches from it", fork_state.sim_time,
+                 branch_prefix_ms, plan.branches.size());
+
+    // Outputs of the prefix end here; each branch writes its own trajectory and state hash files
+    checkpoint_writer.close();
+    const std::string trajectory_file = trajectory_recorder.is_open() ? scf->get_output_options().trajectory_file : "";
+    trajectory_recorder.close();
+    const std::string state_hash_file = state_hasher.is_open() ? state_hasher.get_path() : "";
+    state_hasher.close();
+
+    const auto bind = [this](const EventTag& tag, EventDescriptionId description_id) {
+        return bind_event(tag, description_id);
+    };
+    for (const SCF::Branch& branch : plan.branches) {
+        const auto start = SimulationClock::WallClock::now();
+        registry.shutdown();
+        scheduler.clear();
+        Checkpoint::RunState run;
+        if (!Checkpoint::restore(prefix.bytes().data(), prefix.size(), run, registry, scheduler, bind, error)) {
+            MSF_LOG_ERROR("Failed to start branch '{}': {}", branch.name, error);
+            continue;
+        }
+        clock.reset(run.sim_time);
+        tick_engine.set_frame(run.tick_frame);
+        scf->apply_branch(registry, branch);
+
+        if (!trajectory_file.empty() && trajectory_recorder.open(branch_output_path(trajectory_file, branch.name),
+                                                                 scf->get_output_options().trajectory_rate_hz)) {
+            trajectory_recorder.record(registry, clock.now());
+        }
+        if (!state_hash_file.empty() &&
+            state_hasher.open(branch_output_path(state_hash_file, branch.name), state_hasher.get_interval_ticks(), dt)) {
+            state_hasher.record(registry, clock.now());
+        }
+
+        MSF_LOG_INFO("Branch '{}' starting at t={}s", branch.name, clock.now());
+        is_running = true;
+        run_loop();
+        trajectory_recorder.close();
+        state_hasher.close();
+
+        BranchResult result;
+        result.name = branch.name;
+        result.end_time = clock.now();
+        result.entity_count = registry.get_entity_count();
+        result.wall_ms = std::chrono::duration<double, std::milli>(SimulationClock::WallClock::now() - start).count();
+        branch_results.push_back(result);
+    }
+}
+
+bool Controller::can_fast_forward() {
+    return fast_forward_enabled && (is_paused || registry.get_active_count() == 0) &&
+           !registry.has_pending_requests() && std::isfinite(scheduler.next_event_time());
+}
+
+void Controller::fast_forward() {
+    // advance_until() rounds like the skipped advance(dt) calls would, so events fire and samples are
+    // taken on the same ticks as with --no-fast-forward
+    const SimulationClock::SimTime target = std::min({scheduler.next_event_time(), trajectory_recorder.next_sample_time(),
+                                                      checkpoint_writer.next_checkpoint_time(),
+                                                      state_hasher.next_sample_time(), branch_time});
+    const uint64_t ticks = clock.advance_until(target, dt);
+    if (!is_paused) {
+        tick_engine.skip_ticks(ticks);
+    }
+    fast_forward_ticks += ticks;
+    trajectory_recorder.record(registry, clock.now());
+    state_hasher.record(registry, clock.now());
 }
 
 void Controller::shutdown() {
-    std::cout << "[INFO] Shutting down Simulation Controller" << std::endl;
+    MSF_LOG_INFO("Shutting down Simulation Controller");
+    outcome.end_time = clock.now();
+    outcome.ticks = tick_engine.get_frame();
+    outcome.entity_count = registry.get_entity_count();
+    outcome.closest_approaches = miss_tracker.get_closest_approaches();
+
+    // Replicas are summarized by the BatchRunner instead
+    if (!is_replica) {
+        if (fast_forward_ticks > 0) {
+            MSF_LOG_INFO("Fast-forwarded over {} idle ticks", fast_forward_ticks);
+        }
+        tick_engine.report();
+        tick_monitor.report();
+        pacer.report();
+        report_branches();
+    }
+    checkpoint_writer.close(); // Finishes the checkpoint being written
+    checkpoint_writer.report();
+    if (!is_replica) {
+        msf::Profiler::instance().report(); // Empty unless --profile
+        msf::Profiler::instance().write_trace();
+    }
+    trajectory_recorder.close(); // Drains queued frames before the process exits
+    state_hasher.close();
     registry.shutdown(); // Clean up entities
-    std::cout << "[INFO] Shutdown complete for Simulation Controller" << std::endl;
-    exit(EXIT_SUCCESS);
+    MSF_LOG_INFO("Shutdown complete for Simulation Controller");
+}
+
+void Controller::report_branches() const {
+    if (branch_results.empty()) {
+        return;
+    }
+    double branches_ms = 0.0;
+    MSF_LOG_INFO("Branch results:");
+    for (const BranchResult& result : branch_results) {
+        MSF_LOG_INFO("  {}: ended at t={}s with {} entities, {:.1f} ms", result.name, result.end_time,
+                     result.entity_count, result.wall_ms);
+        branches_ms += result.wall_ms;
+    }
+    // Running every branch from t=0 would have repeated the prefix once per branch
+    MSF_LOG_INFO("Shared prefix ran once ({:.1f} ms) instead of {} times: {:.1f} ms total, saved ~{:.1f} ms",
+                 branch_prefix_ms, branch_results.size(), branch_prefix_ms + branches_ms,
+                 branch_prefix_ms * static_cast<double>(branch_results.size() - 1));
 }
 
 void Controller::pause() {
     if (!is_paused) {
-        std::cout << "[INFO] Pausing Simulation" << std::endl;
+        MSF_LOG_INFO("Pausing Simulation");
         is_paused = true;
     }
 }
 
 void Controller::resume() {
     if (is_paused) {
-        std::cout << "[INFO] Resuming Simulation" << std::endl;
+        MSF_LOG_INFO("Resuming Simulation");
         is_paused = false;
     }
 }
\ No newline at end of file
@@ -1,6 +1,118 @@
 #include "ArgParse.hpp"
 
 #include <iostream>
+#include <thread>
+
+#include "Logger.hpp"
+#include "RealTimePacer.hpp"
+
+namespace {
+
+// Parse a positive decimal integer.
+bool parse_positive_count(const std::string& value, std::size_t& count) {
+    if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+
+    try {
+        count = static_cast<std::size_t>(std::stoul(value));
+    } catch (const std::exception&) {
+        return false;
+    }
+    return count > 0;
+}
+
+// Parse an unsigned 64-bit decimal integer (0 allowed).
+bool parse_seed(const std::string& value, uint64_t& seed) {
+    if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+
+    try {
+        seed = static_cast<uint64_t>(std::stoull(value));
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
+
+// Parse a thread count: a positive integer, or "auto" for one thread per hardware core.
+bool parse_thread_count(const std::string& value, std::size_t& thread_count) {
+    if (value == "auto") {
+        thread_count = std::thread::hardware_concurrency();
+        if (thread_count == 0) {
+            thread_count = 1;
+        }
+        return true;
+    }
+    return parse_positive_count(value, thread_count);
+}
+
+// Parse a real-time pacing factor: 0 (as fast as possible) or a scale within the pacer's range.
+bool parse_time_scale(const std::string& value, double& time_scale) {
+    std::size_t parsed = 0;
+    try {
+        time_scale = std::stod(value, &parsed);
+    } catch (const std::exception&) {
+        return false;
+    }
+    if (parsed != value.size()) {
+        return false;
+    }
+    return time_scale == 0.0 ||
+           (time_scale >= RealTimePacer::kMinTimeScale && time_scale <= RealTimePacer::kMaxTimeScale);
+}
+
+// Parse a positive number of seconds.
+bool parse_seconds(const std::string& value, double& seconds) {
+    std::size_t parsed = 0;
+    try {
+        seconds = std::stod(value, &parsed);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return parsed == value.size() && seconds > 0.0;
+}
+
+// Parse a non-negative number of milliseconds.
+bool parse_milliseconds(const std::string& value, double& milliseconds) {
+    std::size_t parsed = 0;
+    try {
+        milliseconds = std::stod(value, &parsed);
+    } catch (const std::exception&) {
+        return false;
+    }
+    return parsed == value.size() && milliseconds >= 0.0;
+}
+
+enum class OptionMatch {
+    None,    // Argument is a different option
+    Value,   // Option matched and value was read
+    Missing, // Option matched but no value followed it
+};
+
+// Match "<short_name> <value>", "<long_name> <value>" or "<long_name>=<value>".
+// short_name may be nullptr for long-only options. Advances arg_index past a separate value.
+OptionMatch match_option(const std::string& argument, const char* short_name, const char* long_name,
+                         int argc, char** argv, int& arg_index, std::string& value) {
+    if ((short_name != nullptr && argument == short_name) || argument == long_name) {
+        if (arg_index + 1 >= argc) {
+            return OptionMatch::Missing;
+        }
+        value = argv[++arg_index];
+        return OptionMatch::Value;
+    }
+
+    const std::string prefix = std::string(long_name) + "=";
+    if (argument.rfind(prefix, 0) == 0) {
+        value = argument.substr(prefix.size());
+        return value.empty() ? OptionMatch::Missing : OptionMatch::Value;
+    }
+
+    return OptionMatch::None;
+}
+
+} // namespace
 
 bool ArgParse::parse(int argc, char** argv, Options& options, std::string& error_message) {
     if (argc <= 0 || argv == nullptr) {
@@ -36,6 +148,220 @@ bool ArgParse::parse(int argc, char** argv, Options& options, std::string& error
             continue;
         }
 
+        std::string value;
+        OptionMatch match = match_option(argument, "-j", "--threads", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --threads.";
+                return false;
+            }
+            if (!parse_thread_count(value, options.tick_threads)) {
+                error_message = "Invalid value for --threads: " + value;
+                return false;
+            }
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--scheduler", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --scheduler.";
+                return false;
+            }
+            if (value != "heap" && value != "wheel") {
+                error_message = "Invalid value for --scheduler: " + value + " (expected heap or wheel)";
+                return false;
+            }
+            options.scheduler_backend = value;
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--log-level", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            msf::LogLevel level;
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --log-level.";
+                return false;
+            }
+            if (!msf::parse_log_level(value, level)) {
+                error_message = "Invalid value for --log-level: " + value + " (expected debug, info, warning, error or off)";
+                return false;
+            }
+            options.log_level = value;
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--time-scale", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --time-scale.";
+                return false;
+            }
+            if (!parse_time_scale(value, options.time_scale)) {
+                error_message = "Invalid value for --time-scale: " + value + " (expected 0.1 to 100, or 0 for unpaced)";
+                return false;
+            }
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--tick-deadline", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --tick-deadline.";
+                return false;
+            }
+            if (!parse_milliseconds(value, options.tick_deadline_ms)) {
+                error_message = "Invalid value for --tick-deadline: " + value + " (expected milliseconds >= 0)";
+                return false;
+            }
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--checkpoint", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --checkpoint.";
+                return false;
+            }
+            options.checkpoint_path = value;
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--checkpoint-interval", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --checkpoint-interval.";
+                return false;
+            }
+            if (!parse_seconds(value, options.checkpoint_interval)) {
+                error_message = "Invalid value for --checkpoint-interval: " + value + " (expected seconds > 0)";
+                return false;
+            }
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--restore", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --restore.";
+                return false;
+            }
+            options.restore_path = value;
+            continue;
+        }
+
+        if (argument == "--no-fast-forward") {
+            options.fast_forward = false;
+            continue;
+        }
+
+        if (argument == "--no-branches") {
+            options.branches = false;
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--seed", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --seed.";
+                return false;
+            }
+            if (!parse_seed(value, options.seed)) {
+                error_message = "Invalid value for --seed: " + value + " (expected an unsigned integer)";
+                return false;
+            }
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--replicas", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --replicas.";
+                return false;
+            }
+            if (!parse_positive_count(value, options.replicas)) {
+                error_message = "Invalid value for --replicas: " + value + " (expected a positive integer)";
+                return false;
+            }
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--batch-threads", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --batch-threads.";
+                return false;
+            }
+            if (!parse_thread_count(value, options.batch_threads)) {
+                error_message = "Invalid value for --batch-threads: " + value + " (expected a positive integer or 'auto')";
+                return false;
+            }
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--batch-results", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --batch-results.";
+                return false;
+            }
+            options.batch_results_path = value;
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--state-hash", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --state-hash.";
+                return false;
+            }
+            options.state_hash_path = value;
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--state-hash-interval", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --state-hash-interval.";
+                return false;
+            }
+            if (!parse_positive_count(value, options.state_hash_interval) ||
+                options.state_hash_interval > UINT32_MAX) {
+                error_message = "Invalid value for --state-hash-interval: " + value + " (expected a positive integer)";
+                return false;
+            }
+            continue;
+        }
+
+        if (argument == "--profile") {
+            options.profile = true;
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--trace", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --trace.";
+                return false;
+            }
+            options.trace_path = value;
+            options.profile = true;
+            continue;
+        }
+
+        match = match_option(argument, nullptr, "--trace-ticks", argc, argv, arg_index, value);
+        if (match != OptionMatch::None) {
+            if (match == OptionMatch::Missing) {
+                error_message = "Missing value for --trace-ticks.";
+                return false;
+            }
+            if (!parse_positive_count(value, options.trace_ticks)) {
+                error_message = "Invalid value for --trace-ticks: " + value + " (expected a positive integer)";
+                return false;
+            }
+            continue;
+        }
+
         error_message = "Unknown argument: " + argument;
         return false;
     }
@@ -44,9 +370,34 @@ bool ArgParse::parse(int argc, char** argv, Options& options, std::string& error
 }
 
 void ArgParse::print_usage(const std::string& program_name) {
-    std::cout << "Usage: " << program_name << " [--scenario <path>]\n"
+    std::cout << "Usage: " << program_name << " [--scenario <path>] [--threads <n|auto>] [--scheduler <heap|wheel>]\n"
+              << "       [--log-level <level>] [--profile] [--trace <file>] [--trace-ticks <n>]\n"
+              << "       [--time-scale <x>] [--tick-deadline <ms>] [--no-fast-forward]\n"
+              << "       [--checkpoint <file>] [--checkpoint-interval <s>] [--restore <file>]\n"
+              << "       [--no-branches] [--seed <n>] [--replicas <n>] [--batch-threads <n|auto>]\n"
+              << "       [--batch-results <file>] [--state-hash <file>] [--state-hash-interval <ticks>]\n"
               << "Options:\n"
               << "  -s, --scenario <path>  Path to scenario XML file\n"
               << "      --scenario=<path>  Path to scenario XML file\n"
+              << "  -j, --threads <n>      Entity update threads (n or 'auto', overrides SCF)\n"
+              << "      --threads=<n>      Entity update threads (n or 'auto', overrides SCF)\n"
+              << "      --scheduler <type> Event scheduler backend: heap or wheel (overrides SCF)\n"
+              << "      --log-level <lvl>  Lowest log level printed: debug, info, warning, error or off\n"
+              << "      --profile          Time loop phases, entity classes and events; print a summary at shutdown\n"
+              << "      --trace <file>     Also write a Chrome/Perfetto trace JSON (implies --profile)\n"
+              << "      --trace-ticks <n>  Ticks captured in the trace (default 100)\n"
+              << "      --time-scale <x>   Pace sim time at x times wall time (0.1-100, 0 = as fast as possible; overrides SCF)\n"
+              << "      --tick-deadline <ms> Log ticks that take longer than ms of wall time (0 = off; overrides SCF)\n"
+              << "      --no-fast-forward  Step every tick even when no entity is active (paused, static or asleep)\n"
+              << "      --checkpoint <file> Write a full-state checkpoint to file periodically (overrides SCF)\n"
+              << "      --checkpoint-interval <s> Sim seconds between checkpoints (default 60, overrides SCF)\n"
+              << "      --restore <file>   Resume from a checkpoint; settings still come from the scenario file\n"
+              << "      --no-branches      Ignore the scenario's <Branches> and run it straight through\n"
+              << "      --seed <n>         Random seed of the run (default 1); batch replica i uses n + i\n"
+              << "      --replicas <n>     Monte Carlo batch: run n replicas of the scenario side by side and summarize them\n"
+              << "      --batch-threads <n> Threads running replicas (n or 'auto', default one per core)\n"
+              << "      --batch-results <file> Write one CSV row of outcomes per replica\n"
+              << "      --state-hash <file> Write per-entity state hashes to file; compare runs with msf_state_hash_compare\n"
+              << "      --state-hash-interval <ticks> Ticks between state hash samples (default 100)\n"
               << "  -h, --help             Show this help message\n";
 }
@@ -0,0 +1,385 @@
+#include "Checkpoint.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
+
+#include "Logger.hpp"
+
+namespace {
+
+// Readers refuse counts past this, so a corrupt header can't make restore allocate gigabytes
+constexpr uint32_t kMaxCount = 1u << 28;
+
+} // namespace
+
+bool Checkpoint::capture(const RunState& run, const EntityRegistry& registry, const SimEventScheduler& scheduler,
+                         StateWriter& out, std::size_t& skipped_events, std::string& error) {
+    out.clear();
+    skipped_events = 0;
+    out.write_bytes(kMagic, sizeof(kMagic));
+    out.write(kVersion);
+    out.write(run.sim_time);
+    out.write(run.dt);
+    out.write(run.tick_frame);
+    out.write(run.seed);
+    out.write(static_cast<int32_t>(Entity::get_next_id()));
+
+    // Class table, then each entity refers to its class by index
+    std::vector<const Entity*> entities;
+    std::vector<uint16_t> entity_classes;
+    std::vector<const std::string*> classes;
+    std::unordered_map<const std::string*, uint16_t> class_indices;
+    entities.reserve(registry.get_entity_count());
+    entity_classes.reserve(registry.get_entity_count());
+    bool ok = true;
+    registry.for_each_entity([&](const Entity& entity) {
+        const std::string& class_name = registry.get_class_name(entity);
+        if (class_name.empty()) {
+            if (ok) {
+                error = "Entity '" + entity.get_name() + "' has a class that was not registered by name";
+            }
+            ok = false;
+            return;
+        }
+        const auto inserted = class_indices.emplace(&class_name, static_cast<uint16_t>(classes.size()));
+        if (inserted.second) {
+            classes.push_back(&class_name);
+        }
+        entities.push_back(&entity);
+        entity_classes.push_back(inserted.first->second);
+    });
+    if (!ok) {
+        return false;
+    }
+    out.write(static_cast<uint32_t>(classes.size()));
+    for (const std::string* class_name : classes) {
+        out.write_string(*class_name);
+    }
+
+    // Slot layout: the free list is saved as is, registered slots come with their entities
+    const std::vector<uint32_t>& free_slots = registry.get_free_slots();
+    out.write(static_cast<uint32_t>(registry.get_slot_count()));
+    out.write(static_cast<uint32_t>(free_slots.size()));
+    out.write_bytes(free_slots.data(), free_slots.size() * sizeof(uint32_t));
+
+    out.write(static_cast<uint32_t>(entities.size()));
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+        const Entity& entity = *entities[i];
+        out.write(entity_classes[i]);
+        out.write(static_cast<int32_t>(entity.get_id()));
+        out.write(entity.get_handle().index);
+        const std::size_t size_offset = out.size();
+        out.write(uint32_t{0});
+        entity.save_state(out);
+        out.patch(size_offset, static_cast<uint32_t>(out.size() - size_offset - sizeof(uint32_t)));
+    }
+
+    const std::vector<SimEventScheduler::PendingEvent> pending = scheduler.get_pending_events();
+    const std::size_t event_count_offset = out.size();
+    out.write(uint32_t{0});
+    uint32_t event_count = 0;
+    for (const SimEventScheduler::PendingEvent& event : pending) {
+        if (event.tag.kind == EventKind::Opaque) {
+            ++skipped_events;
+            continue;
+        }
+        out.write(event.execution_time);
+        out.write_string(event_description_name(event.description_id));
+        out.write(event.tag.kind);
+        out.write(static_cast<int32_t>(event.tag.entity_id));
+        out.write(event.tag.argument);
+        ++event_count;
+    }
+    out.patch(event_count_offset, event_count);
+    return true;
+}
+
+bool Checkpoint::restore(const char* data, std::size_t size, RunState& run, EntityRegistry& registry,
+                         SimEventScheduler& scheduler, const EventBinder& bind, std::string& error) {
+    if (registry.get_entity_count() != 0 || !scheduler.empty()) {
+        error = "Checkpoints can only be restored into an empty registry and scheduler";
+        return false;
+    }
+
+    StateReader in(data, size);
+    char magic[sizeof(kMagic)] = {};
+    in.read_bytes(magic, sizeof(magic));
+    if (!in.is_ok() || !std::equal(std::begin(magic), std::end(magic), std::begin(kMagic))) {
+        error = "Not a checkpoint file";
+        return false;
+    }
+    const uint32_t version = in.read<uint32_t>();
+    if (version != kVersion) {
+        error = "Unsupported checkpoint version " + std::to_string(version);
+        return false;
+    }
+    run.sim_time = in.read<double>();
+    run.dt = in.read<double>();
+    run.tick_frame = in.read<uint64_t>();
+    run.seed = in.read<uint64_t>();
+    const int32_t next_entity_id = in.read<int32_t>();
+
+    const uint32_t class_count = in.read<uint32_t>();
+    if (class_count > kMaxCount) {
+        in.fail();
+    }
+    std::vector<std::string> classes;
+    for (uint32_t i = 0; in.is_ok() && i < class_count; ++i) {
+        classes.push_back(in.read_string());
+    }
+
+    const uint32_t slot_count = in.read<uint32_t>();
+    const uint32_t free_count = in.read<uint32_t>();
+    if (free_count > kMaxCount || free_count > in.remaining() / sizeof(uint32_t)) {
+        in.fail();
+    }
+    std::vector<uint32_t> free_slots(in.is_ok() ? free_count : 0);
+    in.read_bytes(free_slots.data(), free_slots.size() * sizeof(uint32_t));
+
+    // Entities are created and their state loaded first; the slot layout has to be in place before any
+    // of them is registered
+    const uint32_t entity_count = in.read<uint32_t>();
+    if (entity_count > kMaxCount) {
+        in.fail();
+    }
+    std::vector<std::shared_ptr<Entity>> restored;
+    std::vector<uint32_t> registration_slots;
+    restored.reserve(in.is_ok() ? entity_count : 0);
+    registration_slots.reserve(restored.capacity());
+    for (uint32_t i = 0; in.is_ok() && i < entity_count; ++i) {
+        const uint16_t class_index = in.read<uint16_t>();
+        const int32_t id = in.read<int32_t>();
+        const uint32_t slot = in.read<uint32_t>();
+        StateReader state = in.sub_reader(in.read<uint32_t>());
+        if (!in.is_ok() || class_index >= classes.size()) {
+            in.fail();
+            break;
+        }
+
+        Entity::set_next_id(id);
+        std::shared_ptr<Entity> entity = registry.create_entity_from_string(classes[class_index]);
+        if (!entity) {
+            error = "Checkpoint entity " + std::to_string(id) + " has unknown class '" + classes[class_index] + "'";
+            Entity::set_next_id(next_entity_id);
+            return false;
+        }
+        entity->load_state(state);
+        if (!state.is_done()) {
+            error = "Corrupt state for checkpoint entity " + std::to_string(id);
+            Entity::set_next_id(next_entity_id);
+            return false;
+        }
+        restored.push_back(std::move(entity));
+        registration_slots.push_back(slot);
+    }
+    Entity::set_next_id(next_entity_id);
+    if (!in.is_ok()) {
+        error = "Checkpoint is truncated or corrupt";
+        return false;
+    }
+    if (!registry.prepare_slots(slot_count, registration_slots, free_slots)) {
+        error = "Checkpoint has an inconsistent registry slot layout";
+        return false;
+    }
+    for (std::shared_ptr<Entity>& entity : restored) {
+        registry.register_entity(std::move(entity));
+    }
+
+    // Events go back in firing order, so equal-time events keep their relative order
+    const uint32_t event_count = in.read<uint32_t>();
+    std::size_t dropped = 0;
+    for (uint32_t i = 0; in.is_ok() && i < event_count; ++i) {
+        const double execution_time = in.read<double>();
+        const EventDescriptionId description_id = intern_event_description(in.read_string());
+        EventTag tag;
+        tag.kind = in.read<EventKind>();
+        tag.entity_id = in.read<int32_t>();
+        tag.argument = in.read<uint8_t>();
+        if (!in.is_ok()) {
+            break;
+        }
+        EventCallback callback = bind(tag, description_id);
+        if (!callback) {
+            ++dropped;
+            continue;
+        }
+        const EventHandle handle = scheduler.schedule_event_at(execution_time, std::move(callback), description_id, tag);
+        if (tag.entity_id >= 0) {
+            registry.track_entity_event(scheduler, tag.entity_id, handle);
+        }
+    }
+    if (!in.is_done()) {
+        error = "Checkpoint is truncated or corrupt";
+        return false;
+    }
+    if (dropped > 0) {
+        MSF_LOG_WARNING("Dropped {} checkpointed events that could not be rebuilt", dropped);
+    }
+    return true;
+}
+
+bool Checkpoint::restore_file(const std::string& path, RunState& run, EntityRegistry& registry,
+                              SimEventScheduler& scheduler, const EventBinder& bind, std::string& error) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        error = "Failed to open checkpoint file: " + path;
+        return false;
+    }
+    std::vector<char> bytes;
+    char buffer[1 << 16];
+    std::size_t read = 0;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + read);
+    }
+    const bool read_failed = std::ferror(file) != 0;
+    std::fclose(file);
+    if (read_failed) {
+        error = "Failed to read checkpoint file: " + path;
+        return false;
+    }
+    return restore(bytes.data(), bytes.size(), run, registry, scheduler, bind, error);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    close();
+}
+
+bool CheckpointWriter::open(const std::string& path, double interval_seconds, double start_time) {
+    close();
+    if (path.empty() || !(interval_seconds >= 0.0)) {
+        MSF_LOG_ERROR("Checkpoints need a file and an interval >= 0 (got '{}', {} s).", path, interval_seconds);
+        return false;
+    }
+    path_ = path;
+    interval_ = interval_seconds;
+    // The first checkpoint is one interval after start_time, so a restored run doesn't rewrite its own file at once
+    next_index_ = interval_ > 0.0 ? static_cast<uint64_t>(std::floor(start_time / interval_ + 1e-6)) + 1 : 0;
+    stopping_ = false;
+    busy_ = false;
+    writer_ = std::thread([this]() { run_writer(); });
+    if (interval_ > 0.0) {
+        MSF_LOG_INFO("Writing checkpoints to {} every {} s of sim time", path_, interval_);
+    }
+    return true;
+}
+
+bool CheckpointWriter::save(const Checkpoint::RunState& run, const EntityRegistry& registry,
+                            const SimEventScheduler& scheduler) {
+    if (!is_open()) {
+        return false;
+    }
+    if (interval_ > 0.0) {
+        next_index_ = static_cast<uint64_t>(std::floor(run.sim_time / interval_ + 1e-6)) + 1;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (busy_) {
+            ++skipped_busy_;
+            MSF_LOG_WARNING("Checkpoint at t={}s skipped: the previous one is still being written", run.sim_time);
+            return false;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t skipped_events = 0;
+    std::string error;
+    if (!Checkpoint::capture(run, registry, scheduler, capture_, skipped_events, error)) {
+        MSF_LOG_ERROR("Checkpoint at t={}s failed: {}", run.sim_time, error);
+        return false;
+    }
+    const double capture_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    capture_ms_total_ += capture_ms;
+    capture_ms_max_ = std::max(capture_ms_max_, capture_ms);
+    ++captured_;
+    if (skipped_events > 0) {
+        MSF_LOG_WARNING("Checkpoint at t={}s left out {} events without a serializable type", run.sim_time,
+                        skipped_events);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::swap(writing_, capture_.bytes());
+        writing_time_ = run.sim_time;
+        busy_ = true;
+    }
+    work_ready_.notify_one();
+    return true;
+}
+
+void CheckpointWriter::close() {
+    if (!is_open()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_ready_.notify_one();
+    writer_.join();
+}
+
+double CheckpointWriter::next_checkpoint_time() const {
+    if (!is_open() || interval_ <= 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    // Same tolerance as trajectory output, so accumulated timestep rounding doesn't push a checkpoint one tick late
+    return static_cast<double>(next_index_) * interval_ - 1e-6 * interval_;
+}
+
+uint64_t CheckpointWriter::get_checkpoints_written() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+}
+
+void CheckpointWriter::report() const {
+    if (captured_ == 0 && skipped_busy_ == 0) {
+        return;
+    }
+    MSF_LOG_INFO("Checkpoints: {} written to {}, {} skipped while busy, capture avg {:.3f} ms, max {:.3f} ms",
+                 get_checkpoints_written(), path_, skipped_busy_, captured_ ? capture_ms_total_ / captured_ : 0.0,
+                 capture_ms_max_);
+}
+
+void CheckpointWriter::run_writer() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        work_ready_.wait(lock, [this]() { return stopping_ || busy_; });
+        if (!busy_) {
+            break; // Stopping and nothing left to write
+        }
+        const double time = writing_time_;
+        lock.unlock();
+        const bool written = write_file(writing_);
+        lock.lock();
+        if (written) {
+            ++written_;
+            MSF_LOG_DEBUG("Checkpoint at t={}s written to {} ({} bytes)", time, path_, writing_.size());
+        }
+        busy_ = false;
+    }
+}
+
+bool CheckpointWriter::write_file(const std::vector<char>& bytes) {
+    const std::string temporary = path_ + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        MSF_LOG_ERROR("Failed to open checkpoint file: {}", temporary);
+        return false;
+    }
+    const bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    if (std::fclose(file) != 0 || !written) {
+        MSF_LOG_ERROR("Failed to write checkpoint file: {}", temporary);
+        std::remove(temporary.c_str());
+        return false;
+    }
+    if (std::rename(temporary.c_str(), path_.c_str()) != 0) {
+        MSF_LOG_ERROR("Failed to replace checkpoint file: {}", path_);
+        return false;
+    }
+    return true;
+}
@@ -1,8 +1,32 @@
 #include "SCF.hpp"
 
-bool SCF::parse_scf(EntityRegistry& registry, msf::SimDt& timestep) {
+#include <algorithm>
+#include <thread>
+
+#include "RealTimePacer.hpp"
+
+bool SCF::parse_scf(EntityRegistry& registry, msf::SimDt& timestep, bool load_entities) {
+    if (!parse_settings(timestep)) {
+        return false;
+    }
+
+    // Restoring a checkpoint only needs the settings; its entities come from the checkpoint
+    if (!load_entities) {
+        return true;
+    }
+    return create_entities(registry);
+}
+
+/*
+* @func parse_settings
+* @param:
+*  timestep - Set to the <TimeStepInterval> (left unchanged without a <SimulationSetup>).
+* @brief: Load the scenario file and read everything except the entities: <SimulationSetup>, <Output> and
+* <Branches>. The parsed document is kept, so create_entities can build the entities later, as often as needed.
+*/
+bool SCF::parse_settings(msf::SimDt& timestep) {
     if (scf_filepath.empty()) {
-        std::cerr << "[ERROR] SCF file path is empty. Cannot parse SCF." << std::endl;
+        MSF_LOG_ERROR("SCF file path is empty. Cannot parse SCF.");
         return false;
     }
 
@@ -13,7 +37,7 @@ bool SCF::parse_scf(EntityRegistry& registry, msf::SimDt& timestep) {
 
     XMLParser::XMLNode root = parser.get_root();
     if (!root.is_valid()) {
-        std::cerr << "[ERROR] SCF parse failed: XML root is invalid." << std::endl;
+        MSF_LOG_ERROR("SCF parse failed: XML root is invalid.");
         return false;
     }
 
@@ -27,21 +51,40 @@ bool SCF::parse_scf(EntityRegistry& registry, msf::SimDt& timestep) {
             timestep = dt;
             
         } catch (const std::invalid_argument& e) {
-            std::cerr << "[ERROR] Invalid timestep value in SCF file: " << e.what() << std::endl;
+            MSF_LOG_ERROR("Invalid timestep value in SCF file: {}", e.what());
             timestep = 0.001; // Default timestep
         } catch (const std::exception& e) {
-            std::cerr << "[ERROR] Failed to parse SimulationSetup: " << e.what() << std::endl;
+            MSF_LOG_ERROR("Failed to parse SimulationSetup: {}", e.what());
             return false;
         }
+
+        parse_parallel_tick(simulation_setup.get_child("ParallelTick"));
+        parse_event_scheduler(simulation_setup.get_child("EventScheduler"));
+        parse_real_time(simulation_setup.get_child("RealTime"));
+        parse_tick_deadline(simulation_setup.get_child("TickDeadline"));
     } else {
-        std::cerr << "[WARNING] No SimulationSetup found in SCF file. Using default settings." << std::endl;
+        MSF_LOG_WARNING("No SimulationSetup found in SCF file. Using default settings.");
     }
+    setup_options.timestep = timestep;
 
+    parse_output(root.get_child("Output"));
+    parse_branches(root.get_child("Branches"));
+    return true;
+}
+
+/*
+* @func create_entities
+* @param:
+*  registry - The registry the scenario's entities are created in and registered with.
+* @brief: Build the <SimulationEntities> of the document loaded by parse_settings. Const and reentrant, so
+* several simulations (e.g. batch replicas on their own threads) can share one parsed scenario.
+*/
+bool SCF::create_entities(EntityRegistry& registry) const {
     // ENTITY PARSING LOGIC
     // Get SimulationEntities wrapper node first
-    XMLParser::XMLNode entities_wrapper = root.get_child("SimulationEntities");
+    XMLParser::XMLNode entities_wrapper = parser.get_root().get_child("SimulationEntities");
     if (!entities_wrapper.is_valid()) {
-        std::cerr << "[WARNING] No SimulationEntities wrapper found in scenario file." << std::endl;
+        MSF_LOG_WARNING("No SimulationEntities wrapper found in scenario file.");
         return false;
     }
 
@@ -50,7 +93,7 @@ bool SCF::parse_scf(EntityRegistry& registry, msf::SimDt& timestep) {
     
     // Make sure there are simulation entities found
     if (entity_nodes.empty()) {
-        std::cerr << "[WARNING] No SimulationEntity elements found in SimulationEntities." << std::endl;
+        MSF_LOG_WARNING("No SimulationEntity elements found in SimulationEntities.");
         return false; 
     }
     
@@ -62,10 +105,204 @@ bool SCF::parse_scf(EntityRegistry& registry, msf::SimDt& timestep) {
     return true;
 }
 
+/*
+* @func parse_parallel_tick
+* @param:
+*  parallel_tick_node - The optional <ParallelTick threads="n|auto" grain="n"/> element of <SimulationSetup>.
+* @brief: Read the entity update thread count and chunk size. Invalid values keep the serial defaults.
+*/
+void SCF::parse_parallel_tick(const XMLParser::XMLNode& parallel_tick_node) {
+    if (!parallel_tick_node.is_valid()) {
+        return;
+    }
+
+    auto threads_attr = parallel_tick_node.get_attribute("threads");
+    if (threads_attr) {
+        if (threads_attr.value() == "auto") {
+            setup_options.tick_threads = std::max(1u, std::thread::hardware_concurrency());
+        } else {
+            try {
+                const long threads = std::stol(threads_attr.value());
+                setup_options.tick_threads = threads > 0 ? static_cast<std::size_t>(threads) : 1;
+            } catch (const std::exception& e) {
+                MSF_LOG_WARNING("Invalid ParallelTick threads value '{}'. Using serial updates.", threads_attr.value());
+                setup_options.tick_threads = 1;
+            }
+        }
+    }
+
+    auto grain_attr = parallel_tick_node.get_attribute("grain");
+    if (grain_attr) {
+        try {
+            const long grain = std::stol(grain_attr.value());
+            setup_options.tick_grain = grain > 0 ? static_cast<std::size_t>(grain) : 0;
+        } catch (const std::exception& e) {
+            MSF_LOG_WARNING("Invalid ParallelTick grain value '{}'. Using automatic grain.", grain_attr.value());
+            setup_options.tick_grain = 0;
+        }
+    }
+}
+
+/*
+* @func parse_event_scheduler
+* @param:
+*  event_scheduler_node - The optional <EventScheduler backend="heap|wheel"/> element of <SimulationSetup>.
+* @brief: Select the pending event storage. Unknown backends keep the binary heap.
+*/
+void SCF::parse_event_scheduler(const XMLParser::XMLNode& event_scheduler_node) {
+    if (!event_scheduler_node.is_valid()) {
+        return;
+    }
+
+    auto backend_attr = event_scheduler_node.get_attribute("backend");
+    if (!backend_attr) {
+        return;
+    }
+
+    if (backend_attr.value() == "heap" || backend_attr.value() == "wheel") {
+        setup_options.scheduler_backend = backend_attr.value();
+    } else {
+        MSF_LOG_WARNING("Unknown EventScheduler backend '{}'. Using heap.", backend_attr.value());
+    }
+}
+
+/*
+* @func parse_real_time
+* @param:
+*  real_time_node - The optional <RealTime scale="x"/> element of <SimulationSetup>.
+* @brief: Read the real-time pacing factor (sim seconds per wall second). Values outside
+* [0.1, 100] are ignored and the run stays unpaced.
+*/
+void SCF::parse_real_time(const XMLParser::XMLNode& real_time_node) {
+    if (!real_time_node.is_valid()) {
+        return;
+    }
+
+    auto scale_attr = real_time_node.get_attribute("scale");
+    double scale = 1.0;
+    if (scale_attr) {
+        try {
+            scale = std::stod(scale_attr.value());
+        } catch (const std::exception&) {
+            scale = -1.0;
+        }
+    }
+
+    if (scale >= RealTimePacer::kMinTimeScale && scale <= RealTimePacer::kMaxTimeScale) {
+        setup_options.time_scale = scale;
+    } else {
+        MSF_LOG_WARNING("Invalid RealTime scale '{}' (expected 0.1 to 100). Running as fast as possible.",
+                        scale_attr.value_or(""));
+    }
+}
+
+/*
+* @func parse_tick_deadline
+* @param:
+*  tick_deadline_node - The optional <TickDeadline ms="x"/> element of <SimulationSetup>.
+* @brief: Read the tick overrun watchdog threshold in wall milliseconds (0 turns it off). Without
+* it, paced runs use the wall period of one tick and unpaced runs have no watchdog.
+*/
+void SCF::parse_tick_deadline(const XMLParser::XMLNode& tick_deadline_node) {
+    if (!tick_deadline_node.is_valid()) {
+        return;
+    }
+
+    auto ms_attr = tick_deadline_node.get_attribute("ms");
+    if (!ms_attr) {
+        return;
+    }
+
+    try {
+        const double deadline_ms = std::stod(ms_attr.value());
+        if (deadline_ms >= 0.0) {
+            setup_options.tick_deadline_ms = deadline_ms;
+            return;
+        }
+    } catch (const std::exception&) {
+    }
+    MSF_LOG_WARNING("Invalid TickDeadline ms value '{}'. Ignoring it.", ms_attr.value());
+}
+
+/*
+* @func parse_checkpoint
+* @param:
+*  checkpoint_node - The optional <Checkpoint file="run.ckpt" interval="seconds"/> element of <Output>.
+* @brief: Write a full-state checkpoint to file every interval seconds of sim time (see Checkpoint.hpp).
+*/
+void SCF::parse_checkpoint(const XMLParser::XMLNode& checkpoint_node) {
+    if (!checkpoint_node.is_valid()) {
+        return;
+    }
+
+    auto file_attr = checkpoint_node.get_attribute("file");
+    if (!file_attr || file_attr.value().empty()) {
+        MSF_LOG_WARNING("Checkpoint output is missing a 'file' attribute. Checkpoints will not be written.");
+        return;
+    }
+    output_options.checkpoint_file = file_attr.value();
+
+    auto interval_attr = checkpoint_node.get_attribute("interval");
+    if (interval_attr) {
+        try {
+            const double interval = std::stod(interval_attr.value());
+            if (interval > 0.0) {
+                output_options.checkpoint_interval = interval;
+                return;
+            }
+        } catch (const std::exception&) {
+        }
+        MSF_LOG_WARNING("Invalid Checkpoint interval '{}'. Using {} s.", interval_attr.value(),
+                        output_options.checkpoint_interval);
+    }
+}
+
+/*
+* @func parse_output
+* @param:
+*  output_node - The optional <Output> element of the scenario root.
+* @brief: Read the recording settings. <Trajectory file="run.msft" rate="100"/> enables the trajectory
+* recorder; rate is samples per simulated second and defaults to 100 Hz.
+*/
+void SCF::parse_output(const XMLParser::XMLNode& output_node) {
+    if (!output_node.is_valid()) {
+        return;
+    }
+
+    parse_checkpoint(output_node.get_child("Checkpoint"));
+
+    auto trajectory_node = output_node.get_child("Trajectory");
+    if (!trajectory_node.is_valid()) {
+        return;
+    }
+
+    auto file_attr = trajectory_node.get_attribute("file");
+    if (!file_attr || file_attr.value().empty()) {
+        MSF_LOG_WARNING("Trajectory output is missing a 'file' attribute. Trajectories will not be recorded.");
+        return;
+    }
+    output_options.trajectory_enabled = true;
+    output_options.trajectory_file = file_attr.value();
+
+    auto rate_attr = trajectory_node.get_attribute("rate");
+    if (rate_attr) {
+        try {
+            const double rate = std::stod(rate_attr.value());
+            if (rate > 0.0) {
+                output_options.trajectory_rate_hz = rate;
+            } else {
+                MSF_LOG_WARNING("Trajectory rate must be positive (got '{}'). Using {} Hz.", rate_attr.value(), output_options.trajectory_rate_hz);
+            }
+        } catch (const std::exception& e) {
+            MSF_LOG_WARNING("Invalid Trajectory rate value '{}'. Using {} Hz.", rate_attr.value(), output_options.trajectory_rate_hz);
+        }
+    }
+}
+
 bool SCF::load_scf(const std::string& filepath) {
     scf_filepath = filepath;
     if (!parser.load_file(filepath)) {
-        std::cerr << "[ERROR] Failed to load SCF file: " << filepath << ". Error: " << parser.get_error() << std::endl;
+        MSF_LOG_ERROR("Failed to load SCF file: {}. Error: {}", filepath, parser.get_error());
         return false;
     } else {
         return true;
@@ -81,16 +318,16 @@ bool SCF::load_scf(const std::string& filepath) {
 * @brief: Parse and create entities from SCF 
 This function takes an XML node corresponding to a SimulationEntity, extracts the relevant information such as model class, emplacement data (position and orientation), entity parameters, and event triggers. It then uses this information to create an instance of the appropriate Entity subclass using the EntityRegistry's factory functions, sets its properties, and registers it with the EntityRegistry.
 */
-void SCF::parse_entity(EntityRegistry& registry, const XMLParser::XMLNode& entity_node) {
+void SCF::parse_entity(EntityRegistry& registry, const XMLParser::XMLNode& entity_node) const {
     if (!entity_node.is_valid()) {
-        std::cerr << "[WARNING] entity_node is invalid." << std::endl;
+        MSF_LOG_WARNING("entity_node is invalid.");
         return;
     }
     
     // Get entity name attribute
     auto name_attr = entity_node.get_attribute("name");
     if (!name_attr) {
-        std::cerr << "[WARNING] Entity missing 'name' attribute." << std::endl;
+        MSF_LOG_WARNING("Entity missing 'name' attribute.");
         return;
     }
     
@@ -99,7 +336,7 @@ void SCF::parse_entity(EntityRegistry& registry, const XMLParser::XMLNode& entit
     if (model_class.is_valid()) {
         auto class_text = model_class.get_text();
         if (class_text) {
-            std::cout << "[INFO] Model Class: " << class_text.value() << std::endl;
+            MSF_LOG_INFO("Model Class: {}", class_text.value());
             
             // Convert to lowercase just incase (e.g., "Missile" vs "missile")
             std::string class_str_lower = class_text.value();
@@ -109,72 +346,290 @@ void SCF::parse_entity(EntityRegistry& registry, const XMLParser::XMLNode& entit
             auto entity = registry.create_entity_from_string(class_str_lower);
             if (entity) {
                 entity->set_name(name_attr.value());
-                auto emplacement_data = entity_node.get_child("EmplacementData");
-
-                // Position Parsing (Vec3)
-                auto position_node = emplacement_data.get_child("position");
-                if (position_node.is_valid()) {
-                    try {
-                    double x = std::stod(position_node.get_attribute("x").value());
-                    double y = std::stod(position_node.get_attribute("y").value());
-                    double z = std::stod(position_node.get_attribute("z").value());
-                    
-                    entity->set_position(Vec3(x, y, z));
-
-                    } catch (const std::exception& e) {
-                        std::cerr << "[WARNING] Missing x/y/z attributes in position for entity '" << name_attr.value() << "'." << std::endl;
-                    }
-                }
-
-                // Orientation Parsing (Quat)
-                auto orientation_node = emplacement_data.get_child("orientation");
-                if (orientation_node.is_valid()) {
-                    try {
-                        double w = std::stod(orientation_node.get_attribute("w").value());
-                        double x = std::stod(orientation_node.get_attribute("x").value());
-                        double y = std::stod(orientation_node.get_attribute("y").value());
-                        double z = std::stod(orientation_node.get_attribute("z").value());
-
-                        entity->set_orientation(Quat(w, x, y, z));
-                    } catch (const std::exception& e) {
-                        std::cerr << "[WARNING] Missing w/x/y/z attributes in orientation for entity '" << name_attr.value() << "'." << std::endl;
-                    }
-                }
-
-                // TODO:Parse EntityParameters: This is more in depth as each entity may have different parameters. We can either do a generic key-value pair parsing and store it in the entity for later use by the entity's update function, or we can try to parse specific parameters based on the model class. The former is more flexible but requires more work to implement in the entity classes, while the latter is less flexible but easier to implement.
-
-                // It might be possible to register "namelists" as parameters and then override specific parameters in a given namelist.
-
-                auto event_triggers_node = entity_node.get_child("EventTriggers");
-                if (event_triggers_node.is_valid()) {
-                    auto trigger_nodes = event_triggers_node.get_children("trigger");
-                    for (const auto& trigger_node : trigger_nodes) {
-                        try {
-                            double time = std::stod(trigger_node.get_attribute("time").value());
-                            std::string type = trigger_node.get_attribute("type").value();
-                            double delay = std::stod(trigger_node.get_attribute("delay").value());
-
-                            // TODO: Right now this only schedules a generic event with a name. But it should use the same factory paradigm to create predefined event types with specific callbacks that entities can then request when parsing the SCF.
-
-                            entity->request_event(EventRequest{
-                                .entity_id = entity->get_id(),
-                                .event_time = time,
-                                .event_description = type,
-                                .callback = [type, name = entity->get_name()]() {
-                                    std::cout << "[EVENT] Triggered event '" << type << "' for entity '" << name << "'." << std::endl;
-                                }
-                            });
-                            
-                        } catch (const std::exception& e) {
-                            std::cerr << "[WARNING] Failed to parse event trigger for entity '" << name_attr.value() << "'." << std::endl;
-                        }
-                    }
-                }
+                parse_model_type(*entity, entity_node.get_child("ModelType"));
+                parse_emplacement(*entity, entity_node.get_child("EmplacementData"));
+                parse_entity_parameters(*entity, entity_node.get_child("EntityParameters"));
+                parse_event_triggers(*entity, entity_node.get_child("EventTriggers"));
 
                 registry.register_entity(std::move(entity));
             } else {
-                std::cerr << "[ERROR] Failed to create entity of class: " << class_str_lower << std::endl;
+                MSF_LOG_ERROR("Failed to create entity of class: {}", class_str_lower);
+            }
+        }
+    }
+}
+
+/*
+* @func parse_emplacement
+* @param:
+*  entity - The entity being created (or overridden by a branch).
+*  emplacement_node - The optional <EmplacementData> element with <position x y z/> and <orientation w x y z/>.
+* @brief: Set the entity's position and orientation. Either child may be left out.
+*/
+void SCF::parse_emplacement(Entity& entity, const XMLParser::XMLNode& emplacement_node) const {
+    if (!emplacement_node.is_valid()) {
+        return;
+    }
+
+    // Position Parsing (Vec3)
+    auto position_node = emplacement_node.get_child("position");
+    if (position_node.is_valid()) {
+        try {
+            double x = std::stod(position_node.get_attribute("x").value());
+            double y = std::stod(position_node.get_attribute("y").value());
+            double z = std::stod(position_node.get_attribute("z").value());
+
+            entity.set_position(Vec3(x, y, z));
+
+        } catch (const std::exception& e) {
+            MSF_LOG_WARNING("Missing x/y/z attributes in position for entity '{}'.", entity.get_name());
+        }
+    }
+
+    // Orientation Parsing (Quat)
+    auto orientation_node = emplacement_node.get_child("orientation");
+    if (orientation_node.is_valid()) {
+        try {
+            double w = std::stod(orientation_node.get_attribute("w").value());
+            double x = std::stod(orientation_node.get_attribute("x").value());
+            double y = std::stod(orientation_node.get_attribute("y").value());
+            double z = std::stod(orientation_node.get_attribute("z").value());
+
+            entity.set_orientation(Quat(w, x, y, z));
+        } catch (const std::exception& e) {
+            MSF_LOG_WARNING("Missing w/x/y/z attributes in orientation for entity '{}'.", entity.get_name());
+        }
+    }
+}
+
+/*
+* @func parse_event_triggers
+* @param:
+*  entity - The entity the triggers belong to.
+*  event_triggers_node - The optional <EventTriggers> element holding <trigger time type delay/> children.
+* @brief: Request one event per trigger at its absolute time. The registry schedules them at the next safe point.
+*/
+void SCF::parse_event_triggers(Entity& entity, const XMLParser::XMLNode& event_triggers_node) const {
+    if (!event_triggers_node.is_valid()) {
+        return;
+    }
+
+    auto trigger_nodes = event_triggers_node.get_children("trigger");
+    for (const auto& trigger_node : trigger_nodes) {
+        try {
+            double time = std::stod(trigger_node.get_attribute("time").value());
+            std::string type = trigger_node.get_attribute("type").value();
+            double delay = std::stod(trigger_node.get_attribute("delay").value());
+
+            // TODO: Right now this only schedules a generic event with a name. But it should use the same factory paradigm to create predefined event types with specific callbacks that entities can then request when parsing the SCF.
+
+            const EventDescriptionId type_id = intern_event_description(type);
+            const EventTag tag = make_trigger_tag(type, entity);
+            entity.request_event(EventRequest{
+                .entity_id = entity.get_id(),
+                .event_time = time,
+                .description_id = type_id,
+                .callback = make_trigger_callback(type_id, entity, tag),
+                .tag = tag,
+            });
+
+        } catch (const std::exception& e) {
+            MSF_LOG_WARNING("Failed to parse event trigger for entity '{}'.", entity.get_name());
+        }
+    }
+}
+
+/*
+* @func parse_branches
+* @param:
+*  branches_node - The optional <Branches at="seconds"> element of the scenario root.
+* @brief: Read the branch plan: the run is simulated once up to "at", then every <Branch name="..."> child
+* continues from that shared state with its own <Override entity="name"> elements applied (see apply_branch).
+* Branches without a name, duplicate names and a missing or negative "at" are rejected.
+*/
+void SCF::parse_branches(const XMLParser::XMLNode& branches_node) {
+    if (!branches_node.is_valid()) {
+        return;
+    }
+
+    auto at_attr = branches_node.get_attribute("at");
+    double at = -1.0;
+    if (at_attr) {
+        try {
+            at = std::stod(at_attr.value());
+        } catch (const std::exception&) {
+            at = -1.0;
+        }
+    }
+    if (at < 0.0) {
+        MSF_LOG_WARNING("Branches need an 'at' time >= 0 (got '{}'). Running without branches.", at_attr.value_or(""));
+        return;
+    }
+
+    std::vector<Branch> branches;
+    for (const auto& branch_node : branches_node.get_children("Branch")) {
+        auto name_attr = branch_node.get_attribute("name");
+        if (!name_attr || name_attr.value().empty()) {
+            MSF_LOG_WARNING("Branch is missing a 'name' attribute. Skipping it.");
+            continue;
+        }
+        const bool duplicate = std::any_of(branches.begin(), branches.end(), [&name_attr](const Branch& branch) {
+            return branch.name == name_attr.value();
+        });
+        if (duplicate) {
+            MSF_LOG_WARNING("Duplicate branch name '{}'. Skipping it.", name_attr.value());
+            continue;
+        }
+        branches.push_back(Branch{name_attr.value(), branch_node.get_children("Override")});
+    }
+
+    if (branches.empty()) {
+        MSF_LOG_WARNING("Branches at {} s has no <Branch> elements. Running without branches.", at);
+        return;
+    }
+    branch_plan.time = at;
+    branch_plan.branches = std::move(branches);
+}
+
+/*
+* @func apply_branch
+* @param:
+*  registry - The world at the branch point, restored from the shared prefix.
+*  branch - One branch of the plan.
+* @brief: Apply the branch's overrides. Each <Override entity="name"> may hold the same <ModelType>,
+* <EmplacementData>, <EntityParameters> and <EventTriggers> elements as a <SimulationEntity>; they replace
+* the named entity's values at the branch point and add triggers (at absolute times, normally after it).
+* Returns false if an override names an entity that does not exist.
+*/
+bool SCF::apply_branch(EntityRegistry& registry, const Branch& branch) const {
+    bool ok = true;
+    for (const auto& override_node : branch.overrides) {
+        auto entity_attr = override_node.get_attribute("entity");
+        std::shared_ptr<Entity> entity = entity_attr ? registry.get_entity_by_name(entity_attr.value()) : nullptr;
+        if (!entity) {
+            MSF_LOG_WARNING("Branch '{}' overrides unknown entity '{}'.", branch.name, entity_attr.value_or(""));
+            ok = false;
+            continue;
+        }
+        parse_model_type(*entity, override_node.get_child("ModelType"));
+        parse_emplacement(*entity, override_node.get_child("EmplacementData"));
+        parse_entity_parameters(*entity, override_node.get_child("EntityParameters"));
+        parse_event_triggers(*entity, override_node.get_child("EventTriggers"));
+    }
+    return ok;
+}
+
+/*
+* @func make_trigger_tag
+* @param:
+*  type - The trigger's type attribute (LAUNCH, WAKE, SLEEP or any other name).
+*  entity - The entity the trigger belongs to.
+* @brief: Serializable form of a trigger event. LAUNCH/WAKE and SLEEP triggers carry the activity state
+* they set; other types only log.
+*/
+EventTag SCF::make_trigger_tag(const std::string& type, const Entity& entity) {
+    EventTag tag;
+    tag.kind = EventKind::Trigger;
+    tag.entity_id = entity.get_id();
+    if (type == "LAUNCH" || type == "WAKE") {
+        tag.argument = static_cast<uint8_t>(ActivityState::Active);
+    } else if (type == "SLEEP") {
+        tag.argument = static_cast<uint8_t>(ActivityState::Sleeping);
+    }
+    return tag;
+}
+
+/*
+* @func make_trigger_callback
+* @param:
+*  type_id - Interned trigger type.
+*  entity - The entity the trigger belongs to.
+*  tag - The trigger's tag from make_trigger_tag.
+* @brief: Callback of a trigger event. Also rebuilds the callbacks of triggers restored from a checkpoint.
+*/
+EventCallback SCF::make_trigger_callback(EventDescriptionId type_id, Entity& entity, const EventTag& tag) {
+    // The callback captures the entity instead of copying its name, so it fits the scheduler's inline
+    // callback storage; the name is read when the trigger fires. The raw pointer is safe: an entity's
+    // events are cancelled when it is removed. LAUNCH/WAKE and SLEEP triggers also change the entity's
+    // activity when they fire.
+    Entity* target = &entity;
+    const bool sets_activity = tag.argument != EventTag::kNoArgument;
+    const auto target_state = static_cast<ActivityState>(tag.argument);
+    return [type_id, target, sets_activity, target_state]() {
+        MSF_LOG(msf::LogLevel::Info, "EVENT", "Triggered event '{}' for entity '{}'.",
+                event_description_name(type_id), target->get_name());
+        if (sets_activity) {
+            target->set_activity(target_state);
+        }
+    };
+}
+
+/*
+* @func parse_model_type
+* @param:
+*  entity - The entity being created from the <SimulationEntity> element.
+*  model_type_node - The optional <ModelType> element of that <SimulationEntity>.
+* @brief: Set the entity's activity state. "static" entities are never updated, "sleeping" ones wait
+* for a LAUNCH/WAKE trigger, "dynamic" (the default) ones are updated every tick.
+*/
+void SCF::parse_model_type(Entity& entity, const XMLParser::XMLNode& model_type_node) const {
+    if (!model_type_node.is_valid()) {
+        return;
+    }
+    auto type_text = model_type_node.get_text();
+    if (!type_text) {
+        return;
+    }
+
+    std::string type = type_text.value();
+    std::transform(type.begin(), type.end(), type.begin(), [](unsigned char c){ return std::tolower(c); });
+    if (type == "static") {
+        entity.set_activity(ActivityState::Static);
+    } else if (type == "sleeping") {
+        entity.set_activity(ActivityState::Sleeping);
+    } else if (type == "dynamic") {
+        entity.set_activity(ActivityState::Active);
+    } else {
+        MSF_LOG_WARNING("Unknown ModelType '{}' for entity '{}'. Treating it as dynamic.", type_text.value(),
+                        entity.get_name());
+    }
+}
+
+/*
+* @func parse_entity_parameters
+* @param:
+*  entity - The entity being created from the <SimulationEntity> element.
+*  parameters_node - The optional <EntityParameters> element of that <SimulationEntity>.
+* @brief: Apply the parameters the framework itself understands. For now that is
+* <parameter name="update_rate" value="hz" unit="Hz"/>, the entity's update rate group; model-specific
+* parameters are left for the models.
+*/
+void SCF::parse_entity_parameters(Entity& entity, const XMLParser::XMLNode& parameters_node) const {
+    // TODO: Model-specific parameters (e.g. speed) are not parsed yet. Either hand them to the model as
+    // generic key-value pairs or register "namelists" of defaults that a scenario overrides.
+    if (!parameters_node.is_valid()) {
+        return;
+    }
+    for (const auto& parameter_node : parameters_node.get_children("parameter")) {
+        auto name_attr = parameter_node.get_attribute("name");
+        if (!name_attr || name_attr.value() != "update_rate") {
+            continue;
+        }
+        auto unit_attr = parameter_node.get_attribute("unit");
+        if (unit_attr && unit_attr.value() != "Hz") {
+            MSF_LOG_WARNING("update_rate for entity '{}' must be in Hz (got '{}'). Ignoring it.", entity.get_name(),
+                            unit_attr.value());
+            continue;
+        }
+        try {
+            const double rate = std::stod(parameter_node.get_attribute("value").value());
+            if (rate > 0.0) {
+                entity.set_update_rate(rate);
+            } else {
+                MSF_LOG_WARNING("update_rate for entity '{}' must be positive. Updating every tick.", entity.get_name());
             }
+        } catch (const std::exception& e) {
+            MSF_LOG_WARNING("Invalid update_rate for entity '{}'. Updating every tick.", entity.get_name());
         }
     }
-}
\ No newline at end of file
+}
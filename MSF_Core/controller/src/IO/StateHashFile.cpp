@@ -0,0 +1,171 @@
+#include "StateHashFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace state_hash_format {
+
+uint64_t hash_bytes(const void* data, std::size_t size, uint64_t hash) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    std::size_t offset = 0;
+    for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + offset, sizeof(word));
+        hash = mix(hash, word);
+    }
+    if (offset < size) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + offset, size - offset);
+        hash = mix(hash, word);
+    }
+    return mix(hash, size);
+}
+
+} // namespace state_hash_format
+
+bool StateHashReader::open(const std::string& path) {
+    error_.clear();
+    in_.close();
+    in_.clear();
+    in_.open(path, std::ios::binary);
+    if (!in_) {
+        return fail("Cannot open " + path);
+    }
+
+    char magic[8];
+    uint32_t version = 0;
+    in_.read(magic, sizeof(magic));
+    in_.read(reinterpret_cast<char*>(&version), sizeof(version));
+    in_.read(reinterpret_cast<char*>(&interval_ticks_), sizeof(interval_ticks_));
+    in_.read(reinterpret_cast<char*>(&dt_), sizeof(dt_));
+    if (!in_) {
+        return fail("File is too short for a state hash header");
+    }
+    if (!std::equal(std::begin(magic), std::end(magic), std::begin(state_hash_format::kMagic))) {
+        return fail("Not an MSF state hash file");
+    }
+    if (version != state_hash_format::kVersion) {
+        return fail("Unsupported state hash file version " + std::to_string(version));
+    }
+    return true;
+}
+
+bool StateHashReader::next_sample(Sample& sample) {
+    if (!in_.read(reinterpret_cast<char*>(&sample.tick), sizeof(sample.tick))) {
+        return false; // Clean end of file
+    }
+    uint32_t entity_count = 0;
+    in_.read(reinterpret_cast<char*>(&sample.time), sizeof(sample.time));
+    in_.read(reinterpret_cast<char*>(&sample.events_fired), sizeof(sample.events_fired));
+    in_.read(reinterpret_cast<char*>(&sample.event_hash), sizeof(sample.event_hash));
+    in_.read(reinterpret_cast<char*>(&sample.world_hash), sizeof(sample.world_hash));
+    in_.read(reinterpret_cast<char*>(&entity_count), sizeof(entity_count));
+    sample.entities.resize(entity_count);
+    for (auto& entity : sample.entities) {
+        in_.read(reinterpret_cast<char*>(&entity.first), sizeof(entity.first));
+        in_.read(reinterpret_cast<char*>(&entity.second), sizeof(entity.second));
+    }
+    if (!in_) {
+        return fail("Truncated sample");
+    }
+    return true;
+}
+
+namespace {
+
+// The first entity whose hash differs or that only one sample has, walking both lists in ID order
+bool find_entity_difference(const StateHashReader::Sample& a, const StateHashReader::Sample& b,
+                            StateHashDivergence& divergence) {
+    auto it_a = a.entities.begin();
+    auto it_b = b.entities.begin();
+    while (it_a != a.entities.end() || it_b != b.entities.end()) {
+        if (it_b == b.entities.end() || (it_a != a.entities.end() && it_a->first < it_b->first)) {
+            divergence.entity_id = it_a->first;
+            divergence.reason = "entity " + std::to_string(it_a->first) + " only exists in run A";
+            return true;
+        }
+        if (it_a == a.entities.end() || it_b->first < it_a->first) {
+            divergence.entity_id = it_b->first;
+            divergence.reason = "entity " + std::to_string(it_b->first) + " only exists in run B";
+            return true;
+        }
+        if (it_a->second != it_b->second) {
+            divergence.entity_id = it_a->first;
+            divergence.reason = "state of entity " + std::to_string(it_a->first) + " differs";
+            return true;
+        }
+        ++it_a;
+        ++it_b;
+    }
+    return false;
+}
+
+void diverge_at(const StateHashReader::Sample& sample, StateHashDivergence& divergence) {
+    divergence.diverged = true;
+    divergence.tick = sample.tick;
+    divergence.time = sample.time;
+}
+
+} // namespace
+
+bool compare_state_hashes(const std::string& path_a, const std::string& path_b, StateHashDivergence& divergence,
+                          std::string& error) {
+    divergence = StateHashDivergence{};
+    StateHashReader a;
+    StateHashReader b;
+    if (!a.open(path_a) || !b.open(path_b)) {
+        error = a.get_error().empty() ? path_b + ": " + b.get_error() : path_a + ": " + a.get_error();
+        return false;
+    }
+    if (a.get_interval_ticks() != b.get_interval_ticks() || a.get_dt() != b.get_dt()) {
+        error = "The files were sampled at different tick intervals or timesteps";
+        return false;
+    }
+
+    StateHashReader::Sample sample_a;
+    StateHashReader::Sample sample_b;
+    bool has_a = a.next_sample(sample_a);
+    bool has_b = b.next_sample(sample_b);
+    while (has_a && has_b && sample_a.tick < sample_b.tick) {
+        has_a = a.next_sample(sample_a);
+    }
+    while (has_a && has_b && sample_b.tick < sample_a.tick) {
+        has_b = b.next_sample(sample_b);
+    }
+
+    bool first = true;
+    while (has_a && has_b) {
+        if (sample_a.tick != sample_b.tick) {
+            diverge_at(sample_a.tick < sample_b.tick ? sample_a : sample_b, divergence);
+            divergence.reason = "only run " + std::string(sample_a.tick < sample_b.tick ? "A" : "B") +
+                                " has a sample at this tick";
+            return true;
+        }
+        const bool events_differ = !first && (sample_a.events_fired != sample_b.events_fired ||
+                                              sample_a.event_hash != sample_b.event_hash);
+        if (sample_a.world_hash != sample_b.world_hash || events_differ) {
+            diverge_at(sample_a, divergence);
+            if (!find_entity_difference(sample_a, sample_b, divergence)) {
+                divergence.reason = "events differ (" + std::to_string(sample_a.events_fired) + " vs " +
+                                    std::to_string(sample_b.events_fired) + " fired since the previous sample)";
+            } else if (events_differ) {
+                divergence.reason += "; events differ too";
+            }
+            return true;
+        }
+        first = false;
+        has_a = a.next_sample(sample_a);
+        has_b = b.next_sample(sample_b);
+    }
+
+    if (!a.get_error().empty() || !b.get_error().empty()) {
+        error = a.get_error().empty() ? path_b + ": " + b.get_error() : path_a + ": " + a.get_error();
+        return false;
+    }
+    if (has_a != has_b) {
+        diverge_at(has_a ? sample_a : sample_b, divergence);
+        divergence.reason = "run " + std::string(has_a ? "B" : "A") + " ends before this tick";
+    }
+    return true;
+}
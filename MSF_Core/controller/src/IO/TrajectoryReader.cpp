@@ -0,0 +1,87 @@
+#include "TrajectoryReader.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+bool TrajectoryReader::open(const std::string& path) {
+    names_.clear();
+    error_.clear();
+    file_.close();
+    file_.clear();
+    file_.open(path, std::ios::binary);
+    if (!file_) {
+        return fail("Cannot open " + path);
+    }
+
+    trajectory_format::FileHeader header{};
+    if (!file_.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return fail("File is too short for a trajectory header");
+    }
+    if (!std::equal(std::begin(header.magic), std::end(header.magic), std::begin(trajectory_format::kMagic))) {
+        return fail("Not an MSF trajectory file");
+    }
+    if (header.version != trajectory_format::kVersion) {
+        return fail("Unsupported trajectory file version " + std::to_string(header.version));
+    }
+    if (header.column_count < trajectory_format::kColumnCount) {
+        return fail("Trajectory file has too few columns");
+    }
+
+    output_interval_ = header.output_interval;
+    column_count_ = header.column_count;
+    return true;
+}
+
+bool TrajectoryReader::next_frame(Frame& frame) {
+    using namespace trajectory_format;
+
+    BlockHeader block{};
+    while (file_.read(reinterpret_cast<char*>(&block), sizeof(block))) {
+        if (block.tag == kEntityTableTag) {
+            for (uint32_t i = 0; i < block.entity_count; ++i) {
+                int32_t id = 0;
+                uint16_t name_length = 0;
+                file_.read(reinterpret_cast<char*>(&id), sizeof(id));
+                file_.read(reinterpret_cast<char*>(&name_length), sizeof(name_length));
+                std::string name(name_length, '\0');
+                file_.read(name.data(), name_length);
+                names_[id] = std::move(name);
+            }
+            if (!file_) {
+                return fail("Truncated entity table");
+            }
+            continue;
+        }
+
+        if (block.tag != kFrameTag) {
+            file_.seekg(static_cast<std::streamoff>(block.payload_bytes), std::ios::cur); // Unknown block
+            continue;
+        }
+
+        const uint64_t expected = sizeof(double) + block.entity_count * (sizeof(int32_t) + column_count_ * sizeof(double));
+        if (block.payload_bytes != expected) {
+            return fail("Frame block has an unexpected size");
+        }
+        frame.ids.resize(block.entity_count);
+        frame.columns.resize(static_cast<std::size_t>(block.entity_count) * column_count_);
+        file_.read(reinterpret_cast<char*>(&frame.time), sizeof(frame.time));
+        file_.read(reinterpret_cast<char*>(frame.ids.data()), frame.ids.size() * sizeof(int32_t));
+        file_.read(reinterpret_cast<char*>(frame.columns.data()), frame.columns.size() * sizeof(double));
+        if (!file_) {
+            return fail("Truncated frame");
+        }
+        return true;
+    }
+    return false; // Clean end of file
+}
+
+const std::string& TrajectoryReader::entity_name(int32_t id) const {
+    static const std::string unknown;
+    auto it = names_.find(id);
+    return it != names_.end() ? it->second : unknown;
+}
+
+bool TrajectoryReader::fail(const std::string& message) {
+    error_ = message;
+    return false;
+}
@@ -0,0 +1,264 @@
+#include "TrajectoryRecorder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+
+#include "Logger.hpp"
+
+namespace {
+
+// Frames queued for the writer before the simulation thread has to wait for disk
+constexpr std::size_t kMaxFramesInFlight = 8;
+// stdio buffer for the trajectory file; large frames then go out in few write() calls
+constexpr std::size_t kFileBufferBytes = 1 << 20;
+
+} // namespace
+
+TrajectoryRecorder::~TrajectoryRecorder() {
+    close();
+}
+
+bool TrajectoryRecorder::open(const std::string& path, double rate_hz) {
+    close();
+    if (!(rate_hz > 0.0)) {
+        MSF_LOG_ERROR("Trajectory output rate must be positive (got {} Hz).", rate_hz);
+        return false;
+    }
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (file_ == nullptr) {
+        MSF_LOG_ERROR("Failed to open trajectory file: {}", path);
+        return false;
+    }
+    std::setvbuf(file_, nullptr, _IOFBF, kFileBufferBytes);
+
+    path_ = path;
+    output_interval_ = 1.0 / rate_hz;
+    next_sample_index_ = 0;
+    frames_recorded_ = 0;
+    entity_list_revision_ = UINT64_MAX;
+    write_failed_ = false;
+    stopping_ = false;
+
+    trajectory_format::FileHeader header{};
+    std::copy(std::begin(trajectory_format::kMagic), std::end(trajectory_format::kMagic), header.magic);
+    header.version = trajectory_format::kVersion;
+    header.column_count = trajectory_format::kColumnCount;
+    header.output_interval = output_interval_;
+    write_bytes(&header, sizeof(header));
+
+    writer_ = std::thread([this]() { run_writer(); });
+    MSF_LOG_INFO("Recording trajectories to {} at {} Hz", path_, rate_hz);
+    return true;
+}
+
+void TrajectoryRecorder::record(const EntityRegistry& registry, double t) {
+    if (begin_sample(registry, t) == nullptr) {
+        return;
+    }
+    for (std::size_t slot = 0; slot < entities_.size(); ++slot) {
+        capture(slot, *entities_[slot]);
+    }
+    finish_sample();
+}
+
+TickObserver* TrajectoryRecorder::begin_sample(const EntityRegistry& registry, double t) {
+    if (sampling_frame_ || t < next_sample_time()) {
+        return nullptr;
+    }
+
+    const bool membership_changed = entity_list_revision_ != registry.get_revision();
+    if (membership_changed) {
+        registry.collect_entities(entities_);
+        physics_.resize(entities_.size());
+        for (std::size_t i = 0; i < entities_.size(); ++i) {
+            physics_[i] = dynamic_cast<const PhysicsEntity*>(entities_[i]);
+        }
+        entity_list_revision_ = registry.get_revision();
+    }
+
+    sampling_frame_ = acquire_frame();
+    const std::size_t count = entities_.size();
+    sampling_frame_->time = t;
+    sampling_frame_->ids.resize(count);
+    sampling_frame_->rows.resize(count * trajectory_format::kColumnCount);
+    sampling_frame_->entity_table.clear();
+    if (membership_changed) {
+        sampling_frame_->entity_table.reserve(count);
+        for (const Entity* entity : entities_) {
+            sampling_frame_->entity_table.emplace_back(entity->get_id(), entity->get_name());
+        }
+    }
+
+    // If dt is longer than the output interval, skip the output times that fall inside this tick
+    const double tolerance = 1e-6 * output_interval_;
+    next_sample_index_ = static_cast<uint64_t>(std::floor((t + tolerance) / output_interval_)) + 1;
+    return this;
+}
+
+void TrajectoryRecorder::on_entity_updated(std::size_t slot, const Entity& entity) {
+    capture(slot, entity);
+}
+
+void TrajectoryRecorder::finish_sample() {
+    if (!sampling_frame_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(std::move(sampling_frame_));
+    }
+    frame_ready_.notify_one();
+    ++frames_recorded_;
+}
+
+double TrajectoryRecorder::next_sample_time() const {
+    if (!is_open()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    // Small tolerance so accumulated timestep rounding doesn't push a sample one tick late
+    const double tolerance = 1e-6 * output_interval_;
+    return static_cast<double>(next_sample_index_) * output_interval_ - tolerance;
+}
+
+// Copy one entity into its row of the frame being sampled. Touches only that row, so the parallel
+// tick can call it for different entities at once.
+void TrajectoryRecorder::capture(std::size_t slot, const Entity& entity) {
+    using namespace trajectory_format;
+
+    Frame& frame = *sampling_frame_;
+    if (slot >= frame.ids.size()) {
+        return;
+    }
+
+    const Vec3 position = entity.get_position();
+    const Quat orientation = entity.get_orientation();
+    double* row = frame.rows.data() + slot * kColumnCount;
+    frame.ids[slot] = entity.get_id();
+    row[kPositionX] = position.get_x();
+    row[kPositionY] = position.get_y();
+    row[kPositionZ] = position.get_z();
+    row[kOrientationW] = orientation.get_w();
+    row[kOrientationX] = orientation.get_x();
+    row[kOrientationY] = orientation.get_y();
+    row[kOrientationZ] = orientation.get_z();
+
+    // The cached cast is only valid if the caller walks entities in collect_entities() order
+    const PhysicsEntity* physics = entities_[slot] == &entity ? physics_[slot]
+                                                             : dynamic_cast<const PhysicsEntity*>(&entity);
+    if (physics != nullptr) {
+        const Vec3 velocity = physics->get_velocity();
+        const Vec3 angular_velocity = physics->get_angular_velocity();
+        row[kVelocityX] = velocity.get_x();
+        row[kVelocityY] = velocity.get_y();
+        row[kVelocityZ] = velocity.get_z();
+        row[kAngularVelocityX] = angular_velocity.get_x();
+        row[kAngularVelocityY] = angular_velocity.get_y();
+        row[kAngularVelocityZ] = angular_velocity.get_z();
+    } else {
+        std::fill(row + kVelocityX, row + kColumnCount, std::numeric_limits<double>::quiet_NaN());
+    }
+}
+
+void TrajectoryRecorder::close() {
+    if (!is_open()) {
+        return;
+    }
+    finish_sample();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    frame_ready_.notify_one();
+    writer_.join();
+    MSF_LOG_INFO("Trajectory recorder wrote {} frames to {}", frames_recorded_, path_);
+}
+
+// Reuse a frame the writer has finished with, or allocate one while under the in-flight limit.
+std::unique_ptr<TrajectoryRecorder::Frame> TrajectoryRecorder::acquire_frame() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (free_.empty() && frames_allocated_ < kMaxFramesInFlight) {
+        ++frames_allocated_;
+        return std::make_unique<Frame>();
+    }
+    frame_free_.wait(lock, [this]() { return !free_.empty(); });
+    std::unique_ptr<Frame> frame = std::move(free_.back());
+    free_.pop_back();
+    return frame;
+}
+
+void TrajectoryRecorder::run_writer() {
+    for (;;) {
+        std::unique_ptr<Frame> frame;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            frame_ready_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) {
+                break; // Stopping and fully drained
+            }
+            frame = std::move(pending_.front());
+            pending_.pop_front();
+        }
+
+        write_frame(*frame);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.push_back(std::move(frame));
+        }
+        frame_free_.notify_one();
+    }
+
+    if (std::fclose(file_) != 0 && !write_failed_) {
+        MSF_LOG_ERROR("Failed to close trajectory file: {}", path_);
+    }
+    file_ = nullptr;
+}
+
+void TrajectoryRecorder::write_frame(const Frame& frame) {
+    using namespace trajectory_format;
+    const auto count = static_cast<uint32_t>(frame.ids.size());
+
+    if (!frame.entity_table.empty()) {
+        uint64_t payload = 0;
+        for (const auto& entry : frame.entity_table) {
+            payload += sizeof(int32_t) + sizeof(uint16_t) + std::min<std::size_t>(entry.second.size(), UINT16_MAX);
+        }
+        const BlockHeader table_header{kEntityTableTag, static_cast<uint32_t>(frame.entity_table.size()), payload};
+        write_bytes(&table_header, sizeof(table_header));
+        for (const auto& entry : frame.entity_table) {
+            const auto name_length = static_cast<uint16_t>(std::min<std::size_t>(entry.second.size(), UINT16_MAX));
+            write_bytes(&entry.first, sizeof(entry.first));
+            write_bytes(&name_length, sizeof(name_length));
+            write_bytes(entry.second.data(), name_length);
+        }
+    }
+
+    // Rows to columns, off the simulation thread
+    columns_.resize(frame.rows.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        const double* row = frame.rows.data() + i * kColumnCount;
+        for (uint32_t column = 0; column < kColumnCount; ++column) {
+            columns_[column * count + i] = row[column];
+        }
+    }
+
+    const uint64_t payload = sizeof(double) + count * sizeof(int32_t) + columns_.size() * sizeof(double);
+    const BlockHeader frame_header{kFrameTag, count, payload};
+    write_bytes(&frame_header, sizeof(frame_header));
+    write_bytes(&frame.time, sizeof(frame.time));
+    write_bytes(frame.ids.data(), count * sizeof(int32_t));
+    write_bytes(columns_.data(), columns_.size() * sizeof(double));
+}
+
+void TrajectoryRecorder::write_bytes(const void* data, std::size_t size) {
+    if (size == 0 || write_failed_) {
+        return;
+    }
+    if (std::fwrite(data, 1, size, file_) != size) {
+        write_failed_ = true;
+        MSF_LOG_ERROR("Failed to write trajectory file: {}. Further samples are discarded.", path_);
+    }
+}
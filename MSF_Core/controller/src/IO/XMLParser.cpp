@@ -1,306 +1,370 @@
 #include "IO/XMLParser.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <fstream>
-#include <sstream>
-#include <cctype>
-#include <algorithm>
-
-// XMLElement implementation
-std::shared_ptr<XMLParser::XMLElement> XMLParser::XMLElement::find_child(const std::string& child_name) const {
-    for (const auto& child : children) {
-        if (child->name == child_name) {
-            return child;
-        }
-    }
-    return nullptr;
+#include <iterator>
+
+namespace {
+
+// Same characters as std::isspace in the "C" locale
+bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
 }
 
-std::vector<std::shared_ptr<XMLParser::XMLElement>> XMLParser::XMLElement::find_children(const std::string& child_name) const {
-    std::vector<std::shared_ptr<XMLElement>> result;
-    for (const auto& child : children) {
-        if (child->name == child_name) {
-            result.push_back(child);
-        }
+bool is_name_char(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-' ||
+           c == ':';
+}
+
+// True if content continues with token at pos (pos <= content.size())
+bool at(std::string_view content, size_t pos, std::string_view token) {
+    return content.size() - pos >= token.size() && content.compare(pos, token.size(), token) == 0;
+}
+
+} // namespace
+
+XMLParser::Document::~Document() {
+    if (mapping != nullptr) {
+        ::munmap(mapping, mapping_size);
     }
-    return result;
 }
 
 // XMLNode implementation
 std::optional<std::string> XMLParser::XMLNode::get_attribute(const std::string& attr_name) const {
-    if (!element_) return std::nullopt;
-    
-    auto it = element_->attributes.find(attr_name);
-    if (it != element_->attributes.end()) {
-        return it->second;
+    if (!document_) return std::nullopt;
+
+    // Backwards, so a repeated attribute reads as its last value
+    const Node& node = document_->nodes[index_];
+    for (uint32_t i = node.first_attribute + node.attribute_count; i-- > node.first_attribute;) {
+        const Attribute& attribute = document_->attributes[i];
+        if (attribute.name == attr_name) {
+            return std::string(attribute.value);
+        }
     }
     return std::nullopt;
 }
 
 std::optional<std::string> XMLParser::XMLNode::get_text() const {
-    if (!element_) return std::nullopt;
-    
-    if (!element_->text.empty()) {
-        return element_->text;
+    if (!document_) return std::nullopt;
+
+    const Node& node = document_->nodes[index_];
+    if (!node.text.empty()) {
+        return std::string(node.text);
     }
     return std::nullopt;
 }
 
 XMLParser::XMLNode XMLParser::XMLNode::get_child(const std::string& child_name) const {
-    if (!element_) return XMLNode(nullptr);
-    
-    auto child = element_->find_child(child_name);
-    return XMLNode(child);
+    if (!document_) return XMLNode();
+
+    const std::vector<Node>& nodes = document_->nodes;
+    for (uint32_t child = nodes[index_].first_child; child != kNoNode; child = nodes[child].next_sibling) {
+        if (nodes[child].name == child_name) {
+            return XMLNode(document_, child);
+        }
+    }
+    return XMLNode();
 }
 
 std::vector<XMLParser::XMLNode> XMLParser::XMLNode::get_children(const std::string& child_name) const {
     std::vector<XMLNode> result;
-    if (!element_) return result;
-    
-    auto children = element_->find_children(child_name);
-    for (const auto& child : children) {
-        result.emplace_back(child);
+    if (!document_) return result;
+
+    const std::vector<Node>& nodes = document_->nodes;
+    for (uint32_t child = nodes[index_].first_child; child != kNoNode; child = nodes[child].next_sibling) {
+        if (nodes[child].name == child_name) {
+            result.push_back(XMLNode(document_, child));
+        }
     }
     return result;
 }
 
 std::string XMLParser::XMLNode::get_name() const {
-    if (!element_) return "";
-    return element_->name;
+    if (!document_) return "";
+    return std::string(document_->nodes[index_].name);
 }
 
 // XMLParser parsing helpers
-void XMLParser::skip_whitespace(const std::string& content, size_t& pos) {
-    while (pos < content.length() && std::isspace(content[pos])) {
+void XMLParser::skip_whitespace(std::string_view content, size_t& pos) {
+    while (pos < content.size() && is_space(content[pos])) {
         ++pos;
     }
 }
 
-void XMLParser::skip_comment(const std::string& content, size_t& pos) {
-    if (pos + 4 < content.length() && content.substr(pos, 4) == "<!--") {
-        pos += 4;
-        size_t end = content.find("-->", pos);
-        if (end != std::string::npos) {
-            pos = end + 3;
-        }
+void XMLParser::skip_comment(std::string_view content, size_t& pos) {
+    if (at(content, pos, "<!--")) {
+        const size_t end = content.find("-->", pos + 4);
+        pos = end != std::string_view::npos ? end + 3 : content.size();
     }
 }
 
-std::string XMLParser::parse_tag_name(const std::string& content, size_t& pos) {
+std::string_view XMLParser::parse_tag_name(std::string_view content, size_t& pos) {
     skip_whitespace(content, pos);
-    
-    std::string name;
-    while (pos < content.length() && (std::isalnum(content[pos]) || content[pos] == '_' || content[pos] == '-' || content[pos] == ':')) {
-        name += content[pos];
+
+    const size_t start = pos;
+    while (pos < content.size() && is_name_char(content[pos])) {
         ++pos;
     }
-    return name;
+    return content.substr(start, pos - start);
 }
 
-std::map<std::string, std::string> XMLParser::parse_attributes(const std::string& content, size_t& pos) {
-    std::map<std::string, std::string> attrs;
-    
-    while (pos < content.length() && content[pos] != '>' && content[pos] != '/') {
+bool XMLParser::parse_attributes(Document& document, uint32_t index, size_t& pos) {
+    const std::string_view content = document.content;
+    const size_t first = document.attributes.size();
+
+    while (true) {
         skip_whitespace(content, pos);
-        
+        if (pos >= content.size()) {
+            error_message_ = "Unexpected end of document in tag <" + std::string(document.nodes[index].name) + ">";
+            return false;
+        }
         if (content[pos] == '>' || content[pos] == '/') break;
-        
+
         // Parse attribute name
-        std::string attr_name;
-        while (pos < content.length() && (std::isalnum(content[pos]) || content[pos] == '_' || content[pos] == '-' || content[pos] == ':')) {
-            attr_name += content[pos];
-            ++pos;
+        const std::string_view attr_name = parse_tag_name(content, pos);
+        if (attr_name.empty()) {
+            error_message_ = "Malformed attribute at position " + std::to_string(pos);
+            return false;
         }
-        
+
         skip_whitespace(content, pos);
-        
-        // Expect '='
-        if (pos >= content.length() || content[pos] != '=') {
+
+        // An attribute without '=' has no value and is ignored
+        if (pos >= content.size() || content[pos] != '=') {
             continue;
         }
         ++pos;
-        
+
         skip_whitespace(content, pos);
-        
+
         // Parse attribute value (quoted)
-        std::string attr_value;
-        if (pos < content.length() && (content[pos] == '"' || content[pos] == '\'')) {
-            char quote = content[pos];
-            ++pos;
-            while (pos < content.length() && content[pos] != quote) {
-                attr_value += content[pos];
-                ++pos;
-            }
-            if (pos < content.length()) ++pos; // Skip closing quote
+        if (pos >= content.size() || (content[pos] != '"' && content[pos] != '\'')) {
+            error_message_ = "Expected a quoted value for attribute '" + std::string(attr_name) + "' at position " +
+                             std::to_string(pos);
+            return false;
         }
-        
-        if (!attr_name.empty()) {
-            attrs[attr_name] = attr_value;
+        const char quote = content[pos];
+        ++pos;
+        const size_t end = content.find(quote, pos);
+        if (end == std::string_view::npos) {
+            error_message_ = "Unterminated value for attribute '" + std::string(attr_name) + "'";
+            return false;
         }
+        document.attributes.push_back(Attribute{attr_name, content.substr(pos, end - pos)});
+        pos = end + 1; // Skip closing quote
     }
-    
-    return attrs;
+
+    document.nodes[index].first_attribute = static_cast<uint32_t>(first);
+    document.nodes[index].attribute_count = static_cast<uint32_t>(document.attributes.size() - first);
+    return true;
 }
 
-std::string XMLParser::parse_text_content(const std::string& content, size_t& pos) {
-    std::string text;
-    while (pos < content.length() && content[pos] != '<') {
-        text += content[pos];
-        ++pos;
+std::string_view XMLParser::parse_text_content(std::string_view content, size_t& pos) {
+    size_t end = content.find('<', pos);
+    if (end == std::string_view::npos) {
+        end = content.size();
     }
-    
+    std::string_view text = content.substr(pos, end - pos);
+    pos = end;
+
     // Trim whitespace
-    text.erase(0, text.find_first_not_of(" \t\n\r"));
-    text.erase(text.find_last_not_of(" \t\n\r") + 1);
-    
+    const size_t first = text.find_first_not_of(" \t\n\r");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    text.remove_prefix(first);
+    text.remove_suffix(text.size() - text.find_last_not_of(" \t\n\r") - 1);
     return text;
 }
 
-std::shared_ptr<XMLParser::XMLElement> XMLParser::parse_element(const std::string& content, size_t& pos) {
+uint32_t XMLParser::parse_element(Document& document, size_t& pos) {
+    const std::string_view content = document.content;
     skip_whitespace(content, pos);
-    
+
     // Skip comments
-    while (pos < content.length() && content.substr(pos, 4) == "<!--") {
+    while (at(content, pos, "<!--")) {
         skip_comment(content, pos);
         skip_whitespace(content, pos);
     }
-    
-    if (pos >= content.length() || content[pos] != '<') {
+
+    if (pos >= content.size() || content[pos] != '<') {
         error_message_ = "Expected '<' at position " + std::to_string(pos);
-        return nullptr;
+        return kNoNode;
     }
-    
+
     ++pos; // Skip '<'
-    
-    // Check for closing tag or self-closing
-    if (content[pos] == '/') {
-        // This is a closing tag, return null to signal end
-        return nullptr;
+
+    if (pos < content.size() && content[pos] == '/') {
+        error_message_ = "Unexpected closing tag at position " + std::to_string(pos - 1);
+        return kNoNode;
     }
-    
-    auto element = std::make_shared<XMLElement>();
-    
+
     // Parse tag name
-    element->name = parse_tag_name(content, pos);
-    if (element->name.empty()) {
-        error_message_ = "Empty tag name";
-        return nullptr;
+    const std::string_view name = parse_tag_name(content, pos);
+    if (name.empty()) {
+        error_message_ = "Empty tag name at position " + std::to_string(pos);
+        return kNoNode;
     }
-    
+    const uint32_t index = static_cast<uint32_t>(document.nodes.size());
+    document.nodes.emplace_back();
+    document.nodes[index].name = name;
+
     // Parse attributes
-    element->attributes = parse_attributes(content, pos);
-    
-    skip_whitespace(content, pos);
-    
+    if (!parse_attributes(document, index, pos)) {
+        return kNoNode;
+    }
+
     // Check for self-closing tag
-    if (pos < content.length() && content[pos] == '/') {
+    if (content[pos] == '/') {
         ++pos; // Skip '/'
         skip_whitespace(content, pos);
-        if (pos < content.length() && content[pos] == '>') {
-            ++pos; // Skip '>'
+        if (pos >= content.size() || content[pos] != '>') {
+            error_message_ = "Expected '>' at position " + std::to_string(pos);
+            return kNoNode;
         }
-        return element;
-    }
-    
-    // Expect '>'
-    if (pos >= content.length() || content[pos] != '>') {
-        error_message_ = "Expected '>' at position " + std::to_string(pos);
-        return nullptr;
+        ++pos; // Skip '>'
+        return index;
     }
-    ++pos;
-    
-    // Parse content until closing tag
-    while (pos < content.length()) {
+    ++pos; // Skip '>'
+
+    // Parse content until closing tag; children are appended to the node's sibling list in order
+    uint32_t last_child = kNoNode;
+    while (pos < content.size()) {
         skip_whitespace(content, pos);
-        
-        if (pos >= content.length()) break;
-        
+
+        if (pos >= content.size()) break;
+
         // Check for closing tag
-        if (content[pos] == '<' && pos + 1 < content.length() && content[pos + 1] == '/') {
-            // This is closing tag, skip it
-            ++pos; // Skip '<'
-            ++pos; // Skip '/'
-            
-            std::string closing_name = parse_tag_name(content, pos);
-            
+        if (at(content, pos, "</")) {
+            pos += 2;
+
+            const std::string_view closing_name = parse_tag_name(content, pos);
+
             skip_whitespace(content, pos);
-            if (pos < content.length() && content[pos] == '>') {
+            if (pos < content.size() && content[pos] == '>') {
                 ++pos;
             }
-            
-            if (closing_name != element->name) {
-                error_message_ = "Mismatched closing tag: expected </" + element->name + ">, got </" + closing_name + ">";
-                return nullptr;
+
+            if (closing_name != name) {
+                error_message_ = "Mismatched closing tag: expected </" + std::string(name) + ">, got </" +
+                                 std::string(closing_name) + ">";
+                return kNoNode;
             }
-            
-            return element;
+
+            return index;
         }
-        
+
         // Check for comment
-        if (content.substr(pos, 4) == "<!--") {
+        if (at(content, pos, "<!--")) {
             skip_comment(content, pos);
             continue;
         }
-        
+
         // Check for child element
         if (content[pos] == '<') {
-            auto child = parse_element(content, pos);
-            if (child) {
-                element->children.push_back(child);
+            const uint32_t child = parse_element(document, pos);
+            if (child == kNoNode) {
+                return kNoNode;
+            }
+            if (last_child == kNoNode) {
+                document.nodes[index].first_child = child;
+            } else {
+                document.nodes[last_child].next_sibling = child;
             }
+            last_child = child;
         } else {
             // Text content
-            std::string text = parse_text_content(content, pos);
+            const std::string_view text = parse_text_content(content, pos);
             if (!text.empty()) {
-                element->text = text;
+                document.nodes[index].text = text;
             }
         }
     }
-    
-    return element;
-}
 
-// XMLParser implementation
-bool XMLParser::load_file(const std::string& filepath) {
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-        error_message_ = "Failed to open file: " + filepath;
-        return false;
-    }
-    
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return load_string(buffer.str());
+    error_message_ = "Unexpected end of document: <" + std::string(name) + "> is not closed";
+    return kNoNode;
 }
 
-bool XMLParser::load_string(const std::string& xml_content) {
+bool XMLParser::parse(std::shared_ptr<Document> document) {
     size_t pos = 0;
-    
+
     // Skip XML declaration if present
-    if (xml_content.substr(pos, 5) == "<?xml") {
-        size_t decl_end = xml_content.find("?>", pos);
-        if (decl_end != std::string::npos) {
+    if (at(document->content, pos, "<?xml")) {
+        size_t decl_end = document->content.find("?>", pos);
+        if (decl_end != std::string_view::npos) {
             pos = decl_end + 2;
         }
     }
-    
-    root_ = parse_element(xml_content, pos);
-    
-    if (!root_) {
+
+    if (parse_element(*document, pos) == kNoNode) {
         if (error_message_.empty()) {
             error_message_ = "Failed to parse XML content";
         }
         return false;
     }
-    
+
+    document_ = std::move(document); // The root is nodes[0]
     return true;
 }
 
+// XMLParser implementation
+bool XMLParser::load_file(const std::string& filepath) {
+    document_.reset();
+    error_message_.clear();
+    const int fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        error_message_ = "Failed to open file: " + filepath;
+        return false;
+    }
+
+    auto document = std::make_shared<Document>();
+    struct stat info {};
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        const size_t size = static_cast<size_t>(info.st_size);
+        void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            ::madvise(mapping, size, MADV_SEQUENTIAL);
+            document->mapping = mapping;
+            document->mapping_size = size;
+            document->content = std::string_view(static_cast<const char*>(mapping), size);
+        }
+    }
+    ::close(fd);
+
+    // Empty, not a regular file or not mappable: read it into memory instead
+    if (document->mapping == nullptr) {
+        std::ifstream file(filepath, std::ios::binary);
+        if (!file.is_open()) {
+            error_message_ = "Failed to open file: " + filepath;
+            return false;
+        }
+        document->owned_content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        document->content = document->owned_content;
+    }
+    return parse(std::move(document));
+}
+
+bool XMLParser::load_string(const std::string& xml_content) {
+    document_.reset();
+    error_message_.clear();
+    auto document = std::make_shared<Document>();
+    document->owned_content = xml_content;
+    document->content = document->owned_content;
+    return parse(std::move(document));
+}
+
 XMLParser::XMLNode XMLParser::get_root() const {
-    return XMLNode(root_);
+    if (!document_) return XMLNode();
+    return XMLNode(document_.get(), 0);
 }
 
 XMLParser::XMLNode XMLParser::find_element(const std::string& element_name) const {
     XMLNode root = get_root();
-    if (!root.is_valid()) return XMLNode(nullptr);
-    
+    if (!root.is_valid()) return XMLNode();
+
     return root.get_child(element_name);
 }
@@ -0,0 +1,80 @@
+#include "RealTimePacer.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include "Logger.hpp"
+
+bool RealTimePacer::configure(double time_scale, std::chrono::microseconds spin_threshold) {
+    if (time_scale != 0.0 && !(time_scale >= kMinTimeScale && time_scale <= kMaxTimeScale)) {
+        return false;
+    }
+    time_scale_ = time_scale;
+    spin_threshold_ = spin_threshold;
+    return true;
+}
+
+void RealTimePacer::start(const SimulationClock& clock) {
+    anchor_wall_ = WallClock::now();
+    anchor_sim_ = clock.now();
+    stats_ = Stats{};
+}
+
+RealTimePacer::WallClock::time_point RealTimePacer::deadline(double sim_time) const {
+    const std::chrono::duration<double> wall_offset((sim_time - anchor_sim_) / time_scale_);
+    return anchor_wall_ + std::chrono::duration_cast<WallClock::duration>(wall_offset);
+}
+
+void RealTimePacer::wait(const SimulationClock& clock) {
+    if (!is_enabled()) {
+        return;
+    }
+    ++stats_.waits;
+
+    const WallClock::time_point target = deadline(clock.now());
+    WallClock::time_point now = WallClock::now();
+    if (now >= target) {
+        const double lateness_ms = std::chrono::duration<double, std::milli>(now - target).count();
+        if (lateness_ms > 0.0) {
+            ++stats_.overruns;
+            stats_.total_lateness_ms += lateness_ms;
+            stats_.max_lateness_ms = std::max(stats_.max_lateness_ms, lateness_ms);
+        }
+        if (lateness_ms > kMaxLagSeconds * 1e3) {
+            ++stats_.resyncs;
+            anchor_wall_ = now;
+            anchor_sim_ = clock.now();
+        }
+        return;
+    }
+
+    // Sleep through the bulk of the wait, then spin so the wake-up lands on the deadline
+    if (target - now > spin_threshold_) {
+        std::this_thread::sleep_until(target - spin_threshold_);
+    }
+    do {
+        now = WallClock::now();
+    } while (now < target);
+
+    const double wake_error_us = std::chrono::duration<double, std::micro>(now - target).count();
+    ++stats_.slept;
+    stats_.total_wake_error_us += wake_error_us;
+    stats_.max_wake_error_us = std::max(stats_.max_wake_error_us, wake_error_us);
+}
+
+void RealTimePacer::report() const {
+    if (!is_enabled()) {
+        return;
+    }
+    const double overrun_pct = stats_.waits ? 100.0 * stats_.overruns / stats_.waits : 0.0;
+    MSF_LOG_INFO("Real-time pacing at {}x: {} ticks, {} overruns ({:.3f}%), {} resyncs", time_scale_, stats_.waits,
+                 stats_.overruns, overrun_pct, stats_.resyncs);
+    if (stats_.overruns > 0) {
+        MSF_LOG_INFO("  Overrun lateness: avg {:.3f} ms, max {:.3f} ms", stats_.total_lateness_ms / stats_.overruns,
+                     stats_.max_lateness_ms);
+    }
+    if (stats_.slept > 0) {
+        MSF_LOG_INFO("  Wake-up error: avg {:.3f} us, max {:.3f} us", stats_.total_wake_error_us / stats_.slept,
+                     stats_.max_wake_error_us);
+    }
+}
@@ -0,0 +1,262 @@
+#include "TickEngine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <typeinfo>
+
+#include "Logger.hpp"
+#include "Profiler.hpp"
+
+namespace {
+
+// Entity::update, timed per dynamic class when the profiler is on
+inline void update_entity(Entity& entity, double t, double dt, [[maybe_unused]] bool profiled) {
+#if MSF_PROFILING
+    if (profiled) {
+        const uint64_t start = msf::Profiler::now_ns();
+        entity.update(t, dt);
+        msf::Profiler& profiler = msf::Profiler::instance();
+        profiler.record(profiler.type_name(typeid(entity)), msf::ProfileCategory::EntityClass, start,
+                        msf::Profiler::now_ns());
+        return;
+    }
+#endif
+    entity.update(t, dt);
+}
+
+// Update entities [begin, end) of the snapshot, one statically-typed loop per bucket run
+void update_runs(Entity* const* entities, const std::vector<EntityRegistry::UpdateRun>& runs, std::size_t begin,
+                 std::size_t end, double t, double dt) {
+    auto run = std::partition_point(runs.begin(), runs.end(),
+                                    [begin](const EntityRegistry::UpdateRun& r) { return r.end <= begin; });
+    for (; run != runs.end() && run->begin < end; ++run) {
+        const std::size_t first = std::max(begin, run->begin);
+        const std::size_t last = std::min(end, run->end);
+        if (run->update != nullptr) {
+            run->update(entities + first, last - first, t, dt);
+        } else {
+            for (std::size_t i = first; i < last; ++i) {
+                entities[i]->update(t, dt);
+            }
+        }
+    }
+}
+
+} // namespace
+
+void TickEngine::configure(std::size_t thread_count, std::size_t grain) {
+    grain_ = grain;
+    if (thread_count > 1) {
+        pool_ = std::make_unique<msf::ThreadPool>(thread_count);
+        MSF_LOG_INFO("Parallel tick enabled: {} threads, grain {}", pool_->size(),
+                     grain_ == 0 ? std::string("auto") : std::to_string(grain_));
+    } else {
+        pool_.reset();
+    }
+}
+
+void TickEngine::tick(EntityRegistry& registry, double t, double dt, TickObserver* observer) {
+    // PhysicsEntity::update defers its integration to one pass over the store's arrays after the
+    // updates. An observer needs each entity's final state right after its update, so then every
+    // entity integrates its own slot immediately instead.
+    PhysicsStore& physics = registry.get_physics_store();
+    physics.set_deferred(observer == nullptr);
+    if (physics.is_snapshot_enabled()) {
+        // Reads of other entities during the updates see this, not each other's half-finished writes
+        MSF_PROFILE_SCOPE("publish_snapshot");
+        physics.publish_snapshot();
+    }
+
+    // Both paths walk the same snapshot: active entities by rate block, then inactive ones
+    if (tick_list_registry_ != &registry || tick_list_revision_ != registry.get_revision() || tick_list_dt_ != dt) {
+        tick_list_registry_ = &registry;
+        tick_list_revision_ = registry.get_revision();
+        tick_list_dt_ = dt;
+        build_rate_blocks(registry, dt);
+    }
+    const uint64_t frame = frame_++;
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool profiled = MSF_PROFILE_ACTIVE();
+    const bool bucketed = observer == nullptr && !profiled && !track_slowest_ && bucketed_dispatch_;
+    slowest_ = SlowestUpdate{};
+    for (const RateBlock& block : blocks_) {
+        const bool due = block.divisor != 0 && frame % block.divisor == block.phase;
+        // Blocks that are not due are only visited to report them to an observer
+        if (due || observer != nullptr) {
+            run_block(block, due, t, dt * block.divisor, observer, profiled, bucketed, track_slowest_ && due);
+        }
+    }
+    if (physics.is_deferred()) {
+        MSF_PROFILE_SCOPE("integrate_physics");
+        for (const RateBlock& block : blocks_) {
+            if (block.divisor == 0 || frame % block.divisor != block.phase || block.slots.empty()) {
+                continue;
+            }
+            if (block.slots.size() == physics.size()) {
+                physics.integrate_pending(dt * block.divisor);
+            } else {
+                physics.integrate_pending(block.slots, dt * block.divisor);
+            }
+        }
+        physics.set_deferred(false); // Updates outside a tick integrate immediately
+    }
+    physics.retire_snapshot();
+    ++ticks_;
+    update_wall_ns_ += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+void TickEngine::run_block(const RateBlock& block, bool due, double t, double block_dt, TickObserver* observer,
+                           bool profiled, bool bucketed, bool timed) {
+    Entity* const* entities = tick_list_.data();
+    const std::vector<EntityRegistry::UpdateRun>* runs = &block.runs;
+    const std::size_t base = block.begin;
+    auto body = [this, entities, runs, base, due, bucketed, timed, t, block_dt, observer,
+                 profiled](std::size_t begin, std::size_t end) {
+        begin += base;
+        end += base;
+        if (bucketed) {
+            update_runs(entities, *runs, begin, end, t, block_dt);
+            return;
+        }
+        SlowestUpdate slowest;
+        for (std::size_t i = begin; i < end; ++i) {
+            if (due && timed) {
+                const auto start = std::chrono::steady_clock::now();
+                update_entity(*entities[i], t, block_dt, profiled);
+                const auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+                if (ns > slowest.ns) {
+                    slowest = SlowestUpdate{entities[i], ns};
+                }
+            } else if (due) {
+                update_entity(*entities[i], t, block_dt, profiled);
+            }
+            if (observer != nullptr) {
+                observer->on_entity_updated(i, *entities[i]);
+            }
+        }
+        if (slowest.entity != nullptr) {
+            note_slowest(slowest);
+        }
+    };
+
+    const std::size_t count = block.end - block.begin;
+    if (!pool_) {
+        body(0, count);
+        return;
+    }
+    pool_->parallel_for(count, grain_, [&body](std::size_t begin, std::size_t end) {
+        MSF_PROFILE_SCOPE("update_chunk");
+        body(begin, end);
+    });
+}
+
+void TickEngine::note_slowest(const SlowestUpdate& candidate) {
+    std::lock_guard<std::mutex> lock(slowest_mutex_);
+    if (candidate.ns > slowest_.ns) {
+        slowest_ = candidate;
+    }
+}
+
+void TickEngine::build_rate_blocks(EntityRegistry& registry, double dt) {
+    std::vector<EntityRegistry::UpdateRun> runs;
+    const std::size_t active = registry.collect_entities(tick_list_, &runs);
+
+    // Update loop of every active entity, so runs can be rebuilt after regrouping
+    std::vector<EntityRegistry::UpdateBatchFn> updates(active, nullptr);
+    for (const auto& run : runs) {
+        std::fill(updates.begin() + run.begin, updates.begin() + run.end, run.update);
+    }
+
+    // Rate group and frame phase of every active entity. The phase comes from the entity's registry
+    // slot, so it is stable while the entity stays registered and spreads a group across frames.
+    std::vector<uint64_t> keys(active);
+    for (std::size_t i = 0; i < active; ++i) {
+        const uint32_t divisor = rate_divisor(tick_list_[i]->get_update_rate(), dt);
+        const uint32_t phase = tick_list_[i]->get_handle().index % divisor;
+        keys[i] = (static_cast<uint64_t>(divisor) << 32) | phase;
+    }
+
+    // Stable regroup by (divisor, phase); class and slot order survive within each block
+    std::vector<std::size_t> order(active);
+    for (std::size_t i = 0; i < active; ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) { return keys[a] < keys[b]; });
+    std::vector<Entity*> grouped(active);
+    std::vector<EntityRegistry::UpdateBatchFn> grouped_updates(active);
+    for (std::size_t i = 0; i < active; ++i) {
+        grouped[i] = tick_list_[order[i]];
+        grouped_updates[i] = updates[order[i]];
+    }
+    std::copy(grouped.begin(), grouped.end(), tick_list_.begin());
+
+    blocks_.clear();
+    for (std::size_t i = 0; i < active; ++i) {
+        const uint64_t key = keys[order[i]];
+        if (blocks_.empty() || (static_cast<uint64_t>(blocks_.back().divisor) << 32 | blocks_.back().phase) != key) {
+            blocks_.push_back(RateBlock{static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key), i, i, {}, {}});
+        }
+        RateBlock& block = blocks_.back();
+        block.end = i + 1;
+        if (block.runs.empty() || block.runs.back().update != grouped_updates[i]) {
+            block.runs.push_back(EntityRegistry::UpdateRun{i, i, grouped_updates[i]});
+        }
+        block.runs.back().end = i + 1;
+        if (const auto* physics = dynamic_cast<const PhysicsEntity*>(grouped[i])) {
+            block.slots.push_back(static_cast<uint32_t>(physics->get_physics_slot()));
+        }
+    }
+    for (RateBlock& block : blocks_) {
+        std::sort(block.slots.begin(), block.slots.end()); // Sweep the store's arrays front to back
+    }
+
+    // Sleeping and static entities: never due, only shown to observers
+    if (active < tick_list_.size()) {
+        blocks_.push_back(RateBlock{0, 0, active, tick_list_.size(), {}, {}});
+    }
+}
+
+uint32_t TickEngine::rate_divisor(double rate_hz, double dt) {
+    // Largest power of two whose period still meets the requested rate, so groups are harmonic
+    uint32_t divisor = 1;
+    if (rate_hz > 0.0 && dt > 0.0) {
+        const double ticks_per_update = 1.0 / (rate_hz * dt);
+        while (divisor < kMaxRateDivisor && 2.0 * divisor <= ticks_per_update * (1.0 + 1e-9)) {
+            divisor *= 2;
+        }
+    }
+    return divisor;
+}
+
+void TickEngine::report() const {
+    const double avg_us = ticks_ ? update_wall_ns_ / 1e3 / ticks_ : 0.0;
+    if (!pool_) {
+        MSF_LOG_INFO("Tick engine (serial): {} ticks, avg update {:.3f} us/tick", ticks_, avg_us);
+        return;
+    }
+
+    const msf::ThreadPool::Stats stats = pool_->get_stats();
+    uint64_t busy_ns = 0;
+    for (const auto& participant : stats.participants) {
+        busy_ns += participant.busy_ns;
+    }
+
+    // Effective parallelism = total time spent in entity updates / wall time of the update phase.
+    // With perfect scaling this equals the thread count.
+    const double threads = static_cast<double>(stats.participants.size());
+    const double parallelism = stats.wall_ns ? static_cast<double>(busy_ns) / stats.wall_ns : 0.0;
+
+    MSF_LOG_INFO("Tick engine (parallel): {} ticks, avg update {:.3f} us/tick, {} threads", ticks_, avg_us,
+                 stats.participants.size());
+    MSF_LOG_INFO("  Effective parallelism: {:.3f}x ({:.3f}% efficiency)", parallelism,
+                 threads > 0.0 ? 100.0 * parallelism / threads : 0.0);
+    for (std::size_t i = 0; i < stats.participants.size(); ++i) {
+        const auto& participant = stats.participants[i];
+        const double share = busy_ns ? 100.0 * participant.busy_ns / busy_ns : 0.0;
+        MSF_LOG_INFO("  Thread {}: {} chunks ({} stolen), {:.3f}% of update work", i, participant.chunks_executed,
+                     participant.chunks_stolen, share);
+    }
+}
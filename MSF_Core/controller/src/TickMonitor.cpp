@@ -0,0 +1,71 @@
+#include "TickMonitor.hpp"
+
+#include <algorithm>
+
+#include "Logger.hpp"
+
+std::vector<TickMonitor::Overrun> TickMonitor::get_worst_overruns() const {
+    std::vector<Overrun> worst = worst_;
+    std::sort(worst.begin(), worst.end(),
+              [](const Overrun& a, const Overrun& b) { return a.duration_ns > b.duration_ns; });
+    return worst;
+}
+
+void TickMonitor::record_overrun(uint64_t duration_ns, const TickEngine::SlowestUpdate& slowest) {
+    Overrun overrun;
+    overrun.tick = tick_;
+    overrun.sim_time = sim_time_;
+    overrun.duration_ns = duration_ns;
+    for (std::size_t i = 0; i < phase_count_; ++i) {
+        if (phases_[i].ns >= overrun.phase_ns) {
+            overrun.phase = phases_[i].name;
+            overrun.phase_ns = phases_[i].ns;
+        }
+    }
+    if (slowest.entity != nullptr) {
+        overrun.entity_id = slowest.entity->get_id();
+        overrun.entity_name = slowest.entity->get_name();
+        overrun.entity_ns = slowest.ns;
+    }
+
+    const uint64_t count = overrun_count_.load(std::memory_order_relaxed) + 1;
+    overrun_count_.store(count, std::memory_order_relaxed);
+    if (count <= kLoggedOverruns) {
+        MSF_LOG_WARNING("Tick {} at t={}s overran its {:.3f} us deadline: {:.3f} us, slowest phase {} ({:.3f} us), "
+                        "slowest entity {} [{}] ({:.3f} us)",
+                        overrun.tick, overrun.sim_time, deadline_ns_ / 1e3, duration_ns / 1e3, overrun.phase,
+                        overrun.phase_ns / 1e3, overrun.entity_name, overrun.entity_id, overrun.entity_ns / 1e3);
+        if (count == kLoggedOverruns) {
+            MSF_LOG_WARNING("Further tick overruns are counted but not logged");
+        }
+    }
+
+    if (worst_.size() < kKeptOverruns) {
+        worst_.push_back(std::move(overrun));
+        return;
+    }
+    auto fastest = std::min_element(worst_.begin(), worst_.end(),
+                                    [](const Overrun& a, const Overrun& b) { return a.duration_ns < b.duration_ns; });
+    if (fastest->duration_ns < duration_ns) {
+        *fastest = std::move(overrun);
+    }
+}
+
+void TickMonitor::report() const {
+    if (histogram_.count() == 0) {
+        return;
+    }
+    MSF_LOG_INFO("Tick latency: {} ticks, mean {:.3f} us, p50 {:.3f} us, p99 {:.3f} us, p99.9 {:.3f} us, max {:.3f} us",
+                 histogram_.count(), histogram_.mean() / 1e3, histogram_.percentile(50.0) / 1e3,
+                 histogram_.percentile(99.0) / 1e3, histogram_.percentile(99.9) / 1e3, histogram_.max() / 1e3);
+    if (!is_watching()) {
+        return;
+    }
+
+    MSF_LOG_INFO("Tick deadline {:.3f} us: {} overruns", deadline_ns_ / 1e3, get_overrun_count());
+    for (const Overrun& overrun : get_worst_overruns()) {
+        MSF_LOG_INFO("  tick {} (t={}s): {:.3f} us, {} {:.3f} us, entity {} [{}] {:.3f} us", overrun.tick,
+                     overrun.sim_time, overrun.duration_ns / 1e3, overrun.phase, overrun.phase_ns / 1e3,
+                     overrun.entity_name, overrun.entity_id, overrun.entity_ns / 1e3);
+    }
+}
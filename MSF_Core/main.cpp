@@ -5,15 +5,16 @@
 #include <string>
 
 #include "ArgParse.hpp"
+#include "BatchRunner.hpp"
 #include "Controller.hpp"
+#include "Logger.hpp"
 
 int main(int argc, char** argv) {
-    std::cout << "[INFO] Starting Modular Simulation Framework" << std::endl;
-
     ArgParse::Options options;
     std::string parse_error;
     if (!ArgParse::parse(argc, argv, options, parse_error)) {
-        std::cerr << "[ERROR] " << parse_error << std::endl;
+        MSF_LOG_ERROR("{}", parse_error);
+        msf::Logger::instance().flush(); // Print the error before the usage text
         ArgParse::print_usage(argv[0]);
         return EXIT_FAILURE;
     }
@@ -23,10 +24,24 @@ int main(int argc, char** argv) {
         return EXIT_SUCCESS;
     }
 
+    msf::LogLevel log_level = msf::LogLevel::Debug;
+    msf::parse_log_level(options.log_level, log_level); // Validated by ArgParse
+    msf::Logger::instance().set_level(log_level);
+    MSF_LOG_INFO("Starting Modular Simulation Framework");
+
+    if (options.replicas > 0) {
+        BatchRunner batch(options);
+        const bool ok = batch.run();
+        MSF_LOG_INFO("Exiting Modular Simulation Framework");
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     Controller controller;
-    controller.initialize(options.scenario_path);
+    if (!controller.initialize(options)) {
+        return EXIT_FAILURE;
+    }
     controller.run();
 
-    std::cout << "[INFO] Exiting Modular Simulation Framework" << std::endl;
+    MSF_LOG_INFO("Exiting Modular Simulation Framework");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+// Command line reader for MSF trajectory files (*.msft)
+//
+//   msf_trajectory_reader <file.msft>                   Summary: frame count, time span, entities
+//   msf_trajectory_reader --csv <file.msft> [entity]    One CSV row per entity per frame, optionally
+//                                                       filtered to a single entity name or id
+
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <string>
+
+#include "TrajectoryReader.hpp"
+
+namespace {
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--csv] <file.msft> [entity]\n"
+              << "  --csv    Print every sample as CSV instead of a summary\n"
+              << "  entity   With --csv, only print rows for this entity name or id\n";
+}
+
+bool matches_filter(const TrajectoryReader& reader, const std::string& filter, int32_t id) {
+    return filter.empty() || reader.entity_name(id) == filter || std::to_string(id) == filter;
+}
+
+int print_csv(TrajectoryReader& reader, const std::string& filter) {
+    using namespace trajectory_format;
+
+    std::cout.precision(std::numeric_limits<double>::max_digits10);
+    std::cout << "time,id,name";
+    for (const char* column : kColumnNames) {
+        std::cout << ',' << column;
+    }
+    std::cout << '\n';
+
+    TrajectoryReader::Frame frame;
+    while (reader.next_frame(frame)) {
+        for (std::size_t i = 0; i < frame.size(); ++i) {
+            if (!matches_filter(reader, filter, frame.ids[i])) {
+                continue;
+            }
+            std::cout << frame.time << ',' << frame.ids[i] << ',' << reader.entity_name(frame.ids[i]);
+            for (uint32_t column = 0; column < kColumnCount; ++column) {
+                std::cout << ',' << frame.value(column, i);
+            }
+            std::cout << '\n';
+        }
+    }
+    return reader.get_error().empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int print_summary(TrajectoryReader& reader, const std::string& path) {
+    TrajectoryReader::Frame frame;
+    std::size_t frames = 0;
+    std::size_t max_entities = 0;
+    double first_time = 0.0;
+    double last_time = 0.0;
+    std::set<int32_t> ids;
+    while (reader.next_frame(frame)) {
+        if (frames == 0) {
+            first_time = frame.time;
+        }
+        last_time = frame.time;
+        max_entities = std::max(max_entities, frame.size());
+        ids.insert(frame.ids.begin(), frame.ids.end());
+        ++frames;
+    }
+
+    std::cout << "File:            " << path << '\n'
+              << "Output interval: " << reader.get_output_interval() << " s ("
+              << (reader.get_output_interval() > 0.0 ? 1.0 / reader.get_output_interval() : 0.0) << " Hz)\n"
+              << "Frames:          " << frames << '\n'
+              << "Time span:       " << first_time << " s to " << last_time << " s\n"
+              << "Max entities:    " << max_entities << '\n'
+              << "Entities:\n";
+    for (int32_t id : ids) {
+        std::cout << "  " << id << ' ' << reader.entity_name(id) << '\n';
+    }
+    return reader.get_error().empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool csv = false;
+    std::string path;
+    std::string filter;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        if (argument == "--csv") {
+            csv = true;
+        } else if (argument == "-h" || argument == "--help") {
+            print_usage(argv[0]);
+            return EXIT_SUCCESS;
+        } else if (path.empty()) {
+            path = argument;
+        } else if (filter.empty()) {
+            filter = argument;
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (path.empty()) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    TrajectoryReader reader;
+    if (!reader.open(path)) {
+        std::cerr << "Error: " << reader.get_error() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    const int status = csv ? print_csv(reader, filter) : print_summary(reader, path);
+    if (!reader.get_error().empty()) {
+        std::cerr << "Error: " << reader.get_error() << '\n';
+    }
+    return status;
+}
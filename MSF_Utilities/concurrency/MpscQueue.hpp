@@ -0,0 +1,99 @@
+/*
+* @file:   MpscQueue.hpp
+* @lib:    msfutil_libs
+* @brief:  Bounded lock-free multi-producer / single-consumer queue.
+* A ring of cells that each carry a sequence number (D. Vyukov's bounded queue, reduced to a single
+* consumer). Producers claim a cell with one CAS on the tail and publish it by bumping the cell's
+* sequence; the consumer owns the head outright. push() fails instead of blocking or allocating when
+* the ring is full, so callers decide how to degrade.
+*
+* @author: Brandon Coulter
+* @date:   2026-03-12
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace msf {
+
+template <typename T>
+class MpscQueue {
+    static_assert(std::is_trivially_copyable_v<T>, "MpscQueue stores plain values");
+
+public:
+    // Capacity is rounded up to a power of two.
+    explicit MpscQueue(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask_ = size - 1;
+        cells_ = std::make_unique<Cell[]>(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Safe to call from any number of threads. Returns false if the queue is full.
+    bool push(const T& value) {
+        std::size_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false; // The consumer has not freed this cell yet
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only. Returns false when no published value is available.
+    bool pop(T& out) {
+        Cell& cell = cells_[head_ & mask_];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != head_ + 1) {
+            return false;
+        }
+        out = cell.value;
+        cell.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    // Consumer thread only. True when pop() would find nothing.
+    bool empty() const {
+        return cells_[head_ & mask_].sequence.load(std::memory_order_acquire) != head_ + 1;
+    }
+
+    std::size_t capacity() const {
+        return mask_ + 1;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_ = 0;
+    alignas(64) std::atomic<std::size_t> tail_{0}; // Next cell a producer will claim
+    alignas(64) std::size_t head_ = 0;             // Next cell the consumer will read
+};
+
+} // namespace msf
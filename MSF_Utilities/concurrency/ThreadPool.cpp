@@ -0,0 +1,219 @@
+/*
+* @file:   ThreadPool.cpp
+* @lib:    msfutil_libs
+* @brief:  Implementation of the work-stealing ThreadPool.
+*
+* @author: Brandon Coulter
+* @date:   2026-03-08
+*/
+
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace msf {
+
+namespace {
+
+// Idle workers yield this many times looking for the next job before blocking on the condition
+// variable. Ticks arrive back-to-back, so most jobs are picked up without a futex wake.
+constexpr int kIdleSpinIterations = 4096;
+
+std::uint64_t elapsed_ns(std::chrono::steady_clock::time_point start) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    participants_.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        participants_.push_back(std::make_unique<Participant>());
+    }
+
+    // Participant 0 is the calling thread, the rest get a dedicated worker.
+    workers_.reserve(thread_count - 1);
+    for (std::size_t i = 1; i < thread_count; ++i) {
+        workers_.emplace_back([this, i]() { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_.store(true, std::memory_order_release);
+    }
+    wake_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::run_job(const Job& job, std::size_t count, std::size_t grain) {
+    if (count == 0) {
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t participant_count = participants_.size();
+    if (grain == 0) {
+        grain = std::max<std::size_t>(1, (count + participant_count * 8 - 1) / (participant_count * 8));
+    }
+    const std::size_t chunk_count = (count + grain - 1) / grain;
+
+    if (participant_count == 1 || chunk_count == 1) {
+        // Nothing to share; run inline without waking anyone.
+        execute_inline(job, count);
+    } else {
+        remaining_chunks_.store(chunk_count, std::memory_order_relaxed);
+
+        // Seed each participant with a contiguous block of chunks so neighbouring indices stay
+        // on the same core unless someone runs dry and steals.
+        for (std::size_t p = 0; p < participant_count; ++p) {
+            const std::size_t first = chunk_count * p / participant_count;
+            const std::size_t last = chunk_count * (p + 1) / participant_count;
+            std::lock_guard<std::mutex> lock(participants_[p]->mutex);
+            for (std::size_t c = first; c < last; ++c) {
+                const std::size_t begin = c * grain;
+                participants_[p]->chunks.push_back(Chunk{&job, begin, std::min(count, begin + grain)});
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            generation_.fetch_add(1, std::memory_order_release);
+        }
+        wake_cv_.notify_all();
+
+        drain(0);
+        while (remaining_chunks_.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    ++jobs_;
+    wall_ns_ += elapsed_ns(start);
+}
+
+void ThreadPool::execute_inline(const Job& job, std::size_t count) {
+    const auto start = std::chrono::steady_clock::now();
+    job.invoke(job.context, 0, count);
+    Participant& self = *participants_[0];
+    self.chunks_executed.fetch_add(1, std::memory_order_relaxed);
+    self.busy_ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+}
+
+void ThreadPool::worker_loop(std::size_t index) {
+    std::uint64_t seen_generation = 0;
+    while (true) {
+        std::uint64_t generation = generation_.load(std::memory_order_acquire);
+        for (int spin = 0; spin < kIdleSpinIterations && generation == seen_generation; ++spin) {
+            if (stopping_.load(std::memory_order_acquire)) {
+                return;
+            }
+            std::this_thread::yield();
+            generation = generation_.load(std::memory_order_acquire);
+        }
+
+        if (generation == seen_generation) {
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_cv_.wait(lock, [&]() {
+                return stopping_.load(std::memory_order_acquire)
+                    || generation_.load(std::memory_order_acquire) != seen_generation;
+            });
+            generation = generation_.load(std::memory_order_acquire);
+        }
+
+        if (stopping_.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        seen_generation = generation;
+        drain(index);
+    }
+}
+
+void ThreadPool::drain(std::size_t index) {
+    Chunk chunk{};
+    while (true) {
+        if (pop_local(index, chunk)) {
+            execute(index, chunk, false);
+        } else if (steal(index, chunk)) {
+            execute(index, chunk, true);
+        } else {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::pop_local(std::size_t index, Chunk& chunk) {
+    Participant& self = *participants_[index];
+    std::lock_guard<std::mutex> lock(self.mutex);
+    if (self.chunks.empty()) {
+        return false;
+    }
+    chunk = self.chunks.front();
+    self.chunks.pop_front();
+    return true;
+}
+
+bool ThreadPool::steal(std::size_t thief, Chunk& chunk) {
+    const std::size_t participant_count = participants_.size();
+    for (std::size_t offset = 1; offset < participant_count; ++offset) {
+        Participant& victim = *participants_[(thief + offset) % participant_count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.chunks.empty()) {
+            chunk = victim.chunks.back();
+            victim.chunks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::execute(std::size_t index, const Chunk& chunk, bool stolen) {
+    const auto start = std::chrono::steady_clock::now();
+    chunk.job->invoke(chunk.job->context, chunk.begin, chunk.end);
+
+    Participant& self = *participants_[index];
+    self.chunks_executed.fetch_add(1, std::memory_order_relaxed);
+    if (stolen) {
+        self.chunks_stolen.fetch_add(1, std::memory_order_relaxed);
+    }
+    self.busy_ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+
+    // Release so the caller observes every write made by the chunk once the count hits zero.
+    remaining_chunks_.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+ThreadPool::Stats ThreadPool::get_stats() const {
+    Stats stats;
+    stats.jobs = jobs_;
+    stats.wall_ns = wall_ns_;
+    stats.participants.reserve(participants_.size());
+    for (const auto& participant : participants_) {
+        ParticipantStats entry;
+        entry.chunks_executed = participant->chunks_executed.load(std::memory_order_relaxed);
+        entry.chunks_stolen = participant->chunks_stolen.load(std::memory_order_relaxed);
+        entry.busy_ns = participant->busy_ns.load(std::memory_order_relaxed);
+        stats.participants.push_back(entry);
+    }
+    return stats;
+}
+
+void ThreadPool::reset_stats() {
+    jobs_ = 0;
+    wall_ns_ = 0;
+    for (auto& participant : participants_) {
+        participant->chunks_executed.store(0, std::memory_order_relaxed);
+        participant->chunks_stolen.store(0, std::memory_order_relaxed);
+        participant->busy_ns.store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace msf
@@ -0,0 +1,117 @@
+/*
+* @file:   ThreadPool.hpp
+* @lib:    msfutil_libs
+* @brief:  Work-stealing thread pool used to split per-tick work across cores.
+* The pool is built around a single blocking primitive, parallel_for(), which splits an index
+* range into chunks, seeds every participant's deque with a contiguous block of chunks and lets
+* idle participants steal from the back of busy ones. The calling thread always participates,
+* so a pool of size N spawns N-1 worker threads.
+*
+* @author: Brandon Coulter
+* @date:   2026-03-08
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace msf {
+
+class ThreadPool {
+public:
+    // Per-participant counters, used to report scaling at shutdown.
+    struct ParticipantStats {
+        std::uint64_t chunks_executed = 0; // Chunks this participant ran
+        std::uint64_t chunks_stolen = 0;   // Subset of chunks_executed taken from another deque
+        std::uint64_t busy_ns = 0;         // Wall time spent inside chunk bodies
+    };
+
+    struct Stats {
+        std::uint64_t jobs = 0;      // Number of parallel_for calls
+        std::uint64_t wall_ns = 0;   // Wall time spent inside parallel_for (caller side)
+        std::vector<ParticipantStats> participants;
+    };
+
+    // thread_count includes the calling thread; 0 selects std::thread::hardware_concurrency().
+    explicit ThreadPool(std::size_t thread_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Number of participants (workers + calling thread).
+    std::size_t size() const {
+        return participants_.size();
+    }
+
+    // Run fn(begin, end) over [0, count) in chunks of at most grain indices and block until
+    // every chunk has finished. grain == 0 picks a grain that gives each participant ~8 chunks.
+    template <typename Fn>
+    void parallel_for(std::size_t count, std::size_t grain, Fn&& fn) {
+        using FnType = std::remove_reference_t<Fn>;
+        Job job;
+        job.context = const_cast<void*>(static_cast<const void*>(&fn));
+        job.invoke = [](void* context, std::size_t begin, std::size_t end) {
+            (*static_cast<FnType*>(context))(begin, end);
+        };
+        run_job(job, count, grain);
+    }
+
+    Stats get_stats() const;
+    void reset_stats();
+
+private:
+    struct Job {
+        void* context = nullptr;
+        void (*invoke)(void*, std::size_t, std::size_t) = nullptr;
+    };
+
+    struct Chunk {
+        const Job* job;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    // One deque per participant. The owner pops from the front, thieves take from the back so
+    // the owner keeps walking its block in index order.
+    struct alignas(64) Participant {
+        std::mutex mutex;
+        std::deque<Chunk> chunks;
+        std::atomic<std::uint64_t> chunks_executed{0};
+        std::atomic<std::uint64_t> chunks_stolen{0};
+        std::atomic<std::uint64_t> busy_ns{0};
+    };
+
+    void run_job(const Job& job, std::size_t count, std::size_t grain);
+    void execute_inline(const Job& job, std::size_t count);
+    void worker_loop(std::size_t index);
+    // Execute chunks until no deque has work left. Returns once every deque was seen empty.
+    void drain(std::size_t index);
+    bool pop_local(std::size_t index, Chunk& chunk);
+    bool steal(std::size_t thief, Chunk& chunk);
+    void execute(std::size_t index, const Chunk& chunk, bool stolen);
+
+    std::vector<std::unique_ptr<Participant>> participants_;
+    std::vector<std::thread> workers_;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic<std::uint64_t> generation_{0};
+    std::atomic<std::size_t> remaining_chunks_{0};
+    std::atomic<bool> stopping_{false};
+
+    std::uint64_t jobs_ = 0;
+    std::uint64_t wall_ns_ = 0;
+};
+
+} // namespace msf
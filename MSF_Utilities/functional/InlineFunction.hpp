@@ -0,0 +1,124 @@
+/*
+* @file:   InlineFunction.hpp
+* @lib:    msfutil_libs
+* @brief:  Move-only, fixed-capacity callable wrapper that never allocates.
+* InlineFunction<R(Args...), Capacity> stores the callable inside the object itself. Anything larger
+* than Capacity (or over-aligned) is rejected at compile time instead of silently falling back to the
+* heap like std::function does, which is what lets the event path stay allocation-free.
+*
+* @author: Brandon Coulter
+* @date:   2026-03-10
+*/
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace msf {
+
+template <typename Signature, std::size_t Capacity = 64>
+class InlineFunction;
+
+template <typename R, typename... Args, std::size_t Capacity>
+class InlineFunction<R(Args...), Capacity> {
+public:
+    static constexpr std::size_t kCapacity = Capacity;
+
+    InlineFunction() noexcept = default;
+    InlineFunction(std::nullptr_t) noexcept {}
+
+    template <typename F,
+              typename Fn = std::decay_t<F>,
+              typename = std::enable_if_t<!std::is_same_v<Fn, InlineFunction>
+                                          && std::is_invocable_r_v<R, Fn&, Args...>>>
+    InlineFunction(F&& callable) {
+        static_assert(sizeof(Fn) <= Capacity,
+                      "Callable does not fit in InlineFunction storage; capture less (e.g. ids instead of strings)");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "Over-aligned callables are not supported");
+        static_assert(std::is_nothrow_move_constructible_v<Fn>, "Callable must be nothrow move constructible");
+        ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(callable));
+        ops_ = &kOps<Fn>;
+    }
+
+    InlineFunction(InlineFunction&& other) noexcept {
+        take(other);
+    }
+
+    InlineFunction& operator=(InlineFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            take(other);
+        }
+        return *this;
+    }
+
+    InlineFunction& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    InlineFunction(const InlineFunction&) = delete;
+    InlineFunction& operator=(const InlineFunction&) = delete;
+
+    ~InlineFunction() {
+        reset();
+    }
+
+    R operator()(Args... args) const {
+        return ops_->invoke(storage_, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept {
+        return ops_ != nullptr;
+    }
+
+    // Destroy the stored callable (and everything it captured)
+    void reset() noexcept {
+        if (ops_ != nullptr) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        R (*invoke)(void*, Args&&...);
+        void (*move)(void* destination, void* source) noexcept;
+        void (*destroy)(void*) noexcept;
+    };
+
+    template <typename Fn>
+    static R invoke_impl(void* storage, Args&&... args) {
+        return (*static_cast<Fn*>(storage))(std::forward<Args>(args)...);
+    }
+
+    template <typename Fn>
+    static void move_impl(void* destination, void* source) noexcept {
+        ::new (destination) Fn(std::move(*static_cast<Fn*>(source)));
+        static_cast<Fn*>(source)->~Fn();
+    }
+
+    template <typename Fn>
+    static void destroy_impl(void* storage) noexcept {
+        static_cast<Fn*>(storage)->~Fn();
+    }
+
+    template <typename Fn>
+    static constexpr Ops kOps{&invoke_impl<Fn>, &move_impl<Fn>, &destroy_impl<Fn>};
+
+    // Steal other's callable; other is left empty.
+    void take(InlineFunction& other) noexcept {
+        if (other.ops_ != nullptr) {
+            other.ops_->move(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    const Ops* ops_ = nullptr;
+    alignas(std::max_align_t) mutable unsigned char storage_[Capacity];
+};
+
+} // namespace msf
@@ -0,0 +1,244 @@
+#include "Logger.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+namespace msf {
+
+namespace {
+
+// How long the writer sleeps when the ring is empty. Producers never signal it on the hot path.
+constexpr auto kIdleWait = std::chrono::milliseconds(2);
+// Records written between stream flushes
+constexpr std::size_t kBatchSize = 256;
+
+template <typename V>
+V read_value(const char* payload, std::size_t& offset) {
+    V value;
+    std::memcpy(&value, payload + offset, sizeof(V));
+    offset += sizeof(V);
+    return value;
+}
+
+// Accept printf precision/conversion specs such as ".3f", "e" or "10.2g"
+bool is_float_spec(std::string_view spec) {
+    if (spec.empty() || spec.size() > 8) {
+        return false;
+    }
+    for (std::size_t i = 0; i + 1 < spec.size(); ++i) {
+        if ((spec[i] < '0' || spec[i] > '9') && spec[i] != '.') {
+            return false;
+        }
+    }
+    const char conversion = spec.back();
+    return conversion == 'f' || conversion == 'e' || conversion == 'g';
+}
+
+} // namespace
+
+bool parse_log_level(const std::string& name, LogLevel& out) {
+    if (name == "debug") {
+        out = LogLevel::Debug;
+    } else if (name == "info") {
+        out = LogLevel::Info;
+    } else if (name == "warning" || name == "warn") {
+        out = LogLevel::Warning;
+    } else if (name == "error") {
+        out = LogLevel::Error;
+    } else if (name == "off") {
+        out = LogLevel::Off;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* log_level_name(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug: return "debug";
+        case LogLevel::Info: return "info";
+        case LogLevel::Warning: return "warning";
+        case LogLevel::Error: return "error";
+        case LogLevel::Off: return "off";
+    }
+    return "unknown";
+}
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() {
+    line_.reserve(512);
+    writer_ = std::thread([this]() { run(); });
+}
+
+Logger::~Logger() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_.store(true, std::memory_order_release);
+    }
+    wake_.notify_all();
+    writer_.join();
+
+    const uint64_t dropped = get_dropped();
+    if (dropped > 0) {
+        std::cerr << "[WARNING] Logger dropped " << dropped << " debug/info messages (ring full)" << std::endl;
+    }
+}
+
+void Logger::submit(const Record& record) {
+    if (queue_.push(record)) {
+        submitted_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (record.level < LogLevel::Warning) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    // Never lose warnings or errors: kick the writer and wait for room
+    do {
+        wake_.notify_one();
+        std::this_thread::yield();
+    } while (!queue_.push(record));
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Logger::flush() {
+    const uint64_t target = submitted_.load(std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_.notify_one();
+    drained_.wait(lock, [this, target]() { return written_.load(std::memory_order_acquire) >= target; });
+}
+
+void Logger::run() {
+    for (;;) {
+        const bool stopping = stopping_.load(std::memory_order_acquire);
+        if (write_batch() > 0) {
+            continue;
+        }
+        if (stopping) {
+            return; // Producers are gone and the ring is empty
+        }
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        if (!stopping_.load(std::memory_order_acquire)) {
+            wake_.wait_for(lock, kIdleWait);
+        }
+    }
+}
+
+std::size_t Logger::write_batch() {
+    std::size_t count = 0;
+    Record record;
+    while (count < kBatchSize && queue_.pop(record)) {
+        write_record(record);
+        ++count;
+    }
+    if (count > 0) {
+        // Records only count as written once they have left our stream buffers
+        std::cout.flush();
+        written_.fetch_add(count, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        drained_.notify_all();
+    }
+    return count;
+}
+
+void Logger::write_record(const Record& record) {
+    format_record(record, line_);
+    if (record.level >= LogLevel::Warning) {
+        std::cout.flush(); // Keep stdout/stderr lines in the order they were logged
+        std::cerr.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+    } else {
+        std::cout.write(line_.data(), static_cast<std::streamsize>(line_.size()));
+    }
+}
+
+void Logger::format_record(const Record& record, std::string& out) const {
+    out.clear();
+    out += '[';
+    out += record.tag;
+    out += "] ";
+
+    std::size_t offset = 0;
+    char number[64];
+    const std::string_view format(record.format);
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        const char c = format[i];
+        if (c == '}' && i + 1 < format.size() && format[i + 1] == '}') {
+            out += '}';
+            ++i;
+            continue;
+        }
+        if (c != '{') {
+            out += c;
+            continue;
+        }
+        if (i + 1 < format.size() && format[i + 1] == '{') {
+            out += '{';
+            ++i;
+            continue;
+        }
+        const std::size_t close = format.find('}', i);
+        if (close == std::string_view::npos) {
+            out.append(format.substr(i));
+            break;
+        }
+        std::string_view spec = format.substr(i + 1, close - i - 1);
+        if (!spec.empty() && spec.front() == ':') {
+            spec.remove_prefix(1);
+        }
+        i = close;
+
+        if (offset >= record.payload_size) {
+            out += "{}"; // More placeholders than arguments (or the argument was cut)
+            continue;
+        }
+        const auto type = static_cast<ArgType>(record.payload[offset++]);
+        switch (type) {
+            case ArgType::Bool:
+                out += read_value<uint8_t>(record.payload, offset) ? "true" : "false";
+                break;
+            case ArgType::Char:
+                out += read_value<char>(record.payload, offset);
+                break;
+            case ArgType::Int:
+                std::snprintf(number, sizeof(number), "%lld",
+                              static_cast<long long>(read_value<int64_t>(record.payload, offset)));
+                out += number;
+                break;
+            case ArgType::Uint:
+                std::snprintf(number, sizeof(number), "%llu",
+                              static_cast<unsigned long long>(read_value<uint64_t>(record.payload, offset)));
+                out += number;
+                break;
+            case ArgType::Double: {
+                const double value = read_value<double>(record.payload, offset);
+                if (is_float_spec(spec)) {
+                    char conversion[16];
+                    std::snprintf(conversion, sizeof(conversion), "%%%.*s", static_cast<int>(spec.size()),
+                                  spec.data());
+                    std::snprintf(number, sizeof(number), conversion, value);
+                } else {
+                    std::snprintf(number, sizeof(number), "%g", value); // Same as the iostream default
+                }
+                out += number;
+                break;
+            }
+            case ArgType::String: {
+                const auto length = read_value<uint16_t>(record.payload, offset);
+                out.append(record.payload + offset, length);
+                offset += length;
+                break;
+            }
+        }
+    }
+    if (record.truncated) {
+        out += " [...]";
+    }
+    out += '\n';
+}
+
+} // namespace msf
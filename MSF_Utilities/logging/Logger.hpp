@@ -0,0 +1,243 @@
+/*
+* @file:   Logger.hpp
+* @lib:    msfutil_libs
+* @brief:  Asynchronous leveled logger with deferred formatting.
+* A log statement only checks the level, copies its arguments (numbers by value, strings by content)
+* into a fixed-size record and pushes it onto a lock-free ring. A background thread does all of the
+* formatting and stream I/O, so the simulation loop never waits on std::endl.
+*
+* Use the MSF_LOG_* macros rather than Logger directly:
+*     MSF_LOG_INFO("Registered entity: ID={}, Name='{}'", id, name);
+*     MSF_LOG(msf::LogLevel::Info, "MISSILE", "Missile '{}' is running t={}", name, t);
+* Placeholders are `{}` or a printf-style precision such as `{:.3f}`. The format must be a string
+* literal. Statements below MSF_LOG_COMPILE_LEVEL compile to nothing (arguments are not evaluated);
+* statements below the runtime level cost one relaxed atomic load.
+*
+* @author: Brandon Coulter
+* @date:   2026-03-14
+*/
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+#include "MpscQueue.hpp"
+
+// 0 = debug, 1 = info, 2 = warning, 3 = error, 4 = off. Set by the meson `log_level` option.
+#ifndef MSF_LOG_COMPILE_LEVEL
+#define MSF_LOG_COMPILE_LEVEL 0
+#endif
+
+namespace msf {
+
+enum class LogLevel : uint8_t {
+    Debug = 0,
+    Info = 1,
+    Warning = 2,
+    Error = 3,
+    Off = 4,
+};
+
+// Parse "debug", "info", "warning" (or "warn"), "error" or "off"; returns false for anything else.
+bool parse_log_level(const std::string& name, LogLevel& out);
+const char* log_level_name(LogLevel level);
+
+namespace detail {
+// Runtime threshold, kept outside the Logger so a disabled statement never touches the singleton
+inline std::atomic<uint8_t> g_log_level{static_cast<uint8_t>(LogLevel::Debug)};
+} // namespace detail
+
+inline bool log_enabled(LogLevel level) {
+    return static_cast<uint8_t>(level) >= detail::g_log_level.load(std::memory_order_relaxed);
+}
+
+class Logger {
+public:
+    static constexpr std::size_t kQueueCapacity = 8192; // Records in flight before debug/info are dropped
+    static constexpr std::size_t kPayloadSize = 232;    // Argument bytes per record; longer strings are cut
+
+    static Logger& instance();
+
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void set_level(LogLevel level) {
+        detail::g_log_level.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+    LogLevel get_level() const {
+        return static_cast<LogLevel>(detail::g_log_level.load(std::memory_order_relaxed));
+    }
+
+    // Capture the arguments and hand the record to the writer thread. Debug/info records are dropped
+    // (and counted) if the ring is full; warnings and errors wait for space instead.
+    template <typename... Args>
+    void log(LogLevel level, const char* tag, const char* format, const Args&... args) {
+        Record record;
+        record.format = format;
+        record.tag = tag;
+        record.level = level;
+        [[maybe_unused]] PayloadWriter writer{record};
+        (writer.write(args), ...);
+        submit(record);
+    }
+
+    // Block until every record logged before the call has been written out.
+    void flush();
+
+    // Number of debug/info records dropped because the ring was full
+    uint64_t get_dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    enum class ArgType : uint8_t { Bool, Char, Int, Uint, Double, String };
+
+    struct Record {
+        const char* format = nullptr;
+        const char* tag = nullptr;
+        LogLevel level = LogLevel::Info;
+        bool truncated = false;
+        uint16_t payload_size = 0;
+        char payload[kPayloadSize];
+    };
+
+    // Serializes arguments as [type][value] (strings as [type][uint16 length][bytes])
+    struct PayloadWriter {
+        Record& record;
+
+        void put(const void* data, std::size_t size) {
+            std::memcpy(record.payload + record.payload_size, data, size);
+            record.payload_size = static_cast<uint16_t>(record.payload_size + size);
+        }
+
+        template <typename V>
+        void put_value(ArgType type, V value) {
+            if (record.payload_size + 1 + sizeof(V) > kPayloadSize) {
+                record.truncated = true;
+                return;
+            }
+            put(&type, 1);
+            put(&value, sizeof(V));
+        }
+
+        void put_string(std::string_view text) {
+            const std::size_t header = 1 + sizeof(uint16_t);
+            if (record.payload_size + header > kPayloadSize) {
+                record.truncated = true;
+                return;
+            }
+            std::size_t length = text.size();
+            if (record.payload_size + header + length > kPayloadSize) {
+                length = kPayloadSize - record.payload_size - header;
+                record.truncated = true;
+            }
+            const ArgType type = ArgType::String;
+            const uint16_t stored = static_cast<uint16_t>(length);
+            put(&type, 1);
+            put(&stored, sizeof(stored));
+            put(text.data(), length);
+        }
+
+        template <typename T>
+        void write(const T& value) {
+            using V = std::decay_t<T>;
+            if constexpr (std::is_same_v<V, bool>) {
+                put_value(ArgType::Bool, static_cast<uint8_t>(value));
+            } else if constexpr (std::is_same_v<V, char>) {
+                put_value(ArgType::Char, value);
+            } else if constexpr (std::is_enum_v<V>) {
+                put_value(ArgType::Int, static_cast<int64_t>(value));
+            } else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+                put_value(ArgType::Int, static_cast<int64_t>(value));
+            } else if constexpr (std::is_integral_v<V>) {
+                put_value(ArgType::Uint, static_cast<uint64_t>(value));
+            } else if constexpr (std::is_floating_point_v<V>) {
+                put_value(ArgType::Double, static_cast<double>(value));
+            } else if constexpr (std::is_array_v<T>) {
+                put_string(std::string_view(value)); // String literal
+            } else if constexpr (std::is_same_v<V, const char*> || std::is_same_v<V, char*>) {
+                put_string(value != nullptr ? std::string_view(value) : std::string_view("(null)"));
+            } else {
+                static_assert(std::is_convertible_v<const T&, std::string_view>,
+                              "Unsupported log argument; pass numbers or strings");
+                put_string(std::string_view(value));
+            }
+        }
+    };
+
+    Logger();
+
+    void submit(const Record& record);
+    void run();
+    std::size_t write_batch();
+    void write_record(const Record& record);
+    void format_record(const Record& record, std::string& out) const;
+
+    MpscQueue<Record> queue_{kQueueCapacity};
+    std::atomic<uint64_t> submitted_{0}; // Records accepted by the ring
+    std::atomic<uint64_t> written_{0};   // Records the writer thread has finished
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> stopping_{false};
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;    // Wakes the writer early (flush/shutdown)
+    std::condition_variable drained_; // Signals flush() callers
+    std::string line_;                // Writer thread's reusable format buffer
+    std::thread writer_;
+};
+
+} // namespace msf
+
+#if MSF_LOG_COMPILE_LEVEL > 0
+#define MSF_LOG_COMPILED_IN(level) (static_cast<int>(level) >= MSF_LOG_COMPILE_LEVEL)
+#else
+#define MSF_LOG_COMPILED_IN(level) true
+#endif
+
+// Log with an explicit level and tag, e.g. MSF_LOG(msf::LogLevel::Info, "EVENT", "...", args...)
+#define MSF_LOG(level, tag, ...)                                                              \
+    do {                                                                                      \
+        if (MSF_LOG_COMPILED_IN(level) && ::msf::log_enabled(level)) {                       \
+            ::msf::Logger::instance().log(level, tag, __VA_ARGS__);                           \
+        }                                                                                     \
+    } while (0)
+
+// Compiled-out statement: arguments are still type-checked but never evaluated
+#define MSF_LOG_DISCARD(level, tag, ...)                                                      \
+    do {                                                                                      \
+        if (false) {                                                                          \
+            ::msf::Logger::instance().log(level, tag, __VA_ARGS__);                           \
+        }                                                                                     \
+    } while (0)
+
+#if MSF_LOG_COMPILE_LEVEL <= 0
+#define MSF_LOG_DEBUG(...) MSF_LOG(::msf::LogLevel::Debug, "DEBUG", __VA_ARGS__)
+#else
+#define MSF_LOG_DEBUG(...) MSF_LOG_DISCARD(::msf::LogLevel::Debug, "DEBUG", __VA_ARGS__)
+#endif
+
+#if MSF_LOG_COMPILE_LEVEL <= 1
+#define MSF_LOG_INFO(...) MSF_LOG(::msf::LogLevel::Info, "INFO", __VA_ARGS__)
+#else
+#define MSF_LOG_INFO(...) MSF_LOG_DISCARD(::msf::LogLevel::Info, "INFO", __VA_ARGS__)
+#endif
+
+#if MSF_LOG_COMPILE_LEVEL <= 2
+#define MSF_LOG_WARNING(...) MSF_LOG(::msf::LogLevel::Warning, "WARNING", __VA_ARGS__)
+#else
+#define MSF_LOG_WARNING(...) MSF_LOG_DISCARD(::msf::LogLevel::Warning, "WARNING", __VA_ARGS__)
+#endif
+
+#if MSF_LOG_COMPILE_LEVEL <= 3
+#define MSF_LOG_ERROR(...) MSF_LOG(::msf::LogLevel::Error, "ERROR", __VA_ARGS__)
+#else
+#define MSF_LOG_ERROR(...) MSF_LOG_DISCARD(::msf::LogLevel::Error, "ERROR", __VA_ARGS__)
+#endif
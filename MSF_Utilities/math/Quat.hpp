@@ -3,6 +3,7 @@
 // Quaternion class definition
 #include <cmath>
 #include <iostream>
+#include "Logger.hpp"
 #include "Vec3.hpp"
 
 class Quat {
@@ -102,9 +103,15 @@ public:
         Quat result = (*this) * v_quat * this->conjugate();
         return Vec3(result.x, result.y, result.z);
     }
+    // Get the scalar (w) and vector (x, y, z) components
+    double get_w() const { return w; }
+    double get_x() const { return x; }
+    double get_y() const { return y; }
+    double get_z() const { return z; }
+
     // Print the quaternion (for debugging)
     void print() const {
-        std::cout << "Quat(" << w << ", " << x << ", " << y << ", " << z << ")" << std::endl;
+        MSF_LOG_DEBUG("Quat({}, {}, {}, {})", w, x, y, z);
     }
 private:
 
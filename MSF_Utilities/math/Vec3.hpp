@@ -4,6 +4,8 @@
 #include <cmath>
 #include <iostream>
 
+#include "Logger.hpp"
+
 class Vec3 {
 public:
     // Default constructor
@@ -81,7 +83,7 @@ public:
 
     // Print the vector (for debugging)
     void print() const {
-        std::cout << "Vec3(" << x << ", " << y << ", " << z << ")" << std::endl;
+        MSF_LOG_DEBUG("Vec3({}, {}, {})", x, y, z);
     }
 
 private:
@@ -0,0 +1,157 @@
+/*
+* @file:   BlockPool.hpp
+* @lib:    msfutil_libs
+* @brief:  Fixed-size block allocator with a shared_ptr-compatible allocator front end.
+* A BlockPool hands out raw blocks of one size, carved from chunks that are only freed when the
+* pool itself goes away. Freed blocks go onto an intrusive LIFO free list, so once the pool has
+* grown to its high-water mark allocate/deallocate never touch the global allocator.
+*
+* The block size is fixed by the first allocation. That fits std::allocate_shared, which makes one
+* allocation per object (control block and object together) of a size that depends only on the
+* object type: give every type its own pool and every allocation is the same size. Larger requests
+* fall back to operator new.
+*
+* PoolAllocator keeps its pool alive through a shared_ptr, and so does every object allocated with
+* it (allocate_shared stores the allocator in the control block). Objects may therefore outlive
+* whoever created the pool. Allocation and deallocation lock a mutex, so the last reference to a
+* pooled object may be dropped on any thread.
+*
+* @author: Brandon Coulter
+* @date:   2026-03-23
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace msf {
+
+class BlockPool {
+public:
+    explicit BlockPool(std::size_t blocks_per_chunk = 256) : blocks_per_chunk_(blocks_per_chunk) {}
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    ~BlockPool() {
+        for (void* chunk : chunks_) {
+            ::operator delete(chunk, std::align_val_t{kAlignment});
+        }
+    }
+
+    void* allocate(std::size_t size, std::size_t alignment) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (block_size_ == 0) {
+            block_size_ = round_up(std::max(size, sizeof(FreeBlock)));
+        }
+        if (!fits(size, alignment)) {
+            return ::operator new(size, std::align_val_t{alignment});
+        }
+        if (free_list_ == nullptr) {
+            grow();
+        }
+        FreeBlock* block = free_list_;
+        free_list_ = block->next;
+        ++live_count_;
+        return block;
+    }
+
+    void deallocate(void* pointer, std::size_t size, std::size_t alignment) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!fits(size, alignment)) {
+            ::operator delete(pointer, std::align_val_t{alignment});
+            return;
+        }
+        FreeBlock* block = static_cast<FreeBlock*>(pointer);
+        block->next = free_list_;
+        free_list_ = block;
+        --live_count_;
+    }
+
+    // Blocks currently handed out / blocks carved so far
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return live_count_;
+    }
+    std::size_t capacity() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return chunks_.size() * blocks_per_chunk_;
+    }
+    // 0 until the first allocation
+    std::size_t block_size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return block_size_;
+    }
+
+private:
+    static constexpr std::size_t kAlignment = alignof(std::max_align_t);
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static std::size_t round_up(std::size_t size) {
+        return (size + kAlignment - 1) / kAlignment * kAlignment;
+    }
+
+    bool fits(std::size_t size, std::size_t alignment) const {
+        return size <= block_size_ && alignment <= kAlignment;
+    }
+
+    // Carve one chunk and push its blocks so they are handed out in address order
+    void grow() {
+        auto* chunk = static_cast<unsigned char*>(::operator new(block_size_ * blocks_per_chunk_, std::align_val_t{kAlignment}));
+        chunks_.push_back(chunk);
+        for (std::size_t i = blocks_per_chunk_; i-- > 0;) {
+            FreeBlock* block = ::new (static_cast<void*>(chunk + i * block_size_)) FreeBlock{free_list_};
+            free_list_ = block;
+        }
+    }
+
+    mutable std::mutex mutex_;
+    std::size_t blocks_per_chunk_;
+    std::size_t block_size_ = 0;
+    std::vector<void*> chunks_;
+    FreeBlock* free_list_ = nullptr;
+    std::size_t live_count_ = 0;
+};
+
+// Standard allocator drawing from a BlockPool; use with std::allocate_shared.
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    explicit PoolAllocator(std::shared_ptr<BlockPool> pool) : pool_(std::move(pool)) {}
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) : pool_(other.pool()) {}
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(pool_->allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* pointer, std::size_t count) {
+        pool_->deallocate(pointer, count * sizeof(T), alignof(T));
+    }
+
+    const std::shared_ptr<BlockPool>& pool() const {
+        return pool_;
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const {
+        return pool_ == other.pool();
+    }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const {
+        return pool_ != other.pool();
+    }
+
+private:
+    std::shared_ptr<BlockPool> pool_;
+};
+
+} // namespace msf
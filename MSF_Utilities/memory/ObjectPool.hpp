@@ -0,0 +1,139 @@
+/*
+* @file:   ObjectPool.hpp
+* @lib:    msfutil_libs
+* @brief:  Chunked, index-addressable object pool with an intrusive free list.
+* Objects live in fixed-size chunks that are never moved or freed until the pool is destroyed, so
+* both pointers and 32-bit indices stay valid for an object's whole lifetime. Released slots are
+* recycled LIFO; once the pool has grown to its high-water mark acquire/release never allocate.
+* Every slot carries a generation that is bumped on release, so (index, generation) pairs can be
+* handed out as handles and checked for staleness after the slot is reused.
+*
+* @author: Brandon Coulter
+* @date:   2026-03-10
+*/
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace msf {
+
+template <typename T, std::size_t ChunkSize = 1024>
+class ObjectPool {
+public:
+    static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    ~ObjectPool() {
+        for (uint32_t index = 0; index < capacity(); ++index) {
+            if (slot(index).live) {
+                object(index).~T();
+            }
+        }
+    }
+
+    // Construct a T in a free slot and return its index.
+    template <typename... Args>
+    uint32_t acquire(Args&&... args) {
+        if (free_list_ == kInvalidIndex) {
+            grow();
+        }
+        const uint32_t index = free_list_;
+        Slot& entry = slot(index);
+        free_list_ = entry.next_free;
+        ::new (static_cast<void*>(entry.storage)) T(std::forward<Args>(args)...);
+        entry.live = true;
+        ++live_count_;
+        return index;
+    }
+
+    // Destroy the object at index and return its slot to the free list.
+    void release(uint32_t index) {
+        Slot& entry = slot(index);
+        assert(entry.live);
+        object(index).~T();
+        entry.live = false;
+        ++entry.generation;
+        entry.next_free = free_list_;
+        free_list_ = index;
+        --live_count_;
+    }
+
+    T& operator[](uint32_t index) {
+        return object(index);
+    }
+    const T& operator[](uint32_t index) const {
+        return *std::launder(reinterpret_cast<const T*>(slot(index).storage));
+    }
+
+    bool is_live(uint32_t index) const {
+        return index < capacity() && slot(index).live;
+    }
+
+    // Generation of the slot at index; changes every time the object in it is released.
+    uint32_t generation(uint32_t index) const {
+        return slot(index).generation;
+    }
+
+    // True if index is live and has not been released since generation was read.
+    bool is_current(uint32_t index, uint32_t generation) const {
+        return is_live(index) && slot(index).generation == generation;
+    }
+
+    // Pre-allocate chunks so at least `count` objects can be live without growing.
+    void reserve(std::size_t count) {
+        while (capacity() < count) {
+            grow();
+        }
+    }
+
+    std::size_t size() const {
+        return live_count_;
+    }
+    uint32_t capacity() const {
+        return static_cast<uint32_t>(chunks_.size() * ChunkSize);
+    }
+
+private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        uint32_t next_free = kInvalidIndex;
+        uint32_t generation = 0;
+        bool live = false;
+    };
+
+    Slot& slot(uint32_t index) {
+        return chunks_[index / ChunkSize][index % ChunkSize];
+    }
+    const Slot& slot(uint32_t index) const {
+        return chunks_[index / ChunkSize][index % ChunkSize];
+    }
+    T& object(uint32_t index) {
+        return *std::launder(reinterpret_cast<T*>(slot(index).storage));
+    }
+
+    // Add one chunk and thread its slots onto the free list in ascending index order.
+    void grow() {
+        const uint32_t base = capacity();
+        chunks_.push_back(std::make_unique<Slot[]>(ChunkSize));
+        Slot* chunk = chunks_.back().get();
+        for (std::size_t i = ChunkSize; i-- > 0;) {
+            chunk[i].next_free = free_list_;
+            free_list_ = base + static_cast<uint32_t>(i);
+        }
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    uint32_t free_list_ = kInvalidIndex;
+    std::size_t live_count_ = 0;
+};
+
+} // namespace msf
@@ -0,0 +1,134 @@
+/*
+* @file:   LatencyHistogram.hpp
+* @lib:    msfutil_libs
+* @brief:  Fixed-size log-linear (HDR-style) histogram of nanosecond latencies.
+* Values below 2^kSubBucketBits get a bucket each; above that every power of two is split into
+* 2^kSubBucketBits linear sub-buckets, so any recorded value is known to within 1/128 (< 0.8%) up
+* to kMaxTrackableNs. Recording is a few shifts and one counter bump, with no allocation.
+* One thread records; any thread may query percentiles at the same time. Counters are relaxed
+* atomics, so a concurrent query sees a slightly stale but never torn histogram.
+*
+* @author: Brandon Coulter
+* @date:   2026-03-23
+*/
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace msf {
+
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 7;
+    static constexpr uint64_t kSubBucketCount = uint64_t{1} << kSubBucketBits;
+    static constexpr unsigned kMaxValueBits = 42; // ~73 minutes in nanoseconds
+    static constexpr uint64_t kMaxTrackableNs = (uint64_t{1} << kMaxValueBits) - 1;
+    static constexpr std::size_t kBucketCount = (kMaxValueBits - kSubBucketBits + 1) * kSubBucketCount;
+
+    LatencyHistogram() {
+        reset();
+    }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    // Recording thread only. Values above kMaxTrackableNs land in the top bucket; max() stays exact.
+    void record(uint64_t ns) {
+        bump(counts_[bucket_index(std::min(ns, kMaxTrackableNs))]);
+        bump(count_);
+        sum_ns_.store(sum_ns_.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+        if (ns > max_ns_.load(std::memory_order_relaxed)) {
+            max_ns_.store(ns, std::memory_order_relaxed);
+        }
+        if (ns < min_ns_.load(std::memory_order_relaxed)) {
+            min_ns_.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    // Not safe while another thread records
+    void reset() {
+        for (auto& count : counts_) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_ns_.store(0, std::memory_order_relaxed);
+        max_ns_.store(0, std::memory_order_relaxed);
+        min_ns_.store(UINT64_MAX, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const {
+        return count_.load(std::memory_order_relaxed);
+    }
+    uint64_t max() const {
+        return max_ns_.load(std::memory_order_relaxed);
+    }
+    uint64_t min() const {
+        const uint64_t count = this->count();
+        return count ? min_ns_.load(std::memory_order_relaxed) : 0;
+    }
+    double mean() const {
+        const uint64_t count = this->count();
+        return count ? static_cast<double>(sum_ns_.load(std::memory_order_relaxed)) / count : 0.0;
+    }
+
+    // Smallest value v such that at least `percent`% of the recordings are <= v, reported as the upper
+    // edge of v's bucket and capped at max(). percentile(100) == max().
+    uint64_t percentile(double percent) const {
+        uint64_t total = 0;
+        for (const auto& count : counts_) {
+            total += count.load(std::memory_order_relaxed);
+        }
+        if (total == 0) {
+            return 0;
+        }
+        const double clamped = std::clamp(percent, 0.0, 100.0);
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(clamped / 100.0 * total + 0.5));
+        uint64_t seen = 0;
+        for (std::size_t index = 0; index < kBucketCount; ++index) {
+            seen += counts_[index].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                return std::min(bucket_upper_edge(index), max());
+            }
+        }
+        return max();
+    }
+
+    static std::size_t bucket_index(uint64_t ns) {
+        if (ns < kSubBucketCount) {
+            return static_cast<std::size_t>(ns);
+        }
+        const unsigned exponent = highest_bit(ns) - kSubBucketBits; // ns >> exponent is in [S, 2S)
+        return static_cast<std::size_t>((exponent + 1) * kSubBucketCount + ((ns >> exponent) - kSubBucketCount));
+    }
+
+    // Largest value that maps to bucket `index`
+    static uint64_t bucket_upper_edge(std::size_t index) {
+        if (index < kSubBucketCount) {
+            return index;
+        }
+        const unsigned exponent = static_cast<unsigned>(index / kSubBucketCount) - 1;
+        const uint64_t mantissa = kSubBucketCount + index % kSubBucketCount;
+        return ((mantissa + 1) << exponent) - 1;
+    }
+
+private:
+    static unsigned highest_bit(uint64_t value) {
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+    }
+
+    // Single writer: a plain load/store pair instead of a locked read-modify-write
+    static void bump(std::atomic<uint64_t>& counter) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, kBucketCount> counts_;
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_ns_{0};
+    std::atomic<uint64_t> max_ns_{0};
+    std::atomic<uint64_t> min_ns_{UINT64_MAX};
+};
+
+} // namespace msf
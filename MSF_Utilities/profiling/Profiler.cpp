@@ -0,0 +1,240 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+#include "Logger.hpp"
+
+namespace msf {
+
+namespace {
+
+std::string demangle(const char* mangled) {
+#if defined(__GNUG__)
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (status == 0 && demangled != nullptr) {
+        std::string name(demangled);
+        std::free(demangled);
+        return name;
+    }
+#endif
+    return mangled;
+}
+
+// Chrome trace names are JSON strings
+void write_json_string(std::FILE* file, const char* text) {
+    std::fputc('"', file);
+    for (const char* c = text; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            std::fputc('\\', file);
+            std::fputc(*c, file);
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            std::fprintf(file, "\\u%04x", static_cast<unsigned>(*c));
+        } else {
+            std::fputc(*c, file);
+        }
+    }
+    std::fputc('"', file);
+}
+
+} // namespace
+
+const char* profile_category_name(ProfileCategory category) {
+    switch (category) {
+        case ProfileCategory::Phase:
+            return "phase";
+        case ProfileCategory::EntityClass:
+            return "entity";
+        case ProfileCategory::EventType:
+            return "event";
+    }
+    return "unknown";
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : epoch_ns_(now_ns()) {}
+
+void Profiler::enable_trace(const std::string& path, uint64_t max_ticks) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    trace_path_ = path;
+    trace_ticks_ = max_ticks;
+    tracing_.store(!path.empty() && max_ticks > 0, std::memory_order_relaxed);
+}
+
+void Profiler::record(const char* name, ProfileCategory category, uint64_t start_ns, uint64_t end_ns) {
+    ThreadBuffer& buffer = thread_buffer();
+    const uint64_t duration = end_ns - start_ns;
+
+    Accumulator& stat = buffer.stats[static_cast<std::size_t>(category)][name];
+    ++stat.count;
+    stat.total_ns += duration;
+    stat.min_ns = std::min(stat.min_ns, duration);
+    stat.max_ns = std::max(stat.max_ns, duration);
+
+    // Entity classes are summary-only: one trace event per entity update would swamp the trace
+    if (category != ProfileCategory::EntityClass && tracing_.load(std::memory_order_relaxed)
+        && tick_.load(std::memory_order_relaxed) <= trace_ticks_) {
+        buffer.trace.push_back(TraceEvent{name, category, start_ns, duration});
+    }
+}
+
+const char* Profiler::intern(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return names_.insert(name).first->c_str();
+}
+
+const char* Profiler::type_name(const std::type_info& type) {
+    // Interned names are never released, so the cache stays valid across reset()
+    thread_local std::vector<std::pair<const std::type_info*, const char*>> cache;
+    for (const auto& entry : cache) {
+        if (*entry.first == type) {
+            return entry.second;
+        }
+    }
+    const char* name = intern(demangle(type.name()));
+    cache.emplace_back(&type, name);
+    return name;
+}
+
+Profiler::ThreadBuffer& Profiler::thread_buffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    thread_local uint64_t buffer_generation = 0;
+
+    const uint64_t generation = generation_.load(std::memory_order_acquire);
+    if (buffer == nullptr || buffer_generation != generation) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto owned = std::make_unique<ThreadBuffer>();
+        owned->thread_index = static_cast<uint32_t>(buffers_.size());
+        buffer = owned.get();
+        buffers_.push_back(std::move(owned));
+        buffer_generation = generation;
+    }
+    return *buffer;
+}
+
+std::vector<ProfileStat> Profiler::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Names are merged by content: the same literal can have a different address in each translation unit
+    std::vector<ProfileStat> merged;
+    std::unordered_map<std::string, std::size_t> index[kProfileCategoryCount];
+    for (const auto& buffer : buffers_) {
+        for (std::size_t category = 0; category < kProfileCategoryCount; ++category) {
+            for (const auto& [name, stat] : buffer->stats[category]) {
+                auto [it, inserted] = index[category].emplace(name, merged.size());
+                if (inserted) {
+                    ProfileStat entry;
+                    entry.name = name;
+                    entry.category = static_cast<ProfileCategory>(category);
+                    merged.push_back(std::move(entry));
+                }
+                ProfileStat& total = merged[it->second];
+                total.count += stat.count;
+                total.total_ns += stat.total_ns;
+                total.min_ns = std::min(total.min_ns, stat.min_ns);
+                total.max_ns = std::max(total.max_ns, stat.max_ns);
+            }
+        }
+    }
+
+    std::sort(merged.begin(), merged.end(), [](const ProfileStat& a, const ProfileStat& b) {
+        if (a.category != b.category) {
+            return a.category < b.category;
+        }
+        return a.total_ns > b.total_ns;
+    });
+    return merged;
+}
+
+void Profiler::report() const {
+    const std::vector<ProfileStat> stats = get_stats();
+    if (stats.empty()) {
+        return;
+    }
+
+    // Percentages are relative to the "tick" phase when the loop recorded one
+    uint64_t tick_ns = 0;
+    for (const ProfileStat& stat : stats) {
+        if (stat.category == ProfileCategory::Phase && stat.name == "tick") {
+            tick_ns = stat.total_ns;
+        }
+    }
+
+    MSF_LOG_INFO("Profiler summary: {} ticks", get_tick_count());
+    char line[200];
+    std::snprintf(line, sizeof(line), "  %-7s %-28s %10s %11s %10s %10s %10s %7s", "type", "name", "calls",
+                  "total ms", "mean us", "min us", "max us", "% tick");
+    MSF_LOG_INFO("{}", line);
+    for (const ProfileStat& stat : stats) {
+        const double mean_us = stat.count ? stat.total_ns / 1e3 / static_cast<double>(stat.count) : 0.0;
+        const double share = tick_ns ? 100.0 * static_cast<double>(stat.total_ns) / static_cast<double>(tick_ns) : 0.0;
+        std::snprintf(line, sizeof(line), "  %-7s %-28.28s %10llu %11.3f %10.3f %10.3f %10.3f %7.2f",
+                      profile_category_name(stat.category), stat.name.c_str(),
+                      static_cast<unsigned long long>(stat.count), stat.total_ns / 1e6, mean_us, stat.min_ns / 1e3,
+                      stat.max_ns / 1e3, share);
+        MSF_LOG_INFO("{}", line);
+    }
+}
+
+bool Profiler::write_trace() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (trace_path_.empty()) {
+        return true;
+    }
+
+    std::FILE* file = std::fopen(trace_path_.c_str(), "w");
+    if (file == nullptr) {
+        MSF_LOG_ERROR("Failed to open profiler trace file: {}", trace_path_);
+        return false;
+    }
+
+    std::size_t events = 0;
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+    bool first = true;
+    for (const auto& buffer : buffers_) {
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                     first ? "" : ",\n", buffer->thread_index, buffer->thread_index);
+        first = false;
+        for (const TraceEvent& event : buffer->trace) {
+            std::fputs(",\n{\"name\":", file);
+            write_json_string(file, event.name);
+            // Complete events; timestamps are microseconds since the profiler was created
+            std::fprintf(file, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                         profile_category_name(event.category), buffer->thread_index,
+                         (event.start_ns - epoch_ns_) / 1e3, event.duration_ns / 1e3);
+            ++events;
+        }
+    }
+    std::fputs("\n]}\n", file);
+
+    const bool ok = std::ferror(file) == 0;
+    if (std::fclose(file) != 0 || !ok) {
+        MSF_LOG_ERROR("Failed to write profiler trace file: {}", trace_path_);
+        return false;
+    }
+    MSF_LOG_INFO("Wrote {} trace events for the first {} ticks to {}", events, trace_ticks_, trace_path_);
+    return true;
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.clear();
+    generation_.fetch_add(1, std::memory_order_release);
+    tick_.store(0, std::memory_order_relaxed);
+    tracing_.store(false, std::memory_order_relaxed);
+    trace_ticks_ = 0;
+    trace_path_.clear();
+}
+
+} // namespace msf
@@ -0,0 +1,205 @@
+/*
+* @file:   Profiler.hpp
+* @lib:    msfutil_libs
+* @brief:  Scoped wall-time profiler with a shutdown summary and Chrome/Perfetto trace export.
+* Timers record into per-thread buffers, so entity updates on pool threads never contend. Each
+* record adds to a count/total/min/max entry keyed by (category, name); while a trace is active the
+* first N ticks are also kept as individual events and written as Chrome trace JSON
+* (open in chrome://tracing or ui.perfetto.dev). Entity class timings only go into the summary.
+*
+* Use the macros rather than ProfileScope directly:
+*     MSF_PROFILE_SCOPE("process_events");
+*     MSF_PROFILE_SCOPE_CATEGORY(name, msf::ProfileCategory::EventType);
+*     if (MSF_PROFILE_ACTIVE()) { ...per-entity timing... }
+* Names must outlive the profiler: string literals or pointers from Profiler::intern(). With the
+* meson `profiling` option off (MSF_PROFILING=0) the macros compile to nothing; when compiled in
+* but not enabled at runtime a scope costs one relaxed atomic load.
+*
+* report() and write_trace() read every thread's buffer without locking it, so call them once the
+* worker threads are idle (e.g. at shutdown).
+*
+* @author: Brandon Coulter
+* @date:   2026-03-18
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// 1 = profiling scopes compiled in, 0 = compiled out. Set by the meson `profiling` option.
+#ifndef MSF_PROFILING
+#define MSF_PROFILING 1
+#endif
+
+namespace msf {
+
+enum class ProfileCategory : uint8_t {
+    Phase = 0,       // Controller loop phases and other code regions
+    EntityClass = 1, // Entity::update, grouped by dynamic class
+    EventType = 2,   // Scheduled event callbacks, grouped by event description
+};
+constexpr std::size_t kProfileCategoryCount = 3;
+
+const char* profile_category_name(ProfileCategory category);
+
+// Aggregated timings for one (category, name)
+struct ProfileStat {
+    std::string name;
+    ProfileCategory category = ProfileCategory::Phase;
+    uint64_t count = 0;
+    uint64_t total_ns = 0;
+    uint64_t min_ns = UINT64_MAX;
+    uint64_t max_ns = 0;
+};
+
+namespace detail {
+// Runtime switch, kept outside the Profiler so a disabled scope never touches the singleton
+inline std::atomic<bool> g_profiler_enabled{false};
+} // namespace detail
+
+class Profiler {
+public:
+    static constexpr uint64_t kDefaultTraceTicks = 100;
+
+    static Profiler& instance();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static bool is_enabled() {
+        return detail::g_profiler_enabled.load(std::memory_order_relaxed);
+    }
+    void set_enabled(bool enabled) {
+        detail::g_profiler_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    // Also keep individual events for the first max_ticks ticks and write them to path on write_trace()
+    void enable_trace(const std::string& path, uint64_t max_ticks = kDefaultTraceTicks);
+
+    // Mark the start of a simulation tick (drives the trace window)
+    void begin_tick() {
+        tick_.fetch_add(1, std::memory_order_relaxed);
+    }
+    uint64_t get_tick_count() const {
+        return tick_.load(std::memory_order_relaxed);
+    }
+
+    // Add one timed interval. name must stay valid for the profiler's lifetime.
+    void record(const char* name, ProfileCategory category, uint64_t start_ns, uint64_t end_ns);
+
+    // Stable copy of a runtime string (entity class, event description) for use as a timer name
+    const char* intern(const std::string& name);
+    // Demangled, interned name of a dynamic type. Cached per thread, so cheap on the update path.
+    const char* type_name(const std::type_info& type);
+
+    // Merged statistics from every thread, sorted by category then total time (largest first)
+    std::vector<ProfileStat> get_stats() const;
+
+    // Log the summary table; no-op if nothing was recorded
+    void report() const;
+
+    // Write the Chrome trace JSON if a trace was requested; returns false on I/O failure
+    bool write_trace() const;
+
+    // Drop all recorded data and trace settings (tests)
+    void reset();
+
+    // Monotonic nanoseconds used by every timer
+    static uint64_t now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+private:
+    struct Accumulator {
+        uint64_t count = 0;
+        uint64_t total_ns = 0;
+        uint64_t min_ns = UINT64_MAX;
+        uint64_t max_ns = 0;
+    };
+
+    struct TraceEvent {
+        const char* name;
+        ProfileCategory category;
+        uint64_t start_ns;
+        uint64_t duration_ns;
+    };
+
+    // Owned by the profiler, written only by its thread
+    struct ThreadBuffer {
+        uint32_t thread_index = 0;
+        std::unordered_map<const char*, Accumulator> stats[kProfileCategoryCount];
+        std::vector<TraceEvent> trace;
+    };
+
+    Profiler();
+
+    ThreadBuffer& thread_buffer();
+
+    const uint64_t epoch_ns_;
+    std::atomic<uint64_t> tick_{0};
+    std::atomic<uint64_t> generation_{0}; // Bumped by reset() so threads drop their cached buffer
+
+    // Trace window: events are kept until more than trace_ticks_ ticks have begun
+    std::atomic<bool> tracing_{false};
+    uint64_t trace_ticks_ = 0;
+    std::string trace_path_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    std::unordered_set<std::string> names_; // Interned names; node-based, so c_str() stays valid
+};
+
+// RAII timer behind MSF_PROFILE_SCOPE
+class ProfileScope {
+public:
+    // A null name disables the scope, so callers can skip building a name while the profiler is off
+    ProfileScope(const char* name, ProfileCategory category)
+        : name_(name), category_(category),
+          start_ns_(name != nullptr && Profiler::is_enabled() ? Profiler::now_ns() : 0) {}
+
+    ~ProfileScope() {
+        if (start_ns_ != 0) {
+            Profiler::instance().record(name_, category_, start_ns_, Profiler::now_ns());
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name_;
+    ProfileCategory category_;
+    uint64_t start_ns_; // 0 when the profiler was disabled at scope entry
+};
+
+} // namespace msf
+
+#define MSF_PROFILE_JOIN_IMPL(a, b) a##b
+#define MSF_PROFILE_JOIN(a, b) MSF_PROFILE_JOIN_IMPL(a, b)
+
+#if MSF_PROFILING
+#define MSF_PROFILE_ACTIVE() ::msf::Profiler::is_enabled()
+#define MSF_PROFILE_SCOPE_CATEGORY(name, category) \
+    ::msf::ProfileScope MSF_PROFILE_JOIN(msf_profile_scope_, __LINE__)(name, category)
+#define MSF_PROFILE_TICK()                            \
+    do {                                              \
+        if (::msf::Profiler::is_enabled()) {          \
+            ::msf::Profiler::instance().begin_tick(); \
+        }                                             \
+    } while (false)
+#else
+#define MSF_PROFILE_ACTIVE() false
+#define MSF_PROFILE_SCOPE_CATEGORY(name, category) static_cast<void>(0)
+#define MSF_PROFILE_TICK() static_cast<void>(0)
+#endif
+
+#define MSF_PROFILE_SCOPE(name) MSF_PROFILE_SCOPE_CATEGORY(name, ::msf::ProfileCategory::Phase)
@@ -12,15 +12,29 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
-#include <functional>
 
+#include "EntityHandle.hpp"
+#include "EntityHandleQueue.hpp"
+#include "EventHandle.hpp"
 #include "EventRequest.hpp"
+#include "RandomStream.hpp"
+#include "StateStream.hpp"
 #include "Vec3.hpp"
 #include "Quat.hpp"
 
+// How the tick loop treats an entity. Only Active entities are updated and integrated each tick;
+// Static entities never move (e.g. waypoints) and Sleeping ones wait for an event to wake them.
+enum class ActivityState : uint8_t {
+    Active,
+    Sleeping,
+    Static,
+};
+
 class Entity {
 
 public:
@@ -42,9 +56,64 @@ public:
         return entity_name;
     }
 
-    // Set the shutdown callback that notifies the registry when this entity shuts down
-    void set_shutdown_callback(std::function<void(int)> callback) {
-        shutdown_callback = callback;
+    // Handle of this entity in the registry it is registered with (invalid while unregistered)
+    EntityHandle get_handle() const {
+        return entity_handle;
+    }
+
+    // Called by the registry on registration: the handle plus the queues this entity reports pending
+    // event requests and shutdown to, the counter it bumps when its activity or update rate changes
+    // and the run seed its random streams are keyed with. detach_registry() undoes it.
+    void attach_registry(EntityHandle handle, EntityHandleQueue* events, EntityHandleQueue* removals,
+                         std::atomic<uint64_t>* tick_changes, const uint64_t* seed) {
+        entity_handle = handle;
+        event_queue = events;
+        removal_queue = removals;
+        tick_change_counter = tick_changes;
+        run_seed = seed;
+        removal_requested.store(false, std::memory_order_relaxed);
+    }
+    void detach_registry() {
+        attach_registry(EntityHandle{}, nullptr, nullptr, nullptr, nullptr);
+    }
+
+    // Random numbers for this entity, keyed by (run seed, entity ID, stream) and drawn per tick, e.g.
+    // random_stream(kSensorNoise).fill_normal(msf::RandomStream::tick_of(t, dt), noise, 3). Draws are the
+    // same whatever thread updates the entity; unregistered entities use seed 0.
+    msf::RandomStream random_stream(uint32_t stream) const {
+        return msf::RandomStream(run_seed != nullptr ? *run_seed : 0, static_cast<uint64_t>(entity_id), stream);
+    }
+
+    // Activity state (see ActivityState). Changes take effect from the next tick, so entities may
+    // put themselves to sleep from update() and events may wake them.
+    void set_activity(ActivityState state) {
+        if (activity.exchange(state, std::memory_order_relaxed) != state) {
+            notify_tick_change();
+        }
+    }
+    ActivityState get_activity() const {
+        return activity.load(std::memory_order_relaxed);
+    }
+    bool is_active() const {
+        return get_activity() == ActivityState::Active;
+    }
+
+    // Requested update rate in Hz of simulation time; 0 (the default) updates every tick. The tick
+    // engine rounds it up to a harmonic rate group, so update() then receives that group's dt.
+    // Model classes may set a default in their constructor; SCF <EntityParameters> override it.
+    void set_update_rate(double rate_hz) {
+        if (update_rate_hz.exchange(rate_hz, std::memory_order_relaxed) != rate_hz) {
+            notify_tick_change();
+        }
+    }
+    double get_update_rate() const {
+        return update_rate_hz.load(std::memory_order_relaxed);
+    }
+
+    // Ask the registry to remove this entity at its next safe point. Safe to call from update().
+    void request_removal();
+    bool is_removal_requested() const {
+        return removal_requested.load(std::memory_order_relaxed);
     }
 
     // Virtual functions
@@ -52,20 +121,66 @@ public:
     virtual std::unique_ptr<Entity> create() = 0;
     virtual void update(const double t, const double dt) = 0; // Pure virtual function to be implemented by derived classes
     virtual void shutdown();
-    virtual void request_event(const EventRequest& event_request); // Event request function
+    virtual void request_event(EventRequest event_request); // Event request function
     virtual void set_position(const Vec3& new_position) = 0;
     virtual Vec3 get_position() const = 0;
     virtual void set_orientation(const Quat& new_orientation) = 0;
     virtual Quat get_orientation() const = 0;
+    // Pose as of the start of the current tick; what other entities should read during their update()
+    // (see PhysicsStore::Snapshot). Entities without per-tick state just return their live pose.
+    virtual Vec3 get_snapshot_position() const {
+        return get_position();
+    }
+    virtual Quat get_snapshot_orientation() const {
+        return get_orientation();
+    }
+    // True for classes whose update() reads other entities. Registering one turns on the registry's
+    // per-tick snapshot; without it get_snapshot_* return the live state.
+    virtual bool reads_other_entities() const {
+        return false;
+    }
+
+    // Checkpointing: write the entity's state, and read it back into a freshly created entity of the
+    // same class. The base class covers the name, activity state and update rate; overrides write their
+    // own state after calling the base version.
+    virtual void save_state(StateWriter& out) const;
+    virtual void load_state(StateReader& in);
+
+    // ID the next entity constructed on this thread will get. Restoring a checkpoint sets it before
+    // re-creating each entity, so entities keep their IDs, and then to the saved value so later spawns
+    // match too. Batch replicas reset it to 0 so each one numbers its entities like a standalone run.
+    static int get_next_id() {
+        return id_counter;
+    }
+    static void set_next_id(int id) {
+        id_counter = id;
+    }
 
     // Object Variables
     // Object to hold the events requested by entities
     std::vector<EventRequest> pending_events;
+    // Handles of events scheduled on this entity's behalf; cancelled when the entity leaves the registry
+    std::vector<EventHandle> scheduled_events;
 
 protected:
-    static std::atomic<int> id_counter; // Static counter for generating unique IDs
+    void notify_tick_change() {
+        if (tick_change_counter != nullptr) {
+            tick_change_counter->fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Counter for generating unique IDs. One per thread: entities are only created on the simulation
+    // thread, so every simulation running on its own thread gets its own ID space.
+    static thread_local int id_counter;
     const int entity_id; // Unique ID for this entity
     std::string entity_name; // Name of the entity (optional)
-    std::function<void(int)> shutdown_callback; // Callback to notify registry of shutdown
+    EntityHandle entity_handle; // Slot of this entity in its registry
+    EntityHandleQueue* event_queue = nullptr; // Registry dirty list, told when pending_events becomes non-empty
+    EntityHandleQueue* removal_queue = nullptr; // Registry removal list, told when this entity shuts down
+    std::atomic<bool> removal_requested{false}; // Set once the handle has been queued for removal
+    std::atomic<uint64_t>* tick_change_counter = nullptr; // Registry counter, bumped when activity or rate changes
+    const uint64_t* run_seed = nullptr; // Registry run seed, see random_stream()
+    std::atomic<ActivityState> activity{ActivityState::Active}; // Whether the tick loop updates this entity
+    std::atomic<double> update_rate_hz{0.0}; // Requested update rate, 0 = every tick
 
 };
\ No newline at end of file
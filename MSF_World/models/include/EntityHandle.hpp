@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdint>
+
+// Lightweight reference to an entity registered in an EntityRegistry.
+// The generation makes handles to removed entities harmless: lookups through a stale handle return
+// nullptr even after the registry has reused the slot for another entity.
+struct EntityHandle {
+    uint32_t index = UINT32_MAX; // Slot of the entity in the registry's slot map
+    uint32_t generation = 0; // Slot generation when the entity was registered
+
+    bool is_valid() const {
+        return index != UINT32_MAX;
+    }
+
+    bool operator==(const EntityHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const EntityHandle& other) const {
+        return !(*this == other);
+    }
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+#include "EntityHandle.hpp"
+#include "MpscQueue.hpp"
+
+// Registry-wide list of entity handles queued from any thread for the registry to act on.
+// The registry keeps two of these: entities with event requests waiting to be scheduled (drained
+// once per tick, so collecting requests costs O(requesting entities) instead of O(all entities)),
+// and entities waiting to be removed (shutdown can't remove an entity while the registry is being
+// iterated, so it queues the handle for EntityRegistry::apply_pending_removals). If the ring ever
+// fills up the queue only remembers that it overflowed; each entity also records its own state, so
+// the registry recovers with one full scan.
+class EntityHandleQueue {
+public:
+    explicit EntityHandleQueue(size_t capacity) : handles(capacity) {}
+
+    // Producer side: queue a handle, or flag an overflow if the ring is full
+    void push(EntityHandle handle) {
+        if (!handles.push(handle)) {
+            overflowed.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    // Consumer side: pop the next queued handle
+    bool pop(EntityHandle& handle) {
+        return handles.pop(handle);
+    }
+
+    // Consumer side: true while handles are queued or were dropped
+    bool has_pending() const {
+        return !handles.empty() || overflowed.load(std::memory_order_relaxed);
+    }
+
+    // True (once) if handles were dropped since the last call; the caller must then scan every entity
+    bool take_overflow() {
+        return overflowed.exchange(false, std::memory_order_relaxed);
+    }
+
+    // Drop everything queued, including the overflow flag
+    void clear() {
+        EntityHandle ignored;
+        while (handles.pop(ignored)) {
+        }
+        take_overflow();
+    }
+
+private:
+    msf::MpscQueue<EntityHandle> handles;
+    std::atomic<bool> overflowed{false};
+};
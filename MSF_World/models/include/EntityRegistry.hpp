@@ -6,129 +6,397 @@
 * remove, and retrieve entities based on their unique identifiers. The registry ensures that all
 * entities are properly tracked and can be accessed efficiently during the simulation.
 *
+* Entities live in a slot map: a dense, contiguous array of entities (iterated in a deterministic
+* order that depends only on the sequence of registrations and removals) plus a sparse array of
+* slots that generational EntityHandles index in O(1). Removal is deferred: remove_entity() and
+* Entity::shutdown() only queue the entity, and apply_pending_removals() takes it out at a safe point
+* between ticks, so entities can shut down during iteration or from parallel update workers.
+*
+* Entities created through the registry (class factories, spawn) are allocated from one BlockPool per
+* model class, so scenarios that spawn and despawn thousands of entities mid-run recycle storage
+* instead of going back to the global allocator every time.
+*
+* Classes added with register_class/register_update_class also get an update bucket: the tick
+* snapshot (collect_entities) groups entities by concrete class, and each registered class is
+* updated by one statically-typed loop that calls T::update directly, so the call can be inlined
+* and the branch predictor sees one type at a time. Unregistered (plugin) classes are updated
+* through the virtual Entity::update as before.
+*
+* Only Active entities (see ActivityState) are part of the update runs: the snapshot puts them
+* first and the tick engine never touches the Sleeping and Static ones that follow. Changing an
+* entity's activity (or update rate) changes get_revision(), so the snapshot is rebuilt on the next tick.
+*
 * @author Brandon Coulter
 * @date 2026-02-22
 */
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 #include <iostream>
+#include <sstream>
+#include <type_traits>
+#include <typeindex>
 #include <typeinfo>
 #include <functional>
 #include <map>
+#include <vector>
 
 // Demangling is GCC/Clang-specific; keep it for convenience.
 #include <cxxabi.h>
+#include <cstdint>
 #include <cstdlib>
 
+#include "BlockPool.hpp"
 #include "Entity.hpp"
+#include "EntityHandle.hpp"
+#include "EntityHandleQueue.hpp"
+#include "Logger.hpp"
+#include "PhysicsEntity.hpp"
 #include "Clock.hpp"
 #include "Scheduler.hpp"
 #include "Missile.hpp"
 #include "Waypoint.hpp"
 
-using CreateEntityFunc = std::function<std::unique_ptr<Entity>()>;
+using CreateEntityFunc = std::function<std::shared_ptr<Entity>()>;
 
 class EntityRegistry {
 public:
-    // Add an entity to the registry
-    void register_entity(std::shared_ptr<Entity> entity) {
-        entities_[entity->get_id()] = entity;
+    // Statically-typed update of count entities that all have the same concrete class
+    using UpdateBatchFn = void (*)(Entity* const* entities, std::size_t count, double t, double dt);
+
+    // Range [begin, end) of a collect_entities() list holding one update bucket. update is nullptr for
+    // the fallback bucket, whose entities must be updated through the virtual Entity::update.
+    struct UpdateRun {
+        std::size_t begin;
+        std::size_t end;
+        UpdateBatchFn update;
+    };
+
+    // Dirty-list slots; more requesting entities than this in one tick degrades to a full scan
+    static constexpr size_t kEventRequestQueueCapacity = 8192;
+    // Removal slots; more shutdowns than this between safe points degrades to a full scan
+    static constexpr size_t kRemovalQueueCapacity = 8192;
+    // Entities carved per pool chunk
+    static constexpr size_t kEntityPoolChunk = 256;
+
+    // Add an entity to the registry and return its handle
+    EntityHandle register_entity(std::shared_ptr<Entity> entity) {
+        const EntityHandle handle = allocate_slot();
+        slots_[handle.index].dense_index = static_cast<uint32_t>(dense_.size());
+        dense_.push_back(entity);
+        dense_slots_.push_back(handle.index);
+        map_id(entity->get_id(), handle);
+        ++revision_;
+
+        // Physics state moves into the registry's contiguous arrays for the lifetime of the registration
+        if (auto* physics = dynamic_cast<PhysicsEntity*>(entity.get())) {
+            physics->attach_physics_store(physics_store_);
+        }
+        if (entity->reads_other_entities()) {
+            physics_store_.enable_snapshot(); // Stays on for the rest of the run
+        }
 
-        // Set up shutdown callback so entity can notify us when it shuts down
-        entity->set_shutdown_callback([this](int id) {
-            std::cout << "[INFO] Entity with ID " << id
-                      << " has requested shutdown. Removing from registry." << std::endl;
-            this->remove_entity(id);
-        });
+        // Requests made before registration (e.g. SCF triggers) are picked up on the next collection.
+        // Shutdown is reported through the removal queue by handle.
+        entity->attach_registry(handle, &event_requests_, &removal_requests_, &tick_changes_, &run_seed_);
+        if (!entity->pending_events.empty()) {
+            event_requests_.push(handle);
+        }
 
-        std::cout << "[INFO] Registered entity: ID=" << entity->get_id()
-                  << ", Name='" << entity->get_name() << "'\n" << std::endl;
+        MSF_LOG_INFO("Registered entity: ID={}, Name='{}'\n", entity->get_id(), entity->get_name());
+        return handle;
     }
 
     void register_classes() {
-        entity_registry["missile"] = []() { return std::make_unique<Missile>("missile"); };
-        entity_registry["waypoint"] = []() { return std::make_unique<Waypoint>("waypoint"); };
+        register_class<Missile>("missile");
+        register_class<Waypoint>("waypoint");
     }
 
-    std::unique_ptr<Entity> create_entity_from_string(const std::string& class_name) {
+    // Make class_name creatable by name; instances are allocated from T's pool and updated by T's
+    // own update loop
+    template <typename T>
+    void register_class(const std::string& class_name) {
+        entity_registry[class_name] = [this, class_name]() -> std::shared_ptr<Entity> {
+            return make_pooled<T>(class_name);
+        };
+        class_names_[std::type_index(typeid(T))] = class_name;
+        register_update_class<T>();
+    }
+
+    // Give entities whose concrete class is exactly T their own devirtualized update loop.
+    // Subclasses of T are not covered; they fall back to virtual dispatch unless registered too.
+    template <typename T>
+    void register_update_class() {
+        static_assert(std::is_base_of<Entity, T>::value, "update classes must derive from Entity");
+        const auto inserted = update_buckets_.emplace(std::type_index(typeid(T)),
+                                                      static_cast<uint32_t>(bucket_updates_.size()));
+        if (inserted.second) {
+            bucket_updates_.push_back(&update_batch<T>);
+            ++revision_; // Cached snapshots are grouped by the old bucket set
+        }
+    }
+
+    // Create an unregistered entity of a registered class, named after the class
+    std::shared_ptr<Entity> create_entity_from_string(const std::string& class_name) {
         auto it = entity_registry.find(class_name);
         if (it != entity_registry.end()) {
             return it->second();
         } else {
-            std::cerr << "[ERROR] No factory function registered for class name: " << class_name << std::endl;
+            MSF_LOG_ERROR("No factory function registered for class name: {}", class_name);
             return nullptr;
         }
     }
 
-    // Remove an entity from the registry by ID
+    // Name entity's concrete class was registered under with register_class; empty for other classes
+    const std::string& get_class_name(const Entity& entity) const {
+        static const std::string unregistered;
+        const auto it = class_names_.find(std::type_index(typeid(entity)));
+        return it != class_names_.end() ? it->second : unregistered;
+    }
+
+    // Allocate an unregistered T from T's pool. Its storage returns to the pool when the last
+    // reference goes away; the pool itself lives until then, even past the registry.
+    template <typename T, typename... Args>
+    std::shared_ptr<T> make_pooled(Args&&... args) {
+        return std::allocate_shared<T>(msf::PoolAllocator<T>(entity_pool<T>()), std::forward<Args>(args)...);
+    }
+
+    // Runtime spawn: allocate a T from its pool and register it. Call from the simulation thread
+    // (event callbacks, between ticks), not from update(); request an event to spawn from an update.
+    template <typename T, typename... Args>
+    std::shared_ptr<T> spawn(Args&&... args) {
+        std::shared_ptr<T> entity = make_pooled<T>(std::forward<Args>(args)...);
+        register_entity(entity);
+        return entity;
+    }
+
+    // Runtime spawn by class name (see register_class); nullptr for unknown classes
+    std::shared_ptr<Entity> spawn_entity_from_string(const std::string& class_name, const std::string& name) {
+        std::shared_ptr<Entity> entity = create_entity_from_string(class_name);
+        if (entity) {
+            entity->set_name(name);
+            register_entity(entity);
+        }
+        return entity;
+    }
+
+    // Runtime despawn: same deferred removal as remove_entity. The entity's scheduled events are
+    // cancelled at the safe point and its storage goes back to its class pool once unreferenced.
+    void despawn(EntityHandle handle) {
+        remove_entity(handle);
+    }
+
+    // Pool backing T's entities, created on first use
+    template <typename T>
+    const std::shared_ptr<msf::BlockPool>& entity_pool() {
+        std::shared_ptr<msf::BlockPool>& pool = entity_pools_[std::type_index(typeid(T))];
+        if (!pool) {
+            pool = std::make_shared<msf::BlockPool>(kEntityPoolChunk);
+        }
+        return pool;
+    }
+
+    // Scheduler that owns the events requested by registered entities. Once attached, events still
+    // pending for an entity are cancelled when it is removed, so they can't fire on a dead entity.
+    void attach_scheduler(SimEventScheduler& scheduler) {
+        scheduler_ = &scheduler;
+    }
+
+    // Seed of the run, keying every registered entity's random streams (Entity::random_stream). Set it
+    // before the first tick; changing it mid-run changes all later draws.
+    void set_run_seed(uint64_t seed) {
+        run_seed_ = seed;
+    }
+    uint64_t get_run_seed() const {
+        return run_seed_;
+    }
+
+    // Queue an entity for removal; it stays registered until the next apply_pending_removals()
+    void remove_entity(EntityHandle handle) {
+        if (Entity* entity = resolve(handle)) {
+            entity->request_removal();
+        }
+    }
     void remove_entity(int id) {
-        entities_.erase(id);
+        remove_entity(get_handle(id));
+    }
+
+    // Safe point: remove every entity queued since the last call, cancelling its scheduled events
+    // and releasing its physics slot. Returns the number of entities removed.
+    size_t apply_pending_removals() {
+        size_t removed = 0;
+        if (removal_requests_.take_overflow()) {
+            // The queue dropped handles; every requester still has its flag set, so scan for them
+            removal_requests_.clear();
+            for (size_t i = 0; i < dense_.size();) {
+                if (dense_[i]->is_removal_requested()) {
+                    erase_slot(dense_slots_[i]); // Swap-remove; the entity moved into i is checked next
+                    ++removed;
+                } else {
+                    ++i;
+                }
+            }
+            return removed;
+        }
+
+        EntityHandle handle;
+        while (removal_requests_.pop(handle)) {
+            if (resolve(handle) != nullptr) {
+                erase_slot(handle.index);
+                ++removed;
+            }
+        }
+        return removed;
     }
 
+    // Remove every entity immediately, including any still queued for removal
     void shutdown() {
-        entities_.clear();
+        for (auto& entity : dense_) {
+            cancel_scheduled_events(*entity);
+            release_entity(*entity);
+        }
+        for (const uint32_t index : dense_slots_) {
+            free_slot(index);
+        }
+        dense_.clear();
+        dense_slots_.clear();
+        while (!ids_.empty()) {
+            unmap_id(ids_.begin()->first);
+        }
+        removal_requests_.clear();
+        event_requests_.clear();
+        ++revision_;
     }
 
     // Schedule any events requested by entities.
     // Convention:
     //  - EventRequest.event_time is an ABSOLUTE simulation time in SECONDS.
     //  - Scheduler delay argument is SECONDS.
+    // Only entities that reported a request since the last call are visited.
     void schedule_entitiy_events(SimEventScheduler& scheduler, SimulationClock& clock) {
-        for (const auto& pair : entities_) {
-            const auto& entity = pair.second;
-
-            // pending_events is expected to be a std::vector<EventRequest>
-            for (const auto& event_request : entity->pending_events) {
-                const double current_time = clock.now();
-                const double delay = event_request.event_time - current_time;
-
-                if (delay > 0.0) {
-                    std::cout << "[INFO] Scheduled event for Entity ID " << event_request.entity_id
-                              << ": " << event_request.event_description
-                              << " (current: " << current_time << "s, target: " << event_request.event_time
-                              << "s, delay: " << delay << "s)" << std::endl;
-                    scheduler.schedule_event(clock, event_request.callback, delay);
-                } else {
-                    std::cout << "[WARNING] Event for Entity ID " << event_request.entity_id
-                              << " requested for past time (" << event_request.event_time
-                              << "s). Current time: " << current_time << "s. Skipping." << std::endl;
-                }
+        if (event_requests_.take_overflow()) {
+            // The dirty list dropped handles; scan everything once and discard the partial list
+            for (const auto& entity : dense_) {
+                schedule_pending_events(scheduler, clock, *entity);
             }
+            event_requests_.clear();
+            return;
+        }
 
-            // Clear the requested events for this entity after scheduling them
-            entity->pending_events.clear();
+        EntityHandle handle;
+        while (event_requests_.pop(handle)) {
+            if (Entity* entity = resolve(handle)) {
+                schedule_pending_events(scheduler, clock, *entity);
+            }
         }
     }
 
-    // Iterate over all entities (useful for ticking update(t, dt) from the controller)
+    // Iterate over all entities in dense order (useful for ticking update(t, dt) from the controller).
+    // Entities registered by fn are visited too; entities removed by fn stay until the next safe point.
     template <typename Fn>
     void for_each_entity(Fn&& fn) {
-        for (auto& kv : entities_) {
-            fn(*kv.second);
+        for (size_t i = 0; i < dense_.size(); ++i) {
+            fn(*dense_[i]);
+        }
+    }
+    template <typename Fn>
+    void for_each_entity(Fn&& fn) const {
+        for (const std::shared_ptr<Entity>& entity : dense_) {
+            fn(static_cast<const Entity&>(*entity));
         }
     }
 
+    // Snapshot raw entity pointers into an indexable list (used to split updates across threads) and
+    // return how many of them are active. Active entities come first, grouped by update bucket:
+    // registered classes in registration order, then unregistered classes; runs (if given) receives
+    // one UpdateRun per non-empty active bucket. Inactive entities follow.
+    // Within a group, physics entities come first in PhysicsStore slot order, so walking the list
+    // sweeps the store's arrays front to back; other entities follow in dense order.
+    // The pointers stay valid until the next register or applied removal, which bumps get_revision().
+    std::size_t collect_entities(std::vector<Entity*>& out, std::vector<UpdateRun>* runs = nullptr) const {
+        std::vector<Entity*> ordered;
+        ordered.reserve(dense_.size());
+        for (std::size_t slot = 0; slot < physics_store_.size(); ++slot) {
+            ordered.push_back(physics_store_.get_owner(slot));
+        }
+        for (const auto& entity : dense_) {
+            if (dynamic_cast<const PhysicsEntity*>(entity.get()) == nullptr) {
+                ordered.push_back(entity.get());
+            }
+        }
+
+        // Stable counting sort by bucket; the fallback bucket sorts after the registered ones and
+        // inactive entities sort last
+        const std::size_t fallback = bucket_updates_.size();
+        const std::size_t inactive = fallback + 1;
+        std::vector<uint32_t> buckets(ordered.size());
+        std::vector<std::size_t> starts(inactive + 2, 0);
+        for (std::size_t i = 0; i < ordered.size(); ++i) {
+            if (!ordered[i]->is_active()) {
+                buckets[i] = static_cast<uint32_t>(inactive);
+            } else {
+                const auto it = update_buckets_.find(std::type_index(typeid(*ordered[i])));
+                buckets[i] = it != update_buckets_.end() ? it->second : static_cast<uint32_t>(fallback);
+            }
+            ++starts[buckets[i] + 1];
+        }
+        for (std::size_t bucket = 1; bucket < starts.size(); ++bucket) {
+            starts[bucket] += starts[bucket - 1];
+        }
+        if (runs != nullptr) {
+            runs->clear();
+            for (std::size_t bucket = 0; bucket <= fallback; ++bucket) {
+                if (starts[bucket] != starts[bucket + 1]) {
+                    runs->push_back(UpdateRun{starts[bucket], starts[bucket + 1],
+                                              bucket < fallback ? bucket_updates_[bucket] : nullptr});
+                }
+            }
+        }
+        const std::size_t active_count = starts[inactive];
+        out.resize(ordered.size());
+        for (std::size_t i = 0; i < ordered.size(); ++i) {
+            out[starts[buckets[i]]++] = ordered[i];
+        }
+        return active_count;
+    }
+
     // -----------------
     // GETTER FUNCTIONS
     // -----------------
 
+    // Retrieve an entity by handle; nullptr if the handle is stale
+    std::shared_ptr<Entity> get_entity(EntityHandle handle) const {
+        if (!is_alive(handle)) {
+            return nullptr;
+        }
+        return dense_[slots_[handle.index].dense_index];
+    }
+
     // Retrieve an entity from the registry by ID
     std::shared_ptr<Entity> get_entity(int id) const {
-        auto it = entities_.find(id);
-        if (it != entities_.end()) {
-            return it->second;
-        }
-        return nullptr;
+        return get_entity(get_handle(id));
+    }
+
+    // Handle of a registered entity by ID; invalid if no such entity is registered
+    EntityHandle get_handle(int id) const {
+        auto it = ids_.find(id);
+        return it != ids_.end() ? it->second : EntityHandle{};
+    }
+
+    // True while handle refers to a registered entity (including one queued for removal)
+    bool is_alive(EntityHandle handle) const {
+        return handle.index < slots_.size() && slots_[handle.index].generation == handle.generation &&
+               slots_[handle.index].dense_index != kFreeSlot;
     }
 
     // Retrieve an entity by name
     std::shared_ptr<Entity> get_entity_by_name(const std::string& name) const {
-        for (const auto& pair : entities_) {
-            if (pair.second->get_name() == name) {
-                return pair.second;
+        for (const auto& entity : dense_) {
+            if (entity->get_name() == name) {
+                return entity;
             }
         }
         return nullptr;
@@ -136,7 +404,82 @@ public:
 
     // Get the total number of registered entities
     size_t get_entity_count() const {
-        return entities_.size();
+        return dense_.size();
+    }
+
+    // Contiguous state of every registered PhysicsEntity (see PhysicsStore.hpp)
+    PhysicsStore& get_physics_store() {
+        return physics_store_;
+    }
+    const PhysicsStore& get_physics_store() const {
+        return physics_store_;
+    }
+
+    // Incremented whenever the set of registered entities changes (registration or applied removal)
+    // or a registered entity changes its activity state or update rate
+    uint64_t get_revision() const {
+        return revision_ + tick_changes_.load(std::memory_order_relaxed);
+    }
+
+    // Number of entities in ActivityState::Active, recounted only when get_revision() moves
+    size_t get_active_count() const {
+        const uint64_t revision = get_revision();
+        if (revision != active_count_revision_) {
+            active_count_ = static_cast<size_t>(std::count_if(
+                dense_.begin(), dense_.end(), [](const std::shared_ptr<Entity>& entity) { return entity->is_active(); }));
+            active_count_revision_ = revision;
+        }
+        return active_count_;
+    }
+
+    // True while entity event requests or removals are waiting for the next safe point
+    bool has_pending_requests() const {
+        return event_requests_.has_pending() || removal_requests_.has_pending();
+    }
+
+    // -----------------
+    // CHECKPOINTING
+    // -----------------
+
+    // Slot map layout. Handle indices pick an entity's rate group phase, so a restored registry
+    // re-creates the same layout before registering its entities (see prepare_slots).
+    size_t get_slot_count() const {
+        return slots_.size();
+    }
+    const std::vector<uint32_t>& get_free_slots() const {
+        return free_slots_;
+    }
+
+    // Lay out an empty registry so that the next registrations take registration_slots[0],
+    // registration_slots[1], ... in order, after which the free list is free_slots as saved.
+    // Returns false (and changes nothing) if the registry is not empty or the layout is inconsistent.
+    bool prepare_slots(size_t slot_count, const std::vector<uint32_t>& registration_slots,
+                       const std::vector<uint32_t>& free_slots) {
+        if (!dense_.empty() || registration_slots.size() + free_slots.size() != slot_count) {
+            return false;
+        }
+        std::vector<uint8_t> seen(slot_count, 0);
+        for (const std::vector<uint32_t>* list : {&registration_slots, &free_slots}) {
+            for (const uint32_t index : *list) {
+                if (index >= slot_count || seen[index]) {
+                    return false;
+                }
+                seen[index] = 1;
+            }
+        }
+
+        slots_.assign(slot_count, Slot{});
+        free_slots_ = free_slots;
+        free_slots_.insert(free_slots_.end(), registration_slots.rbegin(), registration_slots.rend());
+        return true;
+    }
+
+    // Let the registry cancel a restored event with the entity it belongs to, as it does for events the
+    // entity requested itself. Ignored if no entity has that ID.
+    void track_entity_event(const SimEventScheduler& scheduler, int id, EventHandle handle) {
+        if (Entity* entity = resolve(get_handle(id))) {
+            track_scheduled_event(scheduler, *entity, handle);
+        }
     }
 
     // -----------------
@@ -144,18 +487,16 @@ public:
     // -----------------
 
     void print_all_entities() const {
-        std::cout << "Registered Entities:" << std::endl;
-        for (const auto& pair : entities_) {
+        MSF_LOG_INFO("Registered Entities:");
+        for (const auto& entity : dense_) {
             int status = 0;
-            const char* mangled_name = typeid(*pair.second).name();
+            const char* mangled_name = typeid(*entity).name();
             char* demangled = abi::__cxa_demangle(mangled_name, nullptr, nullptr, &status);
             std::string type_name = (status == 0 && demangled) ? demangled : mangled_name;
 
-            std::cout << "ID: " << pair.first
-                      << ", Name: " << pair.second->get_name()
-                      << ", Type: " << type_name 
-                      << ", Position: " << pair.second->get_position() 
-                      << ", Orientation: " << pair.second->get_orientation() << std::endl;
+            std::ostringstream pose;
+            pose << "Position: " << entity->get_position() << ", Orientation: " << entity->get_orientation();
+            MSF_LOG_INFO("ID: {}, Name: {}, Type: {}, {}", entity->get_id(), entity->get_name(), type_name, pose.str());
 
             if (status == 0 && demangled) {
                 free(demangled);
@@ -164,6 +505,154 @@ public:
     }
 
 private:
-    std::unordered_map<int, std::shared_ptr<Entity>> entities_; // Map of entity IDs to entity instances
+    static constexpr uint32_t kFreeSlot = UINT32_MAX;
+
+    // Qualified call: no virtual dispatch, and T::update can be inlined into the loop
+    template <typename T>
+    static void update_batch(Entity* const* entities, std::size_t count, double t, double dt) {
+        for (std::size_t i = 0; i < count; ++i) {
+            static_cast<T*>(entities[i])->T::update(t, dt);
+        }
+    }
+
+    // Sparse side of the slot map: where a handle's entity sits in dense_
+    struct Slot {
+        uint32_t dense_index = kFreeSlot; // kFreeSlot while the slot is on the free list
+        uint32_t generation = 0; // Bumped on every removal so old handles go stale
+    };
+
+    Entity* resolve(EntityHandle handle) const {
+        return is_alive(handle) ? dense_[slots_[handle.index].dense_index].get() : nullptr;
+    }
+
+    EntityHandle allocate_slot() {
+        if (!free_slots_.empty()) {
+            const uint32_t index = free_slots_.back();
+            free_slots_.pop_back();
+            return EntityHandle{index, slots_[index].generation};
+        }
+        slots_.emplace_back();
+        return EntityHandle{static_cast<uint32_t>(slots_.size() - 1), 0};
+    }
+
+    void free_slot(uint32_t index) {
+        slots_[index].dense_index = kFreeSlot;
+        ++slots_[index].generation;
+        free_slots_.push_back(index);
+    }
+
+    // ids_ recycles its nodes so spawn/despawn cycles don't allocate once warmed up
+    void map_id(int id, EntityHandle handle) {
+        if (spare_id_nodes_.empty()) {
+            ids_[id] = handle;
+            return;
+        }
+        auto node = std::move(spare_id_nodes_.back());
+        spare_id_nodes_.pop_back();
+        node.key() = id;
+        node.mapped() = handle;
+        ids_.insert(std::move(node));
+    }
+    void unmap_id(int id) {
+        auto node = ids_.extract(id);
+        if (!node.empty()) {
+            spare_id_nodes_.push_back(std::move(node));
+        }
+    }
+
+    // Take the entity in slot index out of the registry now; the last dense entry fills its place
+    void erase_slot(uint32_t index) {
+        const uint32_t dense_index = slots_[index].dense_index;
+        Entity& entity = *dense_[dense_index];
+        MSF_LOG_INFO("Removing entity ID {} from registry.", entity.get_id());
+        cancel_scheduled_events(entity);
+        release_entity(entity);
+        unmap_id(entity.get_id());
+
+        const uint32_t last = static_cast<uint32_t>(dense_.size() - 1);
+        if (dense_index != last) {
+            dense_[dense_index] = std::move(dense_[last]);
+            dense_slots_[dense_index] = dense_slots_[last];
+            slots_[dense_slots_[dense_index]].dense_index = dense_index;
+        }
+        dense_.pop_back();
+        dense_slots_.pop_back();
+        free_slot(index);
+        ++revision_;
+    }
+
+    // Hand every pending request of one entity to the scheduler and clear its request list
+    void schedule_pending_events(SimEventScheduler& scheduler, SimulationClock& clock, Entity& entity) {
+        for (auto& event_request : entity.pending_events) {
+            const double current_time = clock.now();
+            const double delay = event_request.event_time - current_time;
+
+            if (delay > 0.0) {
+                MSF_LOG_INFO("Scheduled event for Entity ID {}: {} (current: {}s, target: {}s, delay: {}s)",
+                             event_request.entity_id, event_description_name(event_request.description_id),
+                             current_time, event_request.event_time, delay);
+                // The callback moves into the scheduler's node pool; no copy, no allocation
+                const EventHandle handle = scheduler.schedule_event(clock, std::move(event_request.callback),
+                                                                    delay, event_request.description_id,
+                                                                    event_request.tag);
+                track_scheduled_event(scheduler, entity, handle);
+            } else {
+                MSF_LOG_WARNING("Event for Entity ID {} requested for past time ({}s). Current time: {}s. Skipping.",
+                                event_request.entity_id, event_request.event_time, current_time);
+            }
+        }
+
+        // Clear the requested events for this entity after scheduling them
+        entity.pending_events.clear();
+    }
+
+    // Remember handle so the event can be cancelled with its entity. Handles of events that already
+    // fired are dropped whenever the list would otherwise have to grow.
+    void track_scheduled_event(const SimEventScheduler& scheduler, Entity& entity, EventHandle handle) {
+        auto& handles = entity.scheduled_events;
+        if (handles.size() == handles.capacity()) {
+            handles.erase(std::remove_if(handles.begin(), handles.end(),
+                                         [&scheduler](EventHandle h) { return !scheduler.is_pending(h); }),
+                          handles.end());
+        }
+        handles.push_back(handle);
+    }
+
+    // Undo register_entity's hookups; the entity keeps its state if someone else still holds it
+    void release_entity(Entity& entity) {
+        entity.detach_registry();
+        if (auto* physics = dynamic_cast<PhysicsEntity*>(&entity)) {
+            physics->detach_physics_store();
+        }
+    }
+
+    void cancel_scheduled_events(Entity& entity) {
+        if (scheduler_ != nullptr) {
+            for (const EventHandle handle : entity.scheduled_events) {
+                scheduler_->cancel(handle);
+            }
+        }
+        entity.scheduled_events.clear();
+    }
+
+    PhysicsStore physics_store_; // Declared before dense_ so it outlives every entity destroyed with the registry
+    std::vector<std::shared_ptr<Entity>> dense_; // Registered entities, contiguous
+    std::vector<uint32_t> dense_slots_; // Slot index of each dense_ entry
+    std::vector<Slot> slots_; // Indexed by EntityHandle::index
+    std::vector<uint32_t> free_slots_; // Slots available for reuse
+    std::unordered_map<int, EntityHandle> ids_; // Entity ID to handle, for ID-based lookups
+    std::vector<std::unordered_map<int, EntityHandle>::node_type> spare_id_nodes_; // Recycled ids_ nodes
+    std::unordered_map<std::type_index, std::shared_ptr<msf::BlockPool>> entity_pools_; // One per model class
+    std::unordered_map<std::type_index, uint32_t> update_buckets_; // Concrete class to index in bucket_updates_
+    std::vector<UpdateBatchFn> bucket_updates_; // Update loop of each registered class
     std::map<std::string, CreateEntityFunc> entity_registry; // Map of entity names to factory functions
+    std::unordered_map<std::type_index, std::string> class_names_; // Concrete class to its register_class name
+    uint64_t revision_ = 0; // Bumped on every register/remove so cached entity lists can be invalidated
+    SimEventScheduler* scheduler_ = nullptr; // Scheduler holding entity events, see attach_scheduler
+    uint64_t run_seed_ = 0; // Key of the entities' random streams, see set_run_seed
+    EntityHandleQueue event_requests_{kEventRequestQueueCapacity}; // Entities with pending event requests
+    EntityHandleQueue removal_requests_{kRemovalQueueCapacity}; // Entities waiting for apply_pending_removals
+    std::atomic<uint64_t> tick_changes_{0}; // Bumped by entities whose activity state or update rate changes
+    mutable size_t active_count_ = 0; // Cached get_active_count()
+    mutable uint64_t active_count_revision_ = UINT64_MAX; // Revision active_count_ was counted at
 };
\ No newline at end of file
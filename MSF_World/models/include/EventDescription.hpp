@@ -0,0 +1,26 @@
+/*
+* @file:   EventDescription.hpp
+* @lib:    msfworld_libs
+* @brief:  Process-wide interning of event description strings.
+* Events carry a 32-bit EventDescriptionId instead of a std::string, so requesting and scheduling an
+* event never copies or allocates a description. Strings are interned once (typically while parsing
+* the SCF) and looked up again only when something is logged.
+*
+* @author: Brandon Coulter
+* @date:   2026-03-10
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+using EventDescriptionId = uint32_t;
+
+// Id of the empty description, used for events scheduled without one
+constexpr EventDescriptionId kNoEventDescription = 0;
+
+// Return the id for description, interning it on first use. Thread-safe.
+EventDescriptionId intern_event_description(const std::string& description);
+
+// Look up the string for an id. Unknown ids return the empty description. Thread-safe.
+const std::string& event_description_name(EventDescriptionId id);
@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdint>
+
+// Lightweight reference to an event pending in the SimEventScheduler.
+// The generation makes handles to fired or cancelled events harmless: cancel() and reschedule()
+// on a stale handle are no-ops even after the scheduler has reused the slot.
+struct EventHandle {
+    uint32_t index = UINT32_MAX; // Slot of the event in the scheduler's node pool
+    uint32_t generation = 0; // Slot generation when the event was scheduled
+
+    bool is_valid() const {
+        return index != UINT32_MAX;
+    }
+};
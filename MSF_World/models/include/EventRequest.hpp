@@ -1,10 +1,18 @@
 #pragma once
 #include <string>
-#include <functional>
+
+#include "EventDescription.hpp"
+#include "EventTag.hpp"
+#include "InlineFunction.hpp"
+
+// Callback type shared by entity event requests and the scheduler. Move-only and stored inline;
+// captures must fit in 64 bytes (capture ids, not strings or containers).
+using EventCallback = msf::InlineFunction<void(), 64>;
 
 struct EventRequest {
     int entity_id; // ID of the entity requesting the event
-    double event_time; // Time at which the event should be processed (in milliseconds)
-    std::string event_description; // Optional description of the event for logging
-    std::function<void()> callback; // Callback function that the controller will execute
-};
\ No newline at end of file
+    double event_time; // Absolute simulation time at which the event should be processed (seconds)
+    EventDescriptionId description_id; // Interned description of the event for logging
+    EventCallback callback; // Callback function that the controller will execute
+    EventTag tag{}; // What the callback does, for checkpoints; Opaque events are not checkpointed
+};
@@ -0,0 +1,29 @@
+/*
+* @file:   EventTag.hpp
+* @lib:    msfworld_libs
+* @brief:  Serializable identity of a scheduled event.
+* An EventCallback is an opaque closure, so it can't be written to a checkpoint. Events that should
+* survive a checkpoint also carry an EventTag saying what they do; on restore the tag (plus the
+* event's time and description) is enough to build the same callback again. Events scheduled
+* without a tag are Opaque and are left out of checkpoints.
+*
+* @author: Brandon Coulter
+* @date:   2026-03-24
+*/
+#pragma once
+
+#include <cstdint>
+
+enum class EventKind : uint8_t {
+    Opaque,   // Plain callback, not checkpointed
+    Trigger,  // SCF <trigger>: logs, and changes the entity's activity if argument names an ActivityState
+    Shutdown, // End of the run
+};
+
+struct EventTag {
+    static constexpr uint8_t kNoArgument = 0xFF;
+
+    EventKind kind = EventKind::Opaque;
+    int entity_id = -1;             // Entity the event acts on, -1 for none
+    uint8_t argument = kNoArgument; // Kind-specific
+};
@@ -1,49 +1,154 @@
 #pragma once
 
 #include "Entity.hpp"
+#include "PhysicsStore.hpp"
 
 class PhysicsEntity : public Entity {
 public:
     // Implement everything from Entity, but add physics-related properties and methods
     PhysicsEntity(const std::string& name) : Entity(name) {}
-    ~PhysicsEntity() override = default;
+    ~PhysicsEntity() override {
+        detach_physics_store();
+    }
+
+    // The store points back at this object while attached
+    PhysicsEntity(const PhysicsEntity&) = delete;
+    PhysicsEntity& operator=(const PhysicsEntity&) = delete;
 
     // Override the update function to include physics updates
-    std::unique_ptr<Entity> create() override = 0; 
+    std::unique_ptr<Entity> create() override = 0;
     void update(const double t, const double dt) override;
-    void shutdown() override { Entity::shutdown(); } 
-    void request_event(const EventRequest& event_request) override {
-        Entity::request_event(event_request); // Just call the base request_event for now
+    void shutdown() override { Entity::shutdown(); }
+    void request_event(EventRequest event_request) override {
+        Entity::request_event(std::move(event_request)); // Just call the base request_event for now
     };
 
-    void set_position(const Vec3& new_position) {
-        position = new_position;
+    // Adds the whole PhysicsState (including the force/torque accumulators) to the base state
+    void save_state(StateWriter& out) const override;
+    void load_state(StateReader& in) override;
+
+    // State accessors. While registered, the state lives in the registry's PhysicsStore arrays;
+    // before registration (e.g. while the SCF parser sets it up) it lives in the entity itself.
+    void set_position(const Vec3& new_position) override {
+        write(&PhysicsStore::position, &PhysicsState::position, new_position);
+    }
+    Vec3 get_position() const override {
+        return read(&PhysicsStore::position, &PhysicsState::position);
+    }
+
+    void set_orientation(const Quat& new_orientation) override {
+        if (physics_store) {
+            physics_store->orientation.set(physics_slot, new_orientation);
+        } else {
+            detached_state.orientation = new_orientation;
+        }
+    }
+    Quat get_orientation() const override {
+        return physics_store ? physics_store->orientation.get(physics_slot) : detached_state.orientation;
+    }
+
+    // Position, velocity and orientation as of the start of the current tick (see PhysicsStore::Snapshot).
+    // Read other entities through these during update(): they don't change while the tick runs. Outside a
+    // tick, or while detached, they return the live state.
+    Vec3 get_snapshot_position() const override {
+        return snapshot_read(&PhysicsStore::Snapshot::position, &PhysicsStore::position, &PhysicsState::position);
+    }
+    Vec3 get_snapshot_velocity() const {
+        return snapshot_read(&PhysicsStore::Snapshot::velocity, &PhysicsStore::velocity, &PhysicsState::velocity);
+    }
+    Quat get_snapshot_orientation() const override {
+        if (physics_store && physics_store->is_snapshot_published()) {
+            return physics_store->get_snapshot().orientation.get(physics_slot);
+        }
+        return get_orientation();
+    }
+
+    void set_velocity(const Vec3& new_velocity) {
+        write(&PhysicsStore::velocity, &PhysicsState::velocity, new_velocity);
+    }
+    Vec3 get_velocity() const {
+        return read(&PhysicsStore::velocity, &PhysicsState::velocity);
+    }
+    void set_acceleration(const Vec3& new_acceleration) {
+        write(&PhysicsStore::acceleration, &PhysicsState::acceleration, new_acceleration);
+    }
+    Vec3 get_acceleration() const {
+        return read(&PhysicsStore::acceleration, &PhysicsState::acceleration);
+    }
+
+    void set_angular_velocity(const Vec3& new_angular_velocity) {
+        write(&PhysicsStore::angular_velocity, &PhysicsState::angular_velocity, new_angular_velocity);
+    }
+    Vec3 get_angular_velocity() const {
+        return read(&PhysicsStore::angular_velocity, &PhysicsState::angular_velocity);
+    }
+    void set_angular_acceleration(const Vec3& new_angular_acceleration) {
+        write(&PhysicsStore::angular_acceleration, &PhysicsState::angular_acceleration, new_angular_acceleration);
+    }
+    Vec3 get_angular_acceleration() const {
+        return read(&PhysicsStore::angular_acceleration, &PhysicsState::angular_acceleration);
+    }
+
+    void set_mass(double new_mass) {
+        (physics_store ? physics_store->mass[physics_slot] : detached_state.mass) = new_mass;
     }
-    Vec3 get_position() const {
-        return position;
+    double get_mass() const {
+        return physics_store ? physics_store->mass[physics_slot] : detached_state.mass;
     }
-    
-    void set_orientation(const Quat& new_orientation) {
-        orientation = new_orientation;
+    void set_inertia(const Vec3& new_inertia) {
+        write(&PhysicsStore::inertia, &PhysicsState::inertia, new_inertia);
     }
-    Quat get_orientation() const {
-        return orientation;
+    Vec3 get_inertia() const {
+        return read(&PhysicsStore::inertia, &PhysicsState::inertia);
     }
 
-protected:
-    Vec3 position; // Position in 3D space
-    Vec3 velocity; // Velocity vector
-    Vec3 acceleration; // Acceleration vector
+    // Accumulate a force/torque for the next update
+    void apply_force(const Vec3& force) {
+        write(&PhysicsStore::force_accumulator, &PhysicsState::force_accumulator, get_force() + force);
+    }
+    Vec3 get_force() const {
+        return read(&PhysicsStore::force_accumulator, &PhysicsState::force_accumulator);
+    }
+    void apply_torque(const Vec3& torque) {
+        write(&PhysicsStore::torque_accumulator, &PhysicsState::torque_accumulator, get_torque() + torque);
+    }
+    Vec3 get_torque() const {
+        return read(&PhysicsStore::torque_accumulator, &PhysicsState::torque_accumulator);
+    }
 
-    Quat orientation; // Orientation as a quaternion
-    Vec3 angular_velocity; // Angular velocity vector
-    Vec3 angular_acceleration; // Angular acceleration vector
+    // Move this entity's state into store (the registry does this on registration) or back out of it
+    void attach_physics_store(PhysicsStore& store);
+    void detach_physics_store();
+    bool is_attached() const {
+        return physics_store != nullptr;
+    }
+    std::size_t get_physics_slot() const {
+        return physics_slot;
+    }
 
-    double mass; // Mass of the entity
-    Vec3 inertia; // Inertia tensor (simplified as a diagonal for this example)
+private:
+    friend class PhysicsStore; // Re-points physics_slot when slots are compacted
 
-    Vec3 force_accumulator; // Accumulated forces to be applied in the next update
-    Vec3 torque_accumulator; // Accumulated torques to be applied in the next update
+    Vec3 read(PhysicsStore::Vec3Column PhysicsStore::*column, Vec3 PhysicsState::*field) const {
+        return physics_store ? (physics_store->*column).get(physics_slot) : detached_state.*field;
+    }
+    Vec3 snapshot_read(PhysicsStore::Vec3Column PhysicsStore::Snapshot::*published,
+                       PhysicsStore::Vec3Column PhysicsStore::*live, Vec3 PhysicsState::*field) const {
+        if (physics_store && physics_store->is_snapshot_published()) {
+            return (physics_store->get_snapshot().*published).get(physics_slot);
+        }
+        return read(live, field);
+    }
+    void write(PhysicsStore::Vec3Column PhysicsStore::*column, Vec3 PhysicsState::*field, const Vec3& value) {
+        if (physics_store) {
+            (physics_store->*column).set(physics_slot, value);
+        } else {
+            detached_state.*field = value;
+        }
+    }
 
+    PhysicsStore* physics_store = nullptr; // Store holding this entity's state, nullptr while detached
+    std::size_t physics_slot = 0;          // Slot in physics_store
+    PhysicsState detached_state;           // State while detached
 
-}; // PhysicsEntity.hpp 
\ No newline at end of file
+}; // PhysicsEntity.hpp
\ No newline at end of file
@@ -0,0 +1,208 @@
+/*
+* @file:   PhysicsStore.hpp
+* @lib:    msfworld_libs
+* @brief:  Structure-of-arrays storage for PhysicsEntity state.
+* Every registered PhysicsEntity owns one dense slot; each state component (position.x, velocity.y,
+* mass, ...) lives in its own contiguous array indexed by that slot. PhysicsEntity's getters and
+* setters read and write these arrays, and the Euler integration step runs as a single loop over
+* them instead of chasing one heap object per entity.
+*
+* Slots are kept dense: detaching an entity moves the last slot into the hole and tells its owner.
+* Arrays only grow or shrink on attach/detach, which the registry never does during a tick, so
+* entities updated in parallel can each write their own slot without synchronization.
+*
+* Integration is deferred while a tick is in progress (set_deferred(true)): PhysicsEntity::update
+* only marks its slot, and the tick engine integrates every marked slot afterwards with
+* integrate_pending(). Outside a tick, or when a tick needs each entity's state right after its
+* update (trajectory sampling), PhysicsEntity::update integrates its own slot immediately. Both paths
+* run the same arithmetic, so results are bit-identical.
+*
+* Entities that read each other (guidance reading a target's position) would race with those writes,
+* and a serial tick would let them see some entities before and some after their update. So the store
+* is double-buffered for reads: at the start of each tick, while nothing is being updated, the tick
+* engine publishes a snapshot of every slot's position, velocity and orientation. During the tick the
+* live arrays only take each entity's writes to its own slot, and reads of other entities go to the
+* snapshot (PhysicsEntity::get_snapshot_*), which nobody writes until the next tick boundary. The
+* result is independent of update order and thread count, without locks. Publishing copies ten
+* doubles per slot every tick, so it only starts once an entity that reads others is registered
+* (Entity::reads_other_entities); until then snapshot reads return the live state.
+*
+* @author: Brandon Coulter
+* @date:   2026-03-22
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Quat.hpp"
+#include "Vec3.hpp"
+
+class PhysicsEntity;
+
+// Rigid body state of one entity. Used as the entity's own storage while it is not attached to a
+// store, and to move state in and out of a store.
+struct PhysicsState {
+    Vec3 position;
+    Vec3 velocity;
+    Vec3 acceleration;
+
+    Quat orientation;
+    Vec3 angular_velocity;
+    Vec3 angular_acceleration;
+
+    double mass = 1.0;
+    Vec3 inertia{1.0, 1.0, 1.0}; // Diagonal of the inertia tensor
+
+    Vec3 force_accumulator;  // Forces to apply in the next update
+    Vec3 torque_accumulator; // Torques to apply in the next update
+};
+
+class PhysicsStore {
+public:
+    struct Vec3Column {
+        std::vector<double> x, y, z;
+
+        Vec3 get(std::size_t slot) const {
+            return Vec3(x[slot], y[slot], z[slot]);
+        }
+        void set(std::size_t slot, const Vec3& value) {
+            x[slot] = value.get_x();
+            y[slot] = value.get_y();
+            z[slot] = value.get_z();
+        }
+    };
+
+    struct QuatColumn {
+        std::vector<double> w, x, y, z;
+
+        Quat get(std::size_t slot) const {
+            return Quat(w[slot], x[slot], y[slot], z[slot]);
+        }
+        void set(std::size_t slot, const Quat& value) {
+            w[slot] = value.get_w();
+            x[slot] = value.get_x();
+            y[slot] = value.get_y();
+            z[slot] = value.get_z();
+        }
+    };
+
+    PhysicsStore() = default;
+    ~PhysicsStore();
+
+    // Slots point back at their owners, so a store can't be copied
+    PhysicsStore(const PhysicsStore&) = delete;
+    PhysicsStore& operator=(const PhysicsStore&) = delete;
+
+    // Append a slot holding state for owner and return its index
+    std::size_t attach(PhysicsEntity* owner, const PhysicsState& state);
+    // Remove a slot and return its state. The last slot moves into the hole and its owner is re-pointed.
+    PhysicsState detach(std::size_t slot);
+
+    PhysicsState get_state(std::size_t slot) const;
+    void set_state(std::size_t slot, const PhysicsState& state);
+    std::size_t size() const {
+        return owners_.size();
+    }
+    PhysicsEntity* get_owner(std::size_t slot) const {
+        return owners_[slot];
+    }
+
+    // Position, velocity and orientation of every slot as of the start of the current tick
+    struct Snapshot {
+        Vec3Column position;
+        Vec3Column velocity;
+        QuatColumn orientation;
+    };
+
+    // Publish a snapshot every tick from now on (the registry calls this when an entity that reads
+    // other entities is registered)
+    void enable_snapshot() {
+        snapshot_enabled_ = true;
+    }
+    bool is_snapshot_enabled() const {
+        return snapshot_enabled_;
+    }
+
+    // Copy the live kinematic state into the snapshot (the tick engine does this before any update of a
+    // tick) and, at the end of the tick, go back to reading the live state. Slots never move while a
+    // snapshot is published, since attach/detach only happen between ticks.
+    void publish_snapshot();
+    void retire_snapshot() {
+        snapshot_published_ = false;
+    }
+    bool is_snapshot_published() const {
+        return snapshot_published_;
+    }
+    const Snapshot& get_snapshot() const {
+        return snapshot_;
+    }
+
+    // While deferred, PhysicsEntity::update marks its slot instead of integrating it
+    void set_deferred(bool deferred) {
+        deferred_ = deferred;
+    }
+    bool is_deferred() const {
+        return deferred_;
+    }
+    void mark_pending(std::size_t slot) {
+        pending_[slot] = 1;
+    }
+
+    // Integrate one slot now
+    void integrate_slot(std::size_t slot, double dt) {
+        // v = v + a*dt
+        velocity.x[slot] += acceleration.x[slot] * dt;
+        velocity.y[slot] += acceleration.y[slot] * dt;
+        velocity.z[slot] += acceleration.z[slot] * dt;
+        // p = p + v*dt
+        position.x[slot] += velocity.x[slot] * dt;
+        position.y[slot] += velocity.y[slot] * dt;
+        position.z[slot] += velocity.z[slot] * dt;
+        // ω = ω + α*dt
+        angular_velocity.x[slot] += angular_acceleration.x[slot] * dt;
+        angular_velocity.y[slot] += angular_acceleration.y[slot] * dt;
+        angular_velocity.z[slot] += angular_acceleration.z[slot] * dt;
+        // Clear accumulators for next iteration
+        force_accumulator.x[slot] = force_accumulator.y[slot] = force_accumulator.z[slot] = 0.0;
+        torque_accumulator.x[slot] = torque_accumulator.y[slot] = torque_accumulator.z[slot] = 0.0;
+        pending_[slot] = 0;
+    }
+
+    // Integrate every slot marked since the last call, in slot order
+    void integrate_pending(double dt);
+    // Same, but only look at the listed slots (the tick engine passes its active entities' slots)
+    void integrate_pending(const std::vector<uint32_t>& slots, double dt);
+
+    // Same step for a detached entity's own state
+    static void integrate(PhysicsState& state, double dt);
+
+    // Component arrays, indexed by slot
+    Vec3Column position;
+    Vec3Column velocity;
+    Vec3Column acceleration;
+    QuatColumn orientation;
+    Vec3Column angular_velocity;
+    Vec3Column angular_acceleration;
+    std::vector<double> mass;
+    Vec3Column inertia;
+    Vec3Column force_accumulator;
+    Vec3Column torque_accumulator;
+
+private:
+    // Apply fn to every component array
+    template <typename Fn>
+    void for_each_array(Fn&& fn);
+
+    // integrate_pending over slot_at(0) .. slot_at(count - 1)
+    template <typename SlotAt>
+    void integrate_marked(std::size_t count, SlotAt slot_at, double dt);
+
+    std::vector<PhysicsEntity*> owners_;
+    std::vector<uint8_t> pending_; // 1 = PhysicsEntity::update ran during a deferred tick
+    bool deferred_ = false;
+    Snapshot snapshot_; // Read side of the double buffer, only written by publish_snapshot
+    bool snapshot_enabled_ = false; // Set once by enable_snapshot
+    bool snapshot_published_ = false; // True from publish_snapshot to retire_snapshot
+};
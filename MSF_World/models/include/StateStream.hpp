@@ -0,0 +1,138 @@
+/*
+* @file:   StateStream.hpp
+* @lib:    msfworld_libs
+* @brief:  Byte streams that entities write their checkpoint state into and read it back from.
+* StateWriter appends trivially copyable values and length-prefixed strings to a growable byte
+* buffer; StateReader reads them back in the same order. Values are stored in host byte order, so a
+* checkpoint is only meant to be restored on the machine type that wrote it.
+* A reader never reads past its buffer: a short or corrupt buffer makes every further read return a
+* default value and is_ok() false, and the caller checks once at the end.
+*
+* @author: Brandon Coulter
+* @date:   2026-03-24
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class StateWriter {
+public:
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be written");
+        write_bytes(&value, sizeof(T));
+    }
+
+    void write_string(const std::string& value) {
+        write(static_cast<uint32_t>(value.size()));
+        write_bytes(value.data(), value.size());
+    }
+
+    void write_bytes(const void* data, std::size_t size) {
+        const std::size_t offset = bytes_.size();
+        bytes_.resize(offset + size);
+        if (size > 0) {
+            std::memcpy(bytes_.data() + offset, data, size);
+        }
+    }
+
+    // Overwrite a value written earlier at offset (e.g. a size that is only known afterwards)
+    template <typename T>
+    void patch(std::size_t offset, const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be written");
+        std::memcpy(bytes_.data() + offset, &value, sizeof(T));
+    }
+
+    std::size_t size() const {
+        return bytes_.size();
+    }
+    // Empty the buffer but keep its capacity, so a writer reused for every checkpoint stops allocating
+    void clear() {
+        bytes_.clear();
+    }
+    std::vector<char>& bytes() {
+        return bytes_;
+    }
+    const std::vector<char>& bytes() const {
+        return bytes_;
+    }
+
+private:
+    std::vector<char> bytes_;
+};
+
+class StateReader {
+public:
+    StateReader(const char* data, std::size_t size) : data_(data), size_(size) {}
+
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable values can be read");
+        T value{};
+        read_bytes(&value, sizeof(T));
+        return value;
+    }
+
+    std::string read_string() {
+        const uint32_t length = read<uint32_t>();
+        if (!can_read(length)) {
+            return std::string();
+        }
+        std::string value(data_ + offset_, length);
+        offset_ += length;
+        return value;
+    }
+
+    void read_bytes(void* out, std::size_t size) {
+        if (!can_read(size)) {
+            return;
+        }
+        if (size > 0) {
+            std::memcpy(out, data_ + offset_, size);
+        }
+        offset_ += size;
+    }
+
+    // Reader over the next size bytes, which this reader then skips
+    StateReader sub_reader(std::size_t size) {
+        if (!can_read(size)) {
+            return StateReader(nullptr, 0);
+        }
+        StateReader sub(data_ + offset_, size);
+        offset_ += size;
+        return sub;
+    }
+
+    // Fail the reader explicitly, e.g. when a value read back is out of range
+    void fail() {
+        ok_ = false;
+    }
+    bool is_ok() const {
+        return ok_;
+    }
+    // True once every byte was read without error
+    bool is_done() const {
+        return ok_ && offset_ == size_;
+    }
+    std::size_t remaining() const {
+        return ok_ ? size_ - offset_ : 0;
+    }
+
+private:
+    bool can_read(std::size_t size) {
+        if (!ok_ || size > size_ - offset_) {
+            ok_ = false;
+        }
+        return ok_;
+    }
+
+    const char* data_;
+    std::size_t size_;
+    std::size_t offset_ = 0;
+    bool ok_ = true;
+};
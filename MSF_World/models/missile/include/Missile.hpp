@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Logger.hpp"
 #include "PhysicsEntity.hpp"
 
 class Missile : public PhysicsEntity {
@@ -9,7 +10,7 @@ public:
 
     // Destructor that prints a message when a Missile object is destroyed (for debugging purposes)
     ~Missile() override {
-        std::cout << "[MISSILE] Missile '" << get_name() << "' with ID " << get_id() << " destroyed." << std::endl;
+        MSF_LOG(msf::LogLevel::Info, "MISSILE", "Missile '{}' with ID {} destroyed.", entity_name, get_id());
     }
 
     std::unique_ptr<Entity> create() override {
@@ -19,7 +20,7 @@ public:
     void update(const double t, const double dt) override final {
         // Implement missile-specific update logic here
         if (fmod(t, 1.0) < dt) { 
-            std::cout << "[MISSILE] Missile '" << get_name() << "' with ID " << get_id() << " is running t=" << t << std::endl;
+            MSF_LOG(msf::LogLevel::Info, "MISSILE", "Missile '{}' with ID {} is running t={}", entity_name, get_id(), t);
         }
 
         // Call parent update to handle physics integration (if needed)
@@ -27,8 +28,8 @@ public:
     }
     
     void shutdown() override final {
-        std::cout << "[MISSILE] Shutting down Missile '" << get_name() << "' with ID " << get_id() << std::endl;
-        // Call parent shutdown which will notify registry via callback
+        MSF_LOG(msf::LogLevel::Info, "MISSILE", "Shutting down Missile '{}' with ID {}", entity_name, get_id());
+        // Call parent shutdown, which queues this missile for removal from the registry
         PhysicsEntity::shutdown();
     }
 
@@ -10,7 +10,7 @@
 #include "Entity.hpp"
 
 // Define the static member variable
-std::atomic<int> Entity::id_counter(0);
+thread_local int Entity::id_counter = 0;
 
 // Default implementation of shutdown
 void Entity::shutdown() {
@@ -18,13 +18,41 @@ void Entity::shutdown() {
     pending_events.clear();
     
     // Notify the registry that this entity is shutting down
-    if (shutdown_callback) {
-        shutdown_callback(entity_id);
+    request_removal();
+}
+
+void Entity::request_removal() {
+    // Only the first request queues the handle; the registry removes the entity at its next safe point
+    if (removal_queue != nullptr && !removal_requested.exchange(true, std::memory_order_relaxed)) {
+        removal_queue->push(entity_handle);
     }
 }
 
 // Default implementation of request_event
-void Entity::request_event(const EventRequest& event_request) {
+void Entity::request_event(EventRequest event_request) {
     // Store the event request for processing by the controller
-    pending_events.push_back(event_request);
+    const bool first_request = pending_events.empty();
+    pending_events.push_back(std::move(event_request));
+
+    // Only the first request since the last collection puts this entity on the registry's dirty list
+    if (first_request && event_queue != nullptr) {
+        event_queue->push(entity_handle);
+    }
+}
+
+void Entity::save_state(StateWriter& out) const {
+    out.write_string(entity_name);
+    out.write(get_activity());
+    out.write(get_update_rate());
+}
+
+void Entity::load_state(StateReader& in) {
+    entity_name = in.read_string();
+    const ActivityState state = in.read<ActivityState>();
+    if (static_cast<uint8_t>(state) > static_cast<uint8_t>(ActivityState::Static)) {
+        in.fail();
+        return;
+    }
+    set_activity(state);
+    set_update_rate(in.read<double>());
 }
@@ -0,0 +1,52 @@
+/*
+* @file:   EventDescription.cpp
+* @lib:    msfworld_libs
+* @brief:  Implementation of the event description interner
+*
+* @author: Brandon Coulter
+* @date:   2026-03-10
+*/
+
+#include "EventDescription.hpp"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+struct DescriptionTable {
+    std::mutex mutex;
+    std::deque<std::string> names{""}; // Deque keeps returned references stable as it grows
+    std::unordered_map<std::string, EventDescriptionId> ids{{"", kNoEventDescription}};
+};
+
+DescriptionTable& table() {
+    static DescriptionTable instance;
+    return instance;
+}
+
+} // namespace
+
+EventDescriptionId intern_event_description(const std::string& description) {
+    DescriptionTable& descriptions = table();
+    std::lock_guard<std::mutex> lock(descriptions.mutex);
+    auto it = descriptions.ids.find(description);
+    if (it != descriptions.ids.end()) {
+        return it->second;
+    }
+
+    const auto id = static_cast<EventDescriptionId>(descriptions.names.size());
+    descriptions.names.push_back(description);
+    descriptions.ids.emplace(description, id);
+    return id;
+}
+
+const std::string& event_description_name(EventDescriptionId id) {
+    DescriptionTable& descriptions = table();
+    std::lock_guard<std::mutex> lock(descriptions.mutex);
+    if (id >= descriptions.names.size()) {
+        return descriptions.names.front();
+    }
+    return descriptions.names[id];
+}
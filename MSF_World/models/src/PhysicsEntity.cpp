@@ -3,19 +3,52 @@
 void PhysicsEntity::update(const double t, const double dt) {
     // Base implementation - derived classes should override this to add forces
     // For now, just integrate the current forces/torques
-    
+
     // Simple Euler integration for translational motion
     // v = v + a*dt
     // p = p + v*dt
-    velocity += acceleration * dt;
-    position += velocity * dt;
-    
     // Simple Euler integration for rotational motion
     // ω = ω + α*dt
     // integrate angular velocity into orientation
-    angular_velocity += angular_acceleration * dt;
-    
-    // Clear accumulators for next iteration
-    force_accumulator = Vec3(0, 0, 0);
-    torque_accumulator = Vec3(0, 0, 0);
-}
\ No newline at end of file
+    // The arithmetic lives in PhysicsStore so the tick engine can run it as one loop over every entity.
+    if (physics_store == nullptr) {
+        PhysicsStore::integrate(detached_state, dt);
+    } else if (physics_store->is_deferred()) {
+        physics_store->mark_pending(physics_slot);
+    } else {
+        physics_store->integrate_slot(physics_slot, dt);
+    }
+}
+
+void PhysicsEntity::save_state(StateWriter& out) const {
+    Entity::save_state(out);
+    out.write(physics_store ? physics_store->get_state(physics_slot) : detached_state);
+}
+
+void PhysicsEntity::load_state(StateReader& in) {
+    Entity::load_state(in);
+    const PhysicsState state = in.read<PhysicsState>();
+    if (physics_store) {
+        physics_store->set_state(physics_slot, state);
+    } else {
+        detached_state = state;
+    }
+}
+
+void PhysicsEntity::attach_physics_store(PhysicsStore& store) {
+    if (physics_store == &store) {
+        return;
+    }
+    detach_physics_store();
+    physics_slot = store.attach(this, detached_state);
+    physics_store = &store;
+}
+
+void PhysicsEntity::detach_physics_store() {
+    if (physics_store == nullptr) {
+        return;
+    }
+    detached_state = physics_store->detach(physics_slot);
+    physics_store = nullptr;
+    physics_slot = 0;
+}
@@ -0,0 +1,179 @@
+/*
+* @file:   PhysicsStore.cpp
+* @lib:    msfworld_libs
+* @brief:  Slot management and batch integration for the PhysicsEntity SoA store
+*
+* @author: Brandon Coulter
+* @date:   2026-03-22
+*/
+
+#include "PhysicsStore.hpp"
+
+#include <utility>
+
+#include "PhysicsEntity.hpp"
+
+PhysicsStore::~PhysicsStore() {
+    // Entities that outlive the store keep their last state
+    while (!owners_.empty()) {
+        owners_.back()->detach_physics_store();
+    }
+}
+
+template <typename Fn>
+void PhysicsStore::for_each_array(Fn&& fn) {
+    for (Vec3Column* column : {&position, &velocity, &acceleration, &angular_velocity, &angular_acceleration,
+                               &inertia, &force_accumulator, &torque_accumulator}) {
+        fn(column->x);
+        fn(column->y);
+        fn(column->z);
+    }
+    fn(orientation.w);
+    fn(orientation.x);
+    fn(orientation.y);
+    fn(orientation.z);
+    fn(mass);
+}
+
+std::size_t PhysicsStore::attach(PhysicsEntity* owner, const PhysicsState& state) {
+    const std::size_t slot = owners_.size();
+    owners_.push_back(owner);
+    pending_.push_back(0);
+    for_each_array([](std::vector<double>& array) {
+        array.push_back(0.0);
+    });
+    set_state(slot, state);
+    return slot;
+}
+
+PhysicsState PhysicsStore::detach(std::size_t slot) {
+    const PhysicsState state = get_state(slot);
+    const std::size_t last = owners_.size() - 1;
+    if (slot != last) {
+        for_each_array([slot, last](std::vector<double>& array) {
+            array[slot] = array[last];
+        });
+        pending_[slot] = pending_[last];
+        owners_[slot] = owners_[last];
+        owners_[slot]->physics_slot = slot;
+    }
+    for_each_array([](std::vector<double>& array) {
+        array.pop_back();
+    });
+    pending_.pop_back();
+    owners_.pop_back();
+    return state;
+}
+
+void PhysicsStore::publish_snapshot() {
+    // assign() keeps the snapshot's capacity, so once it has grown to the store's size this is ten
+    // contiguous copies with no allocation
+    const auto copy = [](const std::vector<double>& from, std::vector<double>& to) {
+        to.assign(from.begin(), from.end());
+    };
+    for (auto [from, to] : {std::make_pair(&position, &snapshot_.position), std::make_pair(&velocity, &snapshot_.velocity)}) {
+        copy(from->x, to->x);
+        copy(from->y, to->y);
+        copy(from->z, to->z);
+    }
+    copy(orientation.w, snapshot_.orientation.w);
+    copy(orientation.x, snapshot_.orientation.x);
+    copy(orientation.y, snapshot_.orientation.y);
+    copy(orientation.z, snapshot_.orientation.z);
+    snapshot_published_ = true;
+}
+
+PhysicsState PhysicsStore::get_state(std::size_t slot) const {
+    PhysicsState state;
+    state.position = position.get(slot);
+    state.velocity = velocity.get(slot);
+    state.acceleration = acceleration.get(slot);
+    state.orientation = orientation.get(slot);
+    state.angular_velocity = angular_velocity.get(slot);
+    state.angular_acceleration = angular_acceleration.get(slot);
+    state.mass = mass[slot];
+    state.inertia = inertia.get(slot);
+    state.force_accumulator = force_accumulator.get(slot);
+    state.torque_accumulator = torque_accumulator.get(slot);
+    return state;
+}
+
+void PhysicsStore::set_state(std::size_t slot, const PhysicsState& state) {
+    position.set(slot, state.position);
+    velocity.set(slot, state.velocity);
+    acceleration.set(slot, state.acceleration);
+    orientation.set(slot, state.orientation);
+    angular_velocity.set(slot, state.angular_velocity);
+    angular_acceleration.set(slot, state.angular_acceleration);
+    mass[slot] = state.mass;
+    inertia.set(slot, state.inertia);
+    force_accumulator.set(slot, state.force_accumulator);
+    torque_accumulator.set(slot, state.torque_accumulator);
+}
+
+void PhysicsStore::integrate_pending(double dt) {
+    const std::size_t count = owners_.size();
+    integrate_marked(count, [](std::size_t i) { return i; }, dt);
+}
+
+void PhysicsStore::integrate_pending(const std::vector<uint32_t>& slots, double dt) {
+    const uint32_t* const list = slots.data();
+    integrate_marked(slots.size(), [list](std::size_t i) { return static_cast<std::size_t>(list[i]); }, dt);
+}
+
+template <typename SlotAt>
+void PhysicsStore::integrate_marked(std::size_t count, SlotAt slot_at, double dt) {
+    // Raw pointers hoisted out of the loop: through the vectors, every store to pending_ (a char
+    // array, which may alias anything) would force the compiler to reload every array's base pointer.
+    uint8_t* const pending = pending_.data();
+    double* const px = position.x.data();
+    double* const py = position.y.data();
+    double* const pz = position.z.data();
+    double* const vx = velocity.x.data();
+    double* const vy = velocity.y.data();
+    double* const vz = velocity.z.data();
+    const double* const ax = acceleration.x.data();
+    const double* const ay = acceleration.y.data();
+    const double* const az = acceleration.z.data();
+    double* const wx = angular_velocity.x.data();
+    double* const wy = angular_velocity.y.data();
+    double* const wz = angular_velocity.z.data();
+    const double* const alpha_x = angular_acceleration.x.data();
+    const double* const alpha_y = angular_acceleration.y.data();
+    const double* const alpha_z = angular_acceleration.z.data();
+    double* const fx = force_accumulator.x.data();
+    double* const fy = force_accumulator.y.data();
+    double* const fz = force_accumulator.z.data();
+    double* const tx = torque_accumulator.x.data();
+    double* const ty = torque_accumulator.y.data();
+    double* const tz = torque_accumulator.z.data();
+
+    // Same arithmetic, in the same order, as integrate_slot
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t slot = slot_at(i);
+        if (!pending[slot]) {
+            continue;
+        }
+        vx[slot] += ax[slot] * dt;
+        vy[slot] += ay[slot] * dt;
+        vz[slot] += az[slot] * dt;
+        px[slot] += vx[slot] * dt;
+        py[slot] += vy[slot] * dt;
+        pz[slot] += vz[slot] * dt;
+        wx[slot] += alpha_x[slot] * dt;
+        wy[slot] += alpha_y[slot] * dt;
+        wz[slot] += alpha_z[slot] * dt;
+        fx[slot] = fy[slot] = fz[slot] = 0.0;
+        tx[slot] = ty[slot] = tz[slot] = 0.0;
+        pending[slot] = 0;
+    }
+}
+
+void PhysicsStore::integrate(PhysicsState& state, double dt) {
+    // Component-wise to match integrate_slot exactly
+    state.velocity += state.acceleration * dt;
+    state.position += state.velocity * dt;
+    state.angular_velocity += state.angular_acceleration * dt;
+    state.force_accumulator = Vec3(0, 0, 0);
+    state.torque_accumulator = Vec3(0, 0, 0);
+}
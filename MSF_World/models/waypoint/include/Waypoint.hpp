@@ -1,12 +1,13 @@
 #pragma once
 
+#include "Logger.hpp"
 #include "PhysicsEntity.hpp"
 
 class Waypoint : public PhysicsEntity {
 public:
     Waypoint(const std::string& name) : PhysicsEntity(name) {}
     ~Waypoint() override {
-        std::cout << "[WAYPOINT] Waypoint '" << get_name() << "' with ID " << get_id() << " destroyed." << std::endl;
+        MSF_LOG(msf::LogLevel::Info, "WAYPOINT", "Waypoint '{}' with ID {} destroyed.", entity_name, get_id());
     }
 
     std::unique_ptr<Entity> create() override {
@@ -18,15 +19,24 @@ public:
     } 
 
     void set_waypoint(const Vec3& new_position, double tolerance_radius) {
-        position = new_position;
+        set_position(new_position);
         tolerance = tolerance_radius;
     }
 
+    void save_state(StateWriter& out) const override {
+        PhysicsEntity::save_state(out);
+        out.write(tolerance);
+    }
+    void load_state(StateReader& in) override {
+        PhysicsEntity::load_state(in);
+        tolerance = in.read<double>();
+    }
+
     bool is_reached(const Vec3& target_position) const {
-        Vec3 distance_to_target = target_position - position;
+        Vec3 distance_to_target = target_position - get_position();
         return distance_to_target.magnitude() <= tolerance;
     }
 
 private:
-    double tolerance; // Tolerance radius for reaching the waypoint
+    double tolerance = 0.0; // Tolerance radius for reaching the waypoint
 };
@@ -0,0 +1,164 @@
+// Shared helpers for the benchmark executables: `--json <file>` handling and a small JSON report writer.
+//
+// Every benchmark writes one document so results from different releases can be diffed by a script:
+//   {"benchmark": "tick_throughput", "timestamp": 1760000000, "compiler": "...", "build": "optimized",
+//    "config": {...}, "results": [{"case": "...", ...metrics...}, ...]}
+// Metrics are flat key/number pairs; higher-is-better rates end in _per_s, costs in _ns or _ms.
+
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bench {
+
+struct Args {
+    std::vector<std::string> positional;
+    std::string json_path; // Defaults to <benchmark>.json in the working directory
+};
+
+// Splits `--json <file>` from the positional arguments each benchmark defines itself
+inline Args parse_args(int argc, char** argv, const std::string& benchmark) {
+    Args args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            args.json_path = argv[++i];
+        } else {
+            args.positional.push_back(arg);
+        }
+    }
+    if (args.json_path.empty()) {
+        args.json_path = benchmark + ".json";
+    }
+    return args;
+}
+
+inline std::string json_string(const std::string& text) {
+    std::string out = "\"";
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+inline std::string json_number(double value) {
+    if (!std::isfinite(value)) {
+        return "null";
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.6g", value);
+    return text;
+}
+
+// Ordered key -> encoded JSON value pairs
+class JsonObject {
+public:
+    JsonObject& set(const std::string& key, double value) {
+        fields_.emplace_back(key, json_number(value));
+        return *this;
+    }
+    template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    JsonObject& set(const std::string& key, T value) {
+        fields_.emplace_back(key, std::to_string(value));
+        return *this;
+    }
+    JsonObject& set(const std::string& key, const std::string& value) {
+        fields_.emplace_back(key, json_string(value));
+        return *this;
+    }
+    JsonObject& set(const std::string& key, const char* value) {
+        return set(key, std::string(value));
+    }
+
+    std::string str() const {
+        std::string out = "{";
+        for (std::size_t i = 0; i < fields_.size(); ++i) {
+            out += (i ? ", " : "") + json_string(fields_[i].first) + ": " + fields_[i].second;
+        }
+        return out + "}";
+    }
+
+private:
+    std::vector<std::pair<std::string, std::string>> fields_;
+};
+
+class JsonReport {
+public:
+    explicit JsonReport(std::string benchmark) : benchmark_(std::move(benchmark)) {}
+
+    // Parameters shared by every case (tick count, dt, ...)
+    JsonObject& config() {
+        return config_;
+    }
+
+    // One measured case; the returned object stays valid until the next add_result()
+    JsonObject& add_result(const std::string& name) {
+        results_.emplace_back();
+        results_.back().set("case", name);
+        return results_.back();
+    }
+
+    bool write(const std::string& path) const {
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        if (file == nullptr) {
+            std::fprintf(stderr, "Failed to open benchmark report %s\n", path.c_str());
+            return false;
+        }
+        std::fprintf(file, "{\n  \"benchmark\": %s,\n  \"timestamp\": %lld,\n  \"compiler\": %s,\n  \"build\": %s,\n",
+                     json_string(benchmark_).c_str(), static_cast<long long>(std::time(nullptr)),
+                     json_string(compiler()).c_str(), json_string(build_type()).c_str());
+        std::fprintf(file, "  \"config\": %s,\n  \"results\": [\n", config_.str().c_str());
+        for (std::size_t i = 0; i < results_.size(); ++i) {
+            std::fprintf(file, "    %s%s\n", results_[i].str().c_str(), i + 1 < results_.size() ? "," : "");
+        }
+        std::fputs("  ]\n}\n", file);
+        const bool ok = std::ferror(file) == 0;
+        if (std::fclose(file) != 0 || !ok) {
+            std::fprintf(stderr, "Failed to write benchmark report %s\n", path.c_str());
+            return false;
+        }
+        std::printf("Wrote %s\n", path.c_str());
+        return true;
+    }
+
+private:
+    static std::string compiler() {
+#if defined(__clang__)
+        return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+        return std::string("gcc ") + __VERSION__;
+#else
+        return "unknown";
+#endif
+    }
+
+    static std::string build_type() {
+#if defined(__OPTIMIZE__)
+        return "optimized";
+#else
+        return "unoptimized";
+#endif
+    }
+
+    std::string benchmark_;
+    JsonObject config_;
+    std::vector<JsonObject> results_;
+};
+
+} // namespace bench
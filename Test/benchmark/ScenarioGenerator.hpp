@@ -0,0 +1,130 @@
+// Synthetic SCF scenario generator shared by the benchmarks and the msf_generate_scenario tool.
+//
+// Emits a valid <MSFScenario> with N entities: `missile_fraction` of them are dynamic missiles with a
+// random position, a random unit orientation and a speed parameter, the rest are static waypoints. A
+// missile gets a SELF_DESTRUCT trigger with probability `trigger_fraction`, at a random time inside the
+// timeout. Output is deterministic for a given seed, so runs on different releases load identical files.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace bench {
+
+struct ScenarioOptions {
+    std::size_t entities = 1000;
+    double missile_fraction = 0.5;
+    double trigger_fraction = 0.1;
+    double timestep = 0.001;
+    double timeout = 60.0;
+    double extent_m = 100000.0; // Positions are uniform in [-extent, extent] on each axis
+    uint64_t seed = 1;
+};
+
+namespace detail {
+
+// splitmix64: tiny, seedable and identical on every platform
+struct ScenarioRng {
+    uint64_t state;
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    double unit() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+    double range(double lo, double hi) {
+        return lo + (hi - lo) * unit();
+    }
+};
+
+} // namespace detail
+
+// Writes the scenario to `path`; returns false if the file cannot be written
+inline bool write_scenario(const std::string& path, const ScenarioOptions& options) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    detail::ScenarioRng rng{options.seed};
+    const std::size_t missiles = static_cast<std::size_t>(std::llround(options.entities * options.missile_fraction));
+
+    std::fprintf(file,
+                 "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                 "<MSFScenario>\n"
+                 "    <Metadata>\n"
+                 "        <Name>Synthetic %zu entities</Name>\n"
+                 "        <Description>Generated benchmark scenario: %zu missiles, %zu waypoints, seed %llu.</Description>\n"
+                 "        <Author>msf_generate_scenario</Author>\n"
+                 "    </Metadata>\n"
+                 "    <SimulationSetup>\n"
+                 "        <TimeStepInterval>%g</TimeStepInterval>\n"
+                 "        <Timeout>%g</Timeout>\n"
+                 "        <GenericEventTriggers>\n"
+                 "            <trigger time=\"%g\" type=\"TIMEOUT\" delay=\"0.0\"/>\n"
+                 "        </GenericEventTriggers>\n"
+                 "    </SimulationSetup>\n"
+                 "    <SimulationEntities>\n",
+                 options.entities, missiles, options.entities - missiles,
+                 static_cast<unsigned long long>(options.seed), options.timestep, options.timeout, options.timeout);
+
+    const double extent = options.extent_m;
+    for (std::size_t i = 0; i < options.entities; ++i) {
+        const bool missile = i < missiles;
+        const double x = rng.range(-extent, extent);
+        const double y = rng.range(-extent, extent);
+        const double z = rng.range(0.0, extent);
+        std::fprintf(file,
+                     "        <SimulationEntity name=\"%s_%zu\">\n"
+                     "            <ModelClass>%s</ModelClass>\n"
+                     "            <ModelType>%s</ModelType>\n"
+                     "            <EmplacementData>\n"
+                     "                <position x=\"%.3f\" y=\"%.3f\" z=\"%.3f\"/>\n",
+                     missile ? "missile" : "waypoint", i, missile ? "missile" : "waypoint",
+                     missile ? "dynamic" : "static", x, y, z);
+        if (missile) {
+            // Random unit quaternion
+            double qw = rng.range(-1.0, 1.0), qx = rng.range(-1.0, 1.0);
+            double qy = rng.range(-1.0, 1.0), qz = rng.range(-1.0, 1.0);
+            const double norm = std::sqrt(qw * qw + qx * qx + qy * qy + qz * qz);
+            if (norm > 1e-9) {
+                qw /= norm; qx /= norm; qy /= norm; qz /= norm;
+            } else {
+                qw = 1.0; qx = qy = qz = 0.0;
+            }
+            std::fprintf(file,
+                         "                <orientation w=\"%.9f\" x=\"%.9f\" y=\"%.9f\" z=\"%.9f\"/>\n"
+                         "            </EmplacementData>\n"
+                         "            <EntityParameters>\n"
+                         "                <parameter name=\"speed\" value=\"%.1f\" unit=\"m/s\"/>\n"
+                         "            </EntityParameters>\n",
+                         qw, qx, qy, qz, rng.range(200.0, 2000.0));
+            if (rng.unit() < options.trigger_fraction) {
+                std::fprintf(file,
+                             "            <EventTriggers>\n"
+                             "                <trigger time=\"%.3f\" type=\"SELF_DESTRUCT\" delay=\"0.0\"/>\n"
+                             "            </EventTriggers>\n",
+                             rng.range(0.0, options.timeout));
+            }
+        } else {
+            std::fprintf(file,
+                         "            </EmplacementData>\n"
+                         "            <EntityParameters>\n"
+                         "                <parameter name=\"tolerance\" value=\"%.2f\" unit=\"m\"/>\n"
+                         "            </EntityParameters>\n",
+                         rng.range(0.01, 10.0));
+        }
+        std::fputs("        </SimulationEntity>\n", file);
+    }
+    std::fputs("    </SimulationEntities>\n</MSFScenario>\n", file);
+
+    const bool ok = std::ferror(file) == 0;
+    return std::fclose(file) == 0 && ok;
+}
+
+} // namespace bench
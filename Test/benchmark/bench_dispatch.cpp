@@ -0,0 +1,92 @@
+// Benchmark: type-bucketed (devirtualized) vs virtual entity update dispatch.
+//
+// Spawns Missiles and Waypoints interleaved, so registration order mixes types, and steps them with a
+// serial TickEngine twice: once with the registry's per-class update loops (the default) and once
+// with every entity updated through the virtual Entity::update.
+//
+// Usage: bench_dispatch [max_entities] [--json file]   (default 100000)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "BenchReport.hpp"
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "Missile.hpp"
+#include "TickEngine.hpp"
+#include "Waypoint.hpp"
+
+namespace {
+
+constexpr double kEntityUpdatesPerCase = 2e7;
+constexpr int kMinTicks = 20;
+constexpr int kMaxTicks = 5000;
+constexpr int kRepeats = 5;
+
+// Median microseconds per tick
+double run(std::size_t entities, bool bucketed, int ticks) {
+    EntityRegistry registry;
+    registry.register_classes();
+    for (std::size_t i = 0; i < entities; ++i) {
+        if (i % 2 == 0) {
+            registry.spawn<Missile>("m")->set_velocity(Vec3(1.0, 0.0, 0.0));
+        } else {
+            registry.spawn<Waypoint>("w");
+        }
+    }
+
+    TickEngine engine;
+    engine.configure(1, 0);
+    engine.set_bucketed_dispatch(bucketed);
+    const double dt = 0.001;
+    double t = 0.0;
+    engine.tick(registry, t, dt); // Builds the snapshot
+
+    std::vector<double> samples;
+    for (int repeat = 0; repeat < kRepeats; ++repeat) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ticks; ++i) {
+            t += dt;
+            engine.tick(registry, t, dt);
+        }
+        samples.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+                          ticks);
+    }
+    std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    registry.shutdown();
+    return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bench::Args args = bench::parse_args(argc, argv, "dispatch");
+    const std::size_t max_entities = args.positional.empty() ? 100000 : std::strtoull(args.positional[0].c_str(), nullptr, 10);
+
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    bench::JsonReport report("dispatch");
+    report.config().set("entity_updates_per_case", kEntityUpdatesPerCase).set("repeats", kRepeats);
+
+    std::printf("%10s %8s %16s %16s %10s\n", "entities", "ticks", "virtual us/tick", "bucketed us/tick", "speedup");
+    for (std::size_t entities = 1000; entities <= max_entities; entities *= 10) {
+        const int ticks = static_cast<int>(std::clamp(kEntityUpdatesPerCase / kRepeats / entities,
+                                                      static_cast<double>(kMinTicks), static_cast<double>(kMaxTicks)));
+        const double virtual_us = run(entities, false, ticks);
+        const double bucketed_us = run(entities, true, ticks);
+        const double speedup = bucketed_us > 0.0 ? virtual_us / bucketed_us : 0.0;
+        std::printf("%10zu %8d %16.3f %16.3f %9.2fx\n", entities, ticks, virtual_us, bucketed_us, speedup);
+        report.add_result("entities_" + std::to_string(entities))
+            .set("entities", entities)
+            .set("ticks", ticks)
+            .set("virtual_us_per_tick", virtual_us)
+            .set("bucketed_us_per_tick", bucketed_us)
+            .set("speedup", speedup);
+    }
+
+    return report.write(args.json_path) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,102 @@
+// Microbenchmark: Vec3 and Quat kernels used by entity integration.
+//
+// Each kernel runs over arrays of kBatch random inputs (small enough to stay in L1/L2) for a fixed
+// number of passes and reports nanoseconds per operation. Results are folded into a checksum that is
+// printed, so the compiler cannot drop the work.
+//
+// Usage: bench_math [passes] [--json file]   (default 20000)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "BenchReport.hpp"
+#include "Logger.hpp"
+#include "Quat.hpp"
+#include "ScenarioGenerator.hpp"
+#include "Vec3.hpp"
+
+namespace {
+
+constexpr std::size_t kBatch = 1024;
+
+struct Inputs {
+    std::vector<Vec3> a, b;
+    std::vector<Quat> p, q;
+    std::vector<double> s;
+};
+
+Inputs make_inputs() {
+    bench::detail::ScenarioRng rng{42};
+    Inputs in;
+    for (std::size_t i = 0; i < kBatch; ++i) {
+        in.a.emplace_back(rng.range(-1e3, 1e3), rng.range(-1e3, 1e3), rng.range(-1e3, 1e3));
+        in.b.emplace_back(rng.range(-1.0, 1.0), rng.range(-1.0, 1.0), rng.range(-1.0, 1.0));
+        Quat p(rng.range(-1.0, 1.0), rng.range(-1.0, 1.0), rng.range(-1.0, 1.0), rng.range(-1.0, 1.0));
+        Quat q(rng.range(-1.0, 1.0), rng.range(-1.0, 1.0), rng.range(-1.0, 1.0), rng.range(-1.0, 1.0));
+        p.normalize();
+        q.normalize();
+        in.p.push_back(p);
+        in.q.push_back(q);
+        in.s.push_back(rng.range(1e-4, 1e-2));
+    }
+    return in;
+}
+
+double checksum = 0.0;
+
+// Runs kernel(i) for every batch index, `passes` times; returns ns per call
+template <typename Kernel>
+double time_kernel(int passes, Kernel&& kernel) {
+    double sink = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (std::size_t i = 0; i < kBatch; ++i) {
+            sink += kernel(i);
+        }
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    checksum += sink;
+    return ns / (static_cast<double>(passes) * kBatch);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bench::Args args = bench::parse_args(argc, argv, "math_kernels");
+    const int passes = args.positional.empty() ? 20000 : std::atoi(args.positional[0].c_str());
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    const Inputs in = make_inputs();
+    struct Case {
+        const char* name;
+        double ns;
+    };
+    const Case cases[] = {
+        {"vec3_axpy", time_kernel(passes, [&](std::size_t i) { return (in.a[i] + in.b[i] * in.s[i]).get_x(); })},
+        {"vec3_dot", time_kernel(passes, [&](std::size_t i) { return in.a[i].dot(in.b[i]); })},
+        {"vec3_cross", time_kernel(passes, [&](std::size_t i) { return in.a[i].cross(in.b[i]).get_y(); })},
+        {"vec3_normalize", time_kernel(passes, [&](std::size_t i) { return in.a[i].normalize().get_z(); })},
+        {"quat_multiply", time_kernel(passes, [&](std::size_t i) { return (in.p[i] * in.q[i]).get_w(); })},
+        {"quat_normalize", time_kernel(passes, [&](std::size_t i) {
+             Quat r = in.p[i] + in.q[i];
+             r.normalize();
+             return r.get_x();
+         })},
+        {"quat_rotate", time_kernel(passes, [&](std::size_t i) { return in.p[i].rotate(in.a[i]).get_x(); })},
+        {"quat_slerp", time_kernel(passes, [&](std::size_t i) { return Quat::slerp(in.p[i], in.q[i], in.s[i] * 50.0).get_y(); })},
+    };
+
+    bench::JsonReport report("math_kernels");
+    report.config().set("batch", kBatch).set("passes", passes);
+    std::printf("%-16s %10s %14s\n", "kernel", "ns/op", "Mops/s");
+    for (const Case& c : cases) {
+        std::printf("%-16s %10.3f %14.1f\n", c.name, c.ns, 1e3 / c.ns);
+        report.add_result(c.name).set("ns_per_op", c.ns).set("ops_per_s", 1e9 / c.ns);
+    }
+    std::printf("checksum %g\n", checksum);
+
+    return report.write(args.json_path) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,110 @@
+// Benchmark: XML parse and SCF load time for generated scenarios of 1k .. N entities.
+//
+// For each size a synthetic SCF is generated once, then loaded repeatedly. Two numbers are reported,
+// best of the repetitions: XMLParser::load_file alone (text -> DOM) and the full SCF::parse_scf into a
+// fresh EntityRegistry (which parses the XML again, then builds and registers every entity).
+//
+// Usage: bench_scenario_load [max_entities] [--json file]   (default 100000; the generator goes to 1000000)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "BenchReport.hpp"
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "SCF.hpp"
+#include "ScenarioGenerator.hpp"
+#include "XMLParser.hpp"
+
+namespace {
+
+// Enough repetitions for a stable best time on small files, one for the largest
+int repetitions(std::size_t entities) {
+    return static_cast<int>(std::clamp<std::size_t>(100000 / entities, 1, 5));
+}
+
+double elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+long file_size(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return 0;
+    }
+    std::fseek(file, 0, SEEK_END);
+    const long size = std::ftell(file);
+    std::fclose(file);
+    return size;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bench::Args args = bench::parse_args(argc, argv, "scenario_load");
+    const std::size_t max_entities = args.positional.empty() ? 100000 : std::strtoull(args.positional[0].c_str(), nullptr, 10);
+
+    // Loading logs every entity at info level; time the parser, not the logger
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    bench::JsonReport report("scenario_load");
+    std::printf("%10s %12s %12s %12s %16s\n", "entities", "file MB", "xml ms", "scf ms", "entities/s");
+    for (std::size_t entities = 1000; entities <= max_entities; entities *= 10) {
+        bench::ScenarioOptions options;
+        options.entities = entities;
+        const std::string scenario = "/tmp/msf_bench_load_" + std::to_string(entities) + ".xml";
+        const auto generate_start = std::chrono::steady_clock::now();
+        if (!bench::write_scenario(scenario, options)) {
+            std::fprintf(stderr, "Failed to write %s\n", scenario.c_str());
+            return EXIT_FAILURE;
+        }
+        const double generate_ms = elapsed_ms(generate_start);
+
+        double xml_ms = 1e300;
+        double scf_ms = 1e300;
+        std::size_t loaded = 0;
+        for (int rep = 0; rep < repetitions(entities); ++rep) {
+            {
+                XMLParser parser;
+                const auto start = std::chrono::steady_clock::now();
+                if (!parser.load_file(scenario)) {
+                    std::fprintf(stderr, "XML parse failed: %s\n", parser.get_error().c_str());
+                    return EXIT_FAILURE;
+                }
+                xml_ms = std::min(xml_ms, elapsed_ms(start));
+            }
+            {
+                EntityRegistry registry;
+                registry.register_classes();
+                msf::SimDt dt = 0.0;
+                SCF scf(scenario);
+                const auto start = std::chrono::steady_clock::now();
+                if (!scf.parse_scf(registry, dt)) {
+                    std::fprintf(stderr, "SCF load failed for %s\n", scenario.c_str());
+                    return EXIT_FAILURE;
+                }
+                scf_ms = std::min(scf_ms, elapsed_ms(start));
+                loaded = registry.get_entity_count();
+                registry.shutdown();
+            }
+        }
+
+        const double megabytes = file_size(scenario) / 1e6;
+        const double entities_per_s = loaded / (scf_ms / 1e3);
+        std::printf("%10zu %12.2f %12.3f %12.3f %16.0f\n", loaded, megabytes, xml_ms, scf_ms, entities_per_s);
+        report.add_result("entities_" + std::to_string(entities))
+            .set("entities", loaded)
+            .set("file_mb", megabytes)
+            .set("generate_ms", generate_ms)
+            .set("xml_parse_ms", xml_ms)
+            .set("scf_load_ms", scf_ms)
+            .set("entities_per_s", entities_per_s)
+            .set("xml_mb_per_s", megabytes / (xml_ms / 1e3));
+        std::remove(scenario.c_str());
+    }
+
+    return report.write(args.json_path) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,115 @@
+// Microbenchmark: SimEventScheduler binary heap vs timing wheel at 1e3 .. 1e7 pending events.
+//
+// For each size N the scheduler is filled with N events spread over a 60 s horizon, then the clock
+// steps at 1 ms for a fixed number of ticks. Every fired event reschedules itself a random delay
+// ahead, so the pending set stays at N (the classic "hold" model). Reported rates are events per
+// second of wall time for the initial fill and for the steady-state fire + reschedule loop.
+//
+// Usage: bench_scheduler [max_pending] [--json file]   (default 10000000)
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#include "BenchReport.hpp"
+#include "Clock.hpp"
+#include "Logger.hpp"
+#include "Scheduler.hpp"
+
+namespace {
+
+constexpr double kDt = 0.001;
+constexpr double kHorizon = 60.0;
+constexpr int kSteadyTicks = 2000;
+
+struct Lcg {
+    uint64_t state;
+    double next_unit() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(state >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+// Scheduler logs every push; swallow it so we time the data structure, not the terminal.
+struct BenchState {
+    SimulationClock clock;
+    SimEventScheduler scheduler;
+    Lcg rng{12345};
+    uint64_t fired = 0;
+};
+
+// Self-rescheduling event. Fits std::function's small buffer so the benchmark measures the queue.
+struct HoldEvent {
+    BenchState* state;
+    void operator()() const {
+        ++state->fired;
+        state->scheduler.schedule_event(state->clock, HoldEvent{state}, state->rng.next_unit() * kHorizon);
+    }
+};
+
+struct Result {
+    double fill_rate;
+    double steady_rate;
+};
+
+Result run(SimEventScheduler::Backend backend, uint64_t pending) {
+    BenchState state;
+    state.clock.reset(0.0);
+    state.scheduler.configure(backend, kDt);
+
+    const auto fill_start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < pending; ++i) {
+        state.scheduler.schedule_event(state.clock, HoldEvent{&state}, state.rng.next_unit() * kHorizon);
+    }
+    const auto fill_end = std::chrono::steady_clock::now();
+
+    for (int tick = 0; tick < kSteadyTicks; ++tick) {
+        state.scheduler.process_events(state.clock);
+        state.clock.advance(kDt);
+    }
+    const auto steady_end = std::chrono::steady_clock::now();
+
+    const double fill_s = std::chrono::duration<double>(fill_end - fill_start).count();
+    const double steady_s = std::chrono::duration<double>(steady_end - fill_end).count();
+    return {pending / fill_s, state.fired / steady_s};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bench::Args args = bench::parse_args(argc, argv, "scheduler");
+    uint64_t max_pending = 10000000;
+    if (!args.positional.empty()) {
+        max_pending = std::strtoull(args.positional[0].c_str(), nullptr, 10);
+    }
+
+    // Measure the scheduler, not the debug log
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    bench::JsonReport json("scheduler");
+    json.config().set("dt", kDt).set("horizon_s", kHorizon).set("steady_ticks", kSteadyTicks);
+
+    std::ostringstream report;
+    report << "pending,heap_fill_per_s,wheel_fill_per_s,heap_hold_per_s,wheel_hold_per_s,hold_speedup\n";
+    for (uint64_t pending = 1000; pending <= max_pending; pending *= 10) {
+        const Result heap = run(SimEventScheduler::Backend::BinaryHeap, pending);
+        const Result wheel = run(SimEventScheduler::Backend::TimingWheel, pending);
+        char line[256];
+        std::snprintf(line, sizeof(line), "%llu,%.0f,%.0f,%.0f,%.0f,%.2f\n",
+                      static_cast<unsigned long long>(pending), heap.fill_rate, wheel.fill_rate,
+                      heap.steady_rate, wheel.steady_rate, wheel.steady_rate / heap.steady_rate);
+        report << line;
+        json.add_result("pending_" + std::to_string(pending))
+            .set("pending", pending)
+            .set("heap_fill_per_s", heap.fill_rate)
+            .set("wheel_fill_per_s", wheel.fill_rate)
+            .set("heap_hold_per_s", heap.steady_rate)
+            .set("wheel_hold_per_s", wheel.steady_rate);
+    }
+
+    std::cout << report.str();
+    return json.write(args.json_path) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,129 @@
+// Benchmark: simulation ticks per second vs entity count on generated scenarios.
+//
+// For each size (1k, 10k, 100k by default) a synthetic SCF is generated, loaded through SCF::parse_scf
+// and then stepped with the same loop body as Controller::run: collect entity event requests, fire due
+// events, update every entity, advance the clock. Loading is not timed here (see bench_scenario_load).
+// The tick count shrinks with the entity count so every case does roughly the same amount of work.
+// Runs serially and, on machines with more than one core, again on one thread per core.
+//
+// Usage: bench_tick_throughput [max_entities] [--json file]   (default 100000)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchReport.hpp"
+#include "Clock.hpp"
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "SCF.hpp"
+#include "ScenarioGenerator.hpp"
+#include "Scheduler.hpp"
+#include "TickEngine.hpp"
+
+namespace {
+
+constexpr double kEntityUpdatesPerCase = 2e7;
+constexpr int kMinTicks = 20;
+constexpr int kMaxTicks = 5000;
+
+struct Result {
+    int ticks = 0;
+    double ticks_per_s = 0.0;
+    double median_tick_us = 0.0;
+    std::size_t entities = 0;
+};
+
+Result run(const std::string& scenario, std::size_t threads) {
+    EntityRegistry registry;
+    registry.register_classes();
+    msf::SimDt dt = 0.001;
+    SCF scf(scenario);
+    if (!scf.parse_scf(registry, dt)) {
+        std::fprintf(stderr, "Failed to load %s\n", scenario.c_str());
+        std::exit(EXIT_FAILURE);
+    }
+
+    SimulationClock clock;
+    clock.reset(0.0);
+    SimEventScheduler scheduler;
+    registry.attach_scheduler(scheduler);
+    TickEngine engine;
+    engine.configure(threads, 0);
+
+    Result result;
+    result.entities = registry.get_entity_count();
+    result.ticks = static_cast<int>(std::clamp(kEntityUpdatesPerCase / std::max<std::size_t>(result.entities, 1),
+                                               static_cast<double>(kMinTicks), static_cast<double>(kMaxTicks)));
+
+    std::vector<double> tick_us;
+    tick_us.reserve(result.ticks);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < result.ticks; ++i) {
+        const auto tick_start = std::chrono::steady_clock::now();
+        registry.apply_pending_removals();
+        registry.schedule_entitiy_events(scheduler, clock);
+        scheduler.process_events(clock);
+        engine.tick(registry, clock.now(), dt);
+        clock.advance(dt);
+        tick_us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - tick_start).count());
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::nth_element(tick_us.begin(), tick_us.begin() + tick_us.size() / 2, tick_us.end());
+    result.ticks_per_s = result.ticks / seconds;
+    result.median_tick_us = tick_us[tick_us.size() / 2];
+    registry.shutdown();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bench::Args args = bench::parse_args(argc, argv, "tick_throughput");
+    const std::size_t max_entities = args.positional.empty() ? 100000 : std::strtoull(args.positional[0].c_str(), nullptr, 10);
+
+    // Measure the tick, not the per-entity registration and event logs
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    std::vector<std::size_t> thread_counts{1};
+    const std::size_t cores = std::thread::hardware_concurrency();
+    if (cores > 1) {
+        thread_counts.push_back(cores);
+    }
+
+    bench::JsonReport report("tick_throughput");
+    report.config().set("entity_updates_per_case", kEntityUpdatesPerCase).set("cores", cores);
+
+    std::printf("%10s %8s %8s %14s %18s %16s\n", "entities", "threads", "ticks", "ticks/s", "entity updates/s", "median tick us");
+    for (std::size_t entities = 1000; entities <= max_entities; entities *= 10) {
+        bench::ScenarioOptions options;
+        options.entities = entities;
+        const std::string scenario = "/tmp/msf_bench_tick_" + std::to_string(entities) + ".xml";
+        if (!bench::write_scenario(scenario, options)) {
+            std::fprintf(stderr, "Failed to write %s\n", scenario.c_str());
+            return EXIT_FAILURE;
+        }
+
+        for (const std::size_t threads : thread_counts) {
+            const Result result = run(scenario, threads);
+            const double updates_per_s = result.ticks_per_s * result.entities;
+            std::printf("%10zu %8zu %8d %14.1f %18.0f %16.3f\n", result.entities, threads, result.ticks,
+                        result.ticks_per_s, updates_per_s, result.median_tick_us);
+            report.add_result("entities_" + std::to_string(entities) + "_threads_" + std::to_string(threads))
+                .set("entities", result.entities)
+                .set("threads", threads)
+                .set("ticks", result.ticks)
+                .set("ticks_per_s", result.ticks_per_s)
+                .set("entity_updates_per_s", updates_per_s)
+                .set("median_tick_us", result.median_tick_us);
+        }
+        std::remove(scenario.c_str());
+    }
+
+    return report.write(args.json_path) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
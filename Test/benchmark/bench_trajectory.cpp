@@ -0,0 +1,158 @@
+// Benchmark: simulation tick cost with and without the trajectory recorder.
+//
+// Ticks N physics entities at dt = 1 ms, once with recording off and once recording every entity at
+// the output rate (default 10000 entities at 100 Hz), using the same fused sampling as Controller::run.
+// Every tick is timed individually and medians are used, which keeps the numbers stable on noisy
+// machines. Cost = median of ticks that took a sample x sample count + median of the other ticks.
+//
+// Two clocks are reported. Simulation thread CPU time is what recording adds to the tick itself; the
+// target is < 5%. Wall time additionally includes the writer thread whenever it has to share a core
+// with the simulation (e.g. a single-core machine), since it then preempts the ticks.
+//
+// Usage: bench_trajectory [entities] [rate_hz] [file] [--json report]   (default 10000 100 /tmp/msf_bench_trajectory.msft)
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <time.h>
+#include <vector>
+
+#include "BenchReport.hpp"
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "PhysicsEntity.hpp"
+#include "TickEngine.hpp"
+#include "TrajectoryRecorder.hpp"
+
+namespace {
+
+constexpr double kDt = 0.001;
+constexpr int kTicks = 2000;
+
+class OrbitEntity : public PhysicsEntity {
+public:
+    OrbitEntity(const std::string& name, double phase) : PhysicsEntity(name), phase_(phase) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<OrbitEntity>("orbit", phase_);
+    }
+
+    void update(const double t, const double dt) override {
+        set_acceleration(Vec3(-std::sin(t + phase_), std::cos(t + phase_), 0.0));
+        PhysicsEntity::update(t, dt);
+    }
+
+private:
+    double phase_;
+};
+
+struct Samples {
+    std::vector<double> plain;    // Ticks without a sample, in microseconds
+    std::vector<double> sampling; // Ticks that captured a trajectory frame
+};
+
+struct TickTimes {
+    Samples wall;
+    Samples cpu; // Simulation thread CPU time
+    uint64_t frames = 0;
+};
+
+double median(std::vector<double> values) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+    return values[values.size() / 2];
+}
+
+double thread_cpu_us() {
+    timespec now{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec * 1e6 + now.tv_nsec / 1e3;
+}
+
+// Percent added to total tick time, from per-tick medians
+double overhead_percent(const Samples& baseline, const Samples& recording) {
+    const double base = median(baseline.plain) * kTicks;
+    const double with_recording = median(recording.plain) * recording.plain.size()
+                                + median(recording.sampling) * recording.sampling.size();
+    return 100.0 * (with_recording - base) / base;
+}
+
+// Records trajectories to `path` when it is non-empty.
+TickTimes run(std::size_t entity_count, double rate_hz, const std::string& path) {
+    EntityRegistry registry;
+    for (std::size_t i = 0; i < entity_count; ++i) {
+        registry.register_entity(std::make_shared<OrbitEntity>("orbit_" + std::to_string(i), 0.001 * i));
+    }
+    TickEngine engine;
+    engine.configure(1, 0);
+
+    TrajectoryRecorder recorder;
+    if (!path.empty() && !recorder.open(path, rate_hz)) {
+        std::exit(EXIT_FAILURE);
+    }
+
+    TickTimes times;
+    double t = 0.0;
+    for (int i = 0; i < kTicks; ++i) {
+        const auto wall_start = std::chrono::steady_clock::now();
+        const double cpu_start = thread_cpu_us();
+        // Same fused sampling as Controller::run
+        TickObserver* sampler = recorder.begin_sample(registry, t + kDt);
+        engine.tick(registry, t, kDt, sampler);
+        recorder.finish_sample();
+        const double cpu = thread_cpu_us() - cpu_start;
+        const double wall = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - wall_start).count();
+        (sampler != nullptr ? times.wall.sampling : times.wall.plain).push_back(wall);
+        (sampler != nullptr ? times.cpu.sampling : times.cpu.plain).push_back(cpu);
+        t += kDt;
+    }
+    times.frames = recorder.get_frames_recorded();
+    recorder.close(); // Waits for the writer; that tail is not part of the per-tick cost
+    return times;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    msf::Logger::instance().set_level(msf::LogLevel::Warning);
+
+    const bench::Args args = bench::parse_args(argc, argv, "trajectory");
+    const auto& pos = args.positional;
+    const std::size_t entity_count = pos.size() > 0 ? std::strtoul(pos[0].c_str(), nullptr, 10) : 10000;
+    const double rate_hz = pos.size() > 1 ? std::strtod(pos[1].c_str(), nullptr) : 100.0;
+    const std::string path = pos.size() > 2 ? pos[2] : "/tmp/msf_bench_trajectory.msft";
+
+    const TickTimes baseline = run(entity_count, rate_hz, "");
+    const TickTimes recording = run(entity_count, rate_hz, path);
+    std::remove(path.c_str());
+
+    std::printf("entities=%zu rate=%.0fHz ticks=%d frames=%llu\n", entity_count, rate_hz, kTicks,
+                static_cast<unsigned long long>(recording.frames));
+    std::printf("  %-18s %12s %12s %12s %10s\n", "median tick (us)", "baseline", "plain", "sampling", "overhead");
+    std::printf("  %-18s %12.3f %12.3f %12.3f %9.2f%%\n", "sim thread cpu", median(baseline.cpu.plain),
+                median(recording.cpu.plain), median(recording.cpu.sampling), overhead_percent(baseline.cpu, recording.cpu));
+    std::printf("  %-18s %12.3f %12.3f %12.3f %9.2f%%\n", "wall", median(baseline.wall.plain),
+                median(recording.wall.plain), median(recording.wall.sampling), overhead_percent(baseline.wall, recording.wall));
+
+    bench::JsonReport report("trajectory");
+    report.config().set("entities", entity_count).set("rate_hz", rate_hz).set("ticks", kTicks).set("dt", kDt);
+    report.add_result("sim_thread_cpu")
+        .set("baseline_tick_us", median(baseline.cpu.plain))
+        .set("plain_tick_us", median(recording.cpu.plain))
+        .set("sampling_tick_us", median(recording.cpu.sampling))
+        .set("overhead_percent", overhead_percent(baseline.cpu, recording.cpu));
+    report.add_result("wall")
+        .set("baseline_tick_us", median(baseline.wall.plain))
+        .set("plain_tick_us", median(recording.wall.plain))
+        .set("sampling_tick_us", median(recording.wall.sampling))
+        .set("overhead_percent", overhead_percent(baseline.wall, recording.wall))
+        .set("frames", recording.frames);
+    return report.write(args.json_path) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
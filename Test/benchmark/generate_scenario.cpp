@@ -0,0 +1,42 @@
+// msf_generate_scenario: write a synthetic SCF file with N missile/waypoint entities.
+//
+// Usage: msf_generate_scenario <entities> <output.xml> [missile_fraction] [trigger_fraction] [seed]
+//   e.g. msf_generate_scenario 1000000 large_1m.xml        (half missiles, 10% with a trigger, seed 1)
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include "ScenarioGenerator.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <entities> <output.xml> [missile_fraction] [trigger_fraction] [seed]\n";
+        return EXIT_FAILURE;
+    }
+
+    bench::ScenarioOptions options;
+    options.entities = std::strtoull(argv[1], nullptr, 10);
+    const std::string path = argv[2];
+    if (argc > 3) {
+        options.missile_fraction = std::strtod(argv[3], nullptr);
+    }
+    if (argc > 4) {
+        options.trigger_fraction = std::strtod(argv[4], nullptr);
+    }
+    if (argc > 5) {
+        options.seed = std::strtoull(argv[5], nullptr, 10);
+    }
+    if (options.entities == 0 || options.missile_fraction < 0.0 || options.missile_fraction > 1.0
+        || options.trigger_fraction < 0.0 || options.trigger_fraction > 1.0) {
+        std::cerr << "Entity count must be positive and fractions must be in [0, 1]\n";
+        return EXIT_FAILURE;
+    }
+
+    if (!bench::write_scenario(path, options)) {
+        std::cerr << "Failed to write scenario " << path << "\n";
+        return EXIT_FAILURE;
+    }
+    std::cout << "Wrote " << options.entities << " entities to " << path << "\n";
+    return EXIT_SUCCESS;
+}
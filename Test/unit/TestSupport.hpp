@@ -0,0 +1,81 @@
+/*
+* @file:   TestSupport.hpp
+* @brief:  Helpers shared by the unit tests.
+*/
+#pragma once
+
+#include <cstring>
+
+#include "Vec3.hpp"
+
+// True if both vectors hold bit-identical components (stricter than ==: tells -0.0 from 0.0)
+inline bool same_bits(const Vec3& a, const Vec3& b) {
+    const double lhs[3] = {a.get_x(), a.get_y(), a.get_z()};
+    const double rhs[3] = {b.get_x(), b.get_y(), b.get_z()};
+    return std::memcmp(lhs, rhs, sizeof(lhs)) == 0;
+}
+
+// Global allocation counting, for tests that check a path never touches the heap. Replacing the
+// global operator new can only happen once per program, so a test opts in by defining
+// MSF_TEST_COUNT_ALLOCATIONS before including this header. Logging must be off while counting, or
+// the logger's writer thread allocations are counted too.
+#ifdef MSF_TEST_COUNT_ALLOCATIONS
+#include <cstdlib>
+#include <new>
+
+namespace msf_test {
+inline bool g_counting = false;
+inline std::size_t g_allocations = 0;
+
+// Run body and return the number of global allocations it made
+template <typename Body>
+std::size_t count_allocations(Body&& body) {
+    g_allocations = 0;
+    g_counting = true;
+    body();
+    g_counting = false;
+    return g_allocations;
+}
+} // namespace msf_test
+
+// The replacements are kept out of line so the compiler does not pair an inlined free() with a
+// builtin operator new. The aligned overloads are replaced too: BlockPool grows through them.
+[[gnu::noinline]] void* operator new(std::size_t size) {
+    if (msf_test::g_counting) {
+        ++msf_test::g_allocations;
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (msf_test::g_counting) {
+        ++msf_test::g_allocations;
+    }
+    // aligned_alloc wants a non-zero size that is a multiple of the alignment
+    const auto align = static_cast<std::size_t>(alignment);
+    const std::size_t rounded = size == 0 ? align : (size + align - 1) / align * align;
+    if (void* ptr = std::aligned_alloc(align, rounded)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+#endif // MSF_TEST_COUNT_ALLOCATIONS
@@ -27,6 +27,13 @@ void test_default_options() {
     assert(error.empty());
     assert(!options.show_help);
     assert(options.scenario_path == "Test/scenario/basic.xml");
+    assert(options.tick_threads == 0);
+    assert(options.log_level == "debug");
+    assert(!options.profile);
+    assert(options.trace_path.empty());
+    assert(options.fast_forward);
+    assert(options.time_scale < 0.0);
+    assert(options.tick_deadline_ms < 0.0);
 }
 
 void test_help_flag() {
@@ -89,6 +96,208 @@ void test_unknown_argument() {
     assert(error.find("Unknown argument") != std::string::npos);
 }
 
+void test_threads_flag() {
+    std::vector<std::string> args = {"msf_simulation", "-j", "4"};
+    auto argv = make_argv(args);
+
+    ArgParse::Options options;
+    std::string error;
+
+    const bool ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(ok);
+    assert(options.tick_threads == 4);
+}
+
+void test_threads_equals_auto() {
+    std::vector<std::string> args = {"msf_simulation", "--threads=auto"};
+    auto argv = make_argv(args);
+
+    ArgParse::Options options;
+    std::string error;
+
+    const bool ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(ok);
+    assert(options.tick_threads >= 1);
+}
+
+void test_invalid_threads_value() {
+    std::vector<std::string> args = {"msf_simulation", "--threads", "0"};
+    auto argv = make_argv(args);
+
+    ArgParse::Options options;
+    std::string error;
+
+    const bool ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(!ok);
+    assert(error.find("Invalid value") != std::string::npos);
+}
+
+void test_log_level_flag() {
+    std::vector<std::string> args = {"msf_simulation", "--log-level=warning"};
+    auto argv = make_argv(args);
+
+    ArgParse::Options options;
+    std::string error;
+
+    const bool ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(ok);
+    assert(options.log_level == "warning");
+}
+
+void test_invalid_log_level() {
+    std::vector<std::string> args = {"msf_simulation", "--log-level", "verbose"};
+    auto argv = make_argv(args);
+
+    ArgParse::Options options;
+    std::string error;
+
+    const bool ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(!ok);
+    assert(error.find("Invalid value") != std::string::npos);
+}
+
+void test_profile_flags() {
+    std::vector<std::string> args = {"msf_simulation", "--trace", "trace.json", "--trace-ticks=250"};
+    auto argv = make_argv(args);
+
+    ArgParse::Options options;
+    std::string error;
+
+    const bool ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(ok);
+    assert(options.profile); // --trace implies --profile
+    assert(options.trace_path == "trace.json");
+    assert(options.trace_ticks == 250);
+}
+
+void test_invalid_trace_ticks() {
+    std::vector<std::string> args = {"msf_simulation", "--profile", "--trace-ticks", "0"};
+    auto argv = make_argv(args);
+
+    ArgParse::Options options;
+    std::string error;
+
+    const bool ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(!ok);
+    assert(error.find("Invalid value") != std::string::npos);
+}
+
+void test_no_fast_forward_flag() {
+    std::vector<std::string> args = {"msf_simulation", "--no-fast-forward"};
+    auto argv = make_argv(args);
+
+    ArgParse::Options options;
+    std::string error;
+
+    const bool ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(ok);
+    assert(!options.fast_forward);
+}
+
+void test_no_branches_flag() {
+    std::vector<std::string> args = {"msf_simulation", "--no-branches"};
+    auto argv = make_argv(args);
+
+    ArgParse::Options options;
+    std::string error;
+
+    assert(options.branches);
+    const bool ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(ok);
+    assert(!options.branches);
+}
+
+void test_time_scale_flag() {
+    std::vector<std::string> args = {"msf_simulation", "--time-scale", "2.5"};
+    auto argv = make_argv(args);
+
+    ArgParse::Options options;
+    std::string error;
+
+    bool ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(ok);
+    assert(options.time_scale == 2.5);
+
+    for (const char* invalid : {"--time-scale=0.01", "--time-scale=500", "--time-scale=fast", "--time-scale=2x"}) {
+        args = {"msf_simulation", invalid};
+        argv = make_argv(args);
+        ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+        assert(!ok);
+        assert(error.find("Invalid value") != std::string::npos);
+    }
+
+    args = {"msf_simulation", "--time-scale=0"}; // Explicitly unpaced, overriding the SCF
+    argv = make_argv(args);
+    ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(ok && options.time_scale == 0.0);
+}
+
+void test_tick_deadline_flag() {
+    std::vector<std::string> args = {"msf_simulation", "--tick-deadline=0.5"};
+    auto argv = make_argv(args);
+
+    ArgParse::Options options;
+    std::string error;
+
+    bool ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(ok);
+    assert(options.tick_deadline_ms == 0.5);
+
+    args = {"msf_simulation", "--tick-deadline", "-1"};
+    argv = make_argv(args);
+    ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(!ok);
+    assert(error.find("Invalid value") != std::string::npos);
+}
+
+void test_batch_flags() {
+    std::vector<std::string> args = {"msf_simulation",       "--replicas",      "64",     "--seed=18446744073709551615",
+                                     "--batch-threads=auto", "--batch-results", "out.csv"};
+    auto argv = make_argv(args);
+
+    ArgParse::Options options;
+    std::string error;
+
+    assert(options.replicas == 0 && options.seed == 1 && options.batch_results_path.empty());
+    bool ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(ok);
+    assert(options.replicas == 64);
+    assert(options.seed == 18446744073709551615ULL);
+    assert(options.batch_threads >= 1);
+    assert(options.batch_results_path == "out.csv");
+
+    for (const char* invalid : {"--replicas=0", "--replicas=-3", "--seed=-1", "--seed=0x10", "--seed=18446744073709551616",
+                                "--batch-threads=none"}) {
+        args = {"msf_simulation", invalid};
+        argv = make_argv(args);
+        ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+        assert(!ok);
+        assert(error.find("Invalid value") != std::string::npos);
+    }
+}
+
+void test_state_hash_flags() {
+    std::vector<std::string> args = {"msf_simulation", "--state-hash", "run.msfh", "--state-hash-interval=25"};
+    auto argv = make_argv(args);
+
+    ArgParse::Options options;
+    std::string error;
+
+    assert(options.state_hash_path.empty() && options.state_hash_interval == 100);
+    bool ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+    assert(ok);
+    assert(options.state_hash_path == "run.msfh");
+    assert(options.state_hash_interval == 25);
+
+    for (const char* invalid : {"--state-hash-interval=0", "--state-hash-interval=2.5", "--state-hash-interval=4294967296"}) {
+        args = {"msf_simulation", invalid};
+        argv = make_argv(args);
+        ok = ArgParse::parse(static_cast<int>(argv.size()), argv.data(), options, error);
+        assert(!ok);
+        assert(error.find("Invalid value") != std::string::npos);
+    }
+}
+
 } // namespace
 
 int main() {
@@ -98,5 +307,18 @@ int main() {
     test_long_scenario_equals_flag();
     test_missing_scenario_value();
     test_unknown_argument();
+    test_threads_flag();
+    test_threads_equals_auto();
+    test_invalid_threads_value();
+    test_log_level_flag();
+    test_invalid_log_level();
+    test_profile_flags();
+    test_invalid_trace_ticks();
+    test_no_fast_forward_flag();
+    test_no_branches_flag();
+    test_time_scale_flag();
+    test_tick_deadline_flag();
+    test_batch_flags();
+    test_state_hash_flags();
     return 0;
 }
@@ -0,0 +1,201 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "ArgParse.hpp"
+#include "BatchRunner.hpp"
+#include "Controller.hpp"
+#include "Entity.hpp"
+#include "Logger.hpp"
+
+namespace {
+
+const char* kScenario = R"(<?xml version="1.0" encoding="UTF-8"?>
+<MSFScenario>
+    <SimulationSetup>
+        <TimeStepInterval>0.01</TimeStepInterval>
+        <ParallelTick threads="1" grain="0"/>
+    </SimulationSetup>
+    <SimulationEntities>
+        <SimulationEntity name="interceptor">
+            <ModelClass>missile</ModelClass>
+            <ModelType>dynamic</ModelType>
+            <EmplacementData>
+                <position x="0.0" y="0.0" z="0.0"/>
+            </EmplacementData>
+        </SimulationEntity>
+        <SimulationEntity name="chaser">
+            <ModelClass>missile</ModelClass>
+            <ModelType>sleeping</ModelType>
+            <EmplacementData>
+                <position x="30.0" y="40.0" z="-12.0"/>
+            </EmplacementData>
+            <EventTriggers>
+                <trigger time="1.0" type="WAKE" delay="0.0"/>
+            </EventTriggers>
+        </SimulationEntity>
+        <SimulationEntity name="target">
+            <ModelClass>waypoint</ModelClass>
+            <ModelType>static</ModelType>
+            <EmplacementData>
+                <position x="30.0" y="40.0" z="0.0"/>
+            </EmplacementData>
+        </SimulationEntity>
+    </SimulationEntities>
+</MSFScenario>
+)";
+
+std::string write_scenario() {
+    const std::string path = "test_batch_runner.xml";
+    std::ofstream(path) << kScenario;
+    return path;
+}
+
+ArgParse::Options batch_options(const std::string& path, std::size_t replicas, std::size_t threads) {
+    ArgParse::Options options;
+    options.scenario_path = path;
+    options.replicas = replicas;
+    options.batch_threads = threads;
+    options.seed = 41;
+    return options;
+}
+
+double closest_approach(const Controller::RunOutcome& outcome, const std::string& missile) {
+    for (const auto& approach : outcome.closest_approaches) {
+        if (approach.first == missile) {
+            return approach.second;
+        }
+    }
+    return -1.0;
+}
+
+void test_statistics_summary() {
+    BatchStatistics statistics;
+    for (const double value : {5.0, 1.0, 4.0, std::numeric_limits<double>::infinity(), 2.0, 3.0}) {
+        statistics.add("x", value);
+    }
+    statistics.add("y", 7.0);
+
+    assert((statistics.get_metrics() == std::vector<std::string>{"x", "y"}));
+    const BatchStatistics::Summary x = statistics.summarize("x");
+    assert(x.count == 5); // The infinite sample is dropped
+    assert(x.mean == 3.0);
+    assert(std::fabs(x.stddev - std::sqrt(2.5)) < 1e-12);
+    assert(x.min == 1.0 && x.max == 5.0);
+    assert(std::fabs(x.p5 - 1.2) < 1e-12);
+    assert(x.p50 == 3.0);
+    assert(std::fabs(x.p95 - 4.8) < 1e-12);
+
+    const BatchStatistics::Summary y = statistics.summarize("y");
+    assert(y.count == 1 && y.stddev == 0.0 && y.p5 == 7.0 && y.p95 == 7.0);
+    assert(statistics.summarize("z").count == 0);
+}
+
+void test_replica_seeds() {
+    assert(BatchRunner::replica_seed(41, 0) == 41);
+    assert(BatchRunner::replica_seed(41, 3) == 44);
+}
+
+// Replicas run in their own Controller and ID space, so the batch result can't depend on the thread count
+void test_batch_independent_of_thread_count(const std::string& path) {
+    Entity::set_next_id(1000); // The caller's ID counter is left alone
+    BatchRunner serial(batch_options(path, 4, 1));
+    assert(serial.run());
+    assert(Entity::get_next_id() == 1000);
+
+    BatchRunner parallel(batch_options(path, 4, 4));
+    assert(parallel.run());
+
+    const auto& a = serial.get_outcomes();
+    const auto& b = parallel.get_outcomes();
+    assert(a.size() == 4 && b.size() == 4);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        assert(a[i].ok && b[i].ok);
+        assert(a[i].index == i && b[i].index == i);
+        assert(a[i].seed == 41 + i && b[i].seed == a[i].seed);
+        assert(a[i].run.end_time == b[i].run.end_time);
+        assert(a[i].run.ticks == b[i].run.ticks);
+        assert(a[i].run.entity_count == 3 && b[i].run.entity_count == 3);
+        assert(a[i].run.closest_approaches == b[i].run.closest_approaches);
+
+        // Neither missile moves, so the miss distance is the distance from its emplacement
+        assert(std::fabs(closest_approach(a[i].run, "interceptor") - 50.0) < 1e-9);
+        assert(std::fabs(closest_approach(a[i].run, "chaser") - 12.0) < 1e-9);
+    }
+
+    for (const std::string& metric : {std::string("end_time"), std::string("miss_distance[interceptor]")}) {
+        const BatchStatistics::Summary s = serial.get_statistics().summarize(metric);
+        const BatchStatistics::Summary p = parallel.get_statistics().summarize(metric);
+        assert(s.count == 4 && p.count == 4);
+        assert(s.mean == p.mean && s.stddev == p.stddev && s.p50 == p.p50);
+    }
+}
+
+// A replica is the same run as a standalone Controller started from a fresh ID counter
+void test_replica_matches_standalone_run(const std::string& path) {
+    BatchRunner batch(batch_options(path, 1, 1));
+    assert(batch.run());
+
+    Entity::set_next_id(0);
+    ArgParse::Options options;
+    options.scenario_path = path;
+    Controller controller;
+    assert(controller.initialize(options));
+    controller.run();
+    assert(Entity::get_next_id() == 3);
+
+    const Controller::RunOutcome& standalone = controller.get_outcome();
+    const Controller::RunOutcome& replica = batch.get_outcomes().front().run;
+    assert(standalone.end_time == replica.end_time);
+    assert(standalone.ticks == replica.ticks);
+    assert(standalone.entity_count == replica.entity_count);
+    assert(controller.get_seed() == options.seed);
+}
+
+void test_results_csv(const std::string& path) {
+    const std::string csv = "test_batch_runner.csv";
+    ArgParse::Options options = batch_options(path, 3, 2);
+    options.batch_results_path = csv;
+    BatchRunner batch(options);
+    assert(batch.run());
+
+    std::ifstream in(csv);
+    std::string line;
+    std::vector<std::string> lines;
+    while (std::getline(in, line)) {
+        lines.push_back(line);
+    }
+    assert(lines.size() == 4);
+    assert(lines[0] ==
+           "replica,seed,ok,end_time,ticks,entities,wall_ms,miss_distance[interceptor],miss_distance[chaser]");
+    assert(lines[1].rfind("0,41,1,", 0) == 0);
+    assert(lines[3].rfind("2,43,1,", 0) == 0);
+    in.close();
+    std::remove(csv.c_str());
+}
+
+void test_missing_scenario() {
+    BatchRunner batch(batch_options("does_not_exist.xml", 2, 1));
+    assert(!batch.run());
+    assert(batch.get_outcomes().empty());
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    const std::string path = write_scenario();
+    test_statistics_summary();
+    test_replica_seeds();
+    test_batch_independent_of_thread_count(path);
+    test_replica_matches_standalone_run(path);
+    test_results_csv(path);
+    test_missing_scenario();
+    std::remove(path.c_str());
+    return 0;
+}
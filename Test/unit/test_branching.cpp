@@ -0,0 +1,259 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "Checkpoint.hpp"
+#include "Clock.hpp"
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "Missile.hpp"
+#include "SCF.hpp"
+#include "Scheduler.hpp"
+#include "TickEngine.hpp"
+
+namespace {
+
+constexpr double kDt = 0.001;
+
+const char* kScenario = R"(<?xml version="1.0" encoding="UTF-8"?>
+<MSFScenario>
+    <SimulationSetup>
+        <TimeStepInterval>0.001</TimeStepInterval>
+    </SimulationSetup>
+    <Branches at="1.0">
+        <Branch name="nominal"/>
+        <Branch name="moved">
+            <Override entity="cruiser">
+                <EmplacementData>
+                    <position x="500.0" y="0.0" z="0.0"/>
+                </EmplacementData>
+            </Override>
+        </Branch>
+        <Branch name="parked">
+            <Override entity="cruiser">
+                <ModelType>static</ModelType>
+                <EntityParameters>
+                    <parameter name="update_rate" value="250.0" unit="Hz"/>
+                </EntityParameters>
+                <EventTriggers>
+                    <trigger time="1.5" type="WAKE" delay="0.0"/>
+                </EventTriggers>
+            </Override>
+        </Branch>
+        <Branch/>
+        <Branch name="nominal"/>
+        <Branch name="ghost">
+            <Override entity="nobody"/>
+        </Branch>
+    </Branches>
+    <SimulationEntities>
+        <SimulationEntity name="cruiser">
+            <ModelClass>missile</ModelClass>
+            <ModelType>dynamic</ModelType>
+            <EmplacementData>
+                <position x="0.0" y="0.0" z="0.0"/>
+            </EmplacementData>
+        </SimulationEntity>
+        <SimulationEntity name="sleeper">
+            <ModelClass>missile</ModelClass>
+            <ModelType>sleeping</ModelType>
+            <EmplacementData>
+                <position x="0.0" y="100.0" z="0.0"/>
+            </EmplacementData>
+            <EventTriggers>
+                <trigger time="0.5" type="WAKE" delay="0.0"/>
+            </EventTriggers>
+        </SimulationEntity>
+        <SimulationEntity name="goal">
+            <ModelClass>waypoint</ModelClass>
+            <ModelType>static</ModelType>
+            <EmplacementData>
+                <position x="1000.0" y="0.0" z="0.0"/>
+            </EmplacementData>
+        </SimulationEntity>
+    </SimulationEntities>
+</MSFScenario>
+)";
+
+struct World {
+    SimulationClock clock;
+    SimEventScheduler scheduler;
+    EntityRegistry registry;
+    TickEngine engine;
+
+    World() {
+        registry.register_classes();
+        registry.attach_scheduler(scheduler);
+    }
+
+    Checkpoint::EventBinder binder() {
+        return [this](const EventTag& tag, EventDescriptionId description_id) -> EventCallback {
+            if (std::shared_ptr<Entity> entity = registry.get_entity(tag.entity_id)) {
+                return SCF::make_trigger_callback(description_id, *entity, tag);
+            }
+            return {};
+        };
+    }
+
+    // Same order as Controller::run_loop, stopping at the safe point where the Controller forks branches
+    void run_until(double end) {
+        while (true) {
+            registry.apply_pending_removals();
+            registry.schedule_entitiy_events(scheduler, clock);
+            if (clock.now() >= end) {
+                return;
+            }
+            scheduler.process_events(clock);
+            engine.tick(registry, clock.now(), kDt);
+            clock.advance(kDt);
+        }
+    }
+
+    PhysicsState state_of(const std::string& name) const {
+        const auto entity = std::dynamic_pointer_cast<PhysicsEntity>(registry.get_entity_by_name(name));
+        assert(entity);
+        return registry.get_physics_store().get_state(entity->get_physics_slot());
+    }
+};
+
+std::string write_scenario() {
+    const std::string path = "test_branching.xml";
+    std::ofstream(path) << kScenario;
+    return path;
+}
+
+// Velocities are not part of the SCF yet, so the test sets them after loading
+void load(World& world, SCF& scf) {
+    msf::SimDt dt = 0.0;
+    assert(scf.parse_scf(world.registry, dt));
+    assert(dt == kDt);
+    std::static_pointer_cast<Missile>(world.registry.get_entity_by_name("cruiser"))->set_velocity(Vec3(10.0, 0.0, 0.0));
+    std::static_pointer_cast<Missile>(world.registry.get_entity_by_name("sleeper"))->set_velocity(Vec3(0.0, 0.0, 2.0));
+}
+
+bool same_state(const PhysicsState& a, const PhysicsState& b) {
+    return std::memcmp(&a, &b, sizeof(PhysicsState)) == 0;
+}
+
+void test_parse_branch_plan(const std::string& path) {
+    SCF scf(path);
+    World world;
+    msf::SimDt dt = 0.0;
+    assert(scf.parse_scf(world.registry, dt));
+
+    // The unnamed and duplicate branches are dropped
+    const SCF::BranchPlan& plan = scf.get_branch_plan();
+    assert(plan.is_enabled());
+    assert(plan.time == 1.0);
+    assert(plan.branches.size() == 4);
+    assert(plan.branches[0].name == "nominal" && plan.branches[0].overrides.empty());
+    assert(plan.branches[1].name == "moved" && plan.branches[1].overrides.size() == 1);
+    assert(plan.branches[2].name == "parked");
+    assert(plan.branches[3].name == "ghost");
+    assert(!scf.apply_branch(world.registry, plan.branches[3]));
+
+    assert(!SCF::BranchPlan{}.is_enabled());
+}
+
+void test_scheduler_clear() {
+    SimulationClock clock;
+    for (SimEventScheduler::Backend backend :
+         {SimEventScheduler::Backend::BinaryHeap, SimEventScheduler::Backend::TimingWheel}) {
+        SimEventScheduler scheduler;
+        scheduler.configure(backend, kDt);
+        int fired = 0;
+        for (int i = 0; i < 10; ++i) {
+            scheduler.schedule_event(clock, [&fired]() { ++fired; }, 0.001 * i);
+        }
+        const EventHandle handle = scheduler.schedule_event(clock, [&fired]() { ++fired; }, 0.5);
+        scheduler.clear();
+        assert(scheduler.empty());
+        assert(!scheduler.is_pending(handle));
+        assert(std::isinf(scheduler.next_event_time()));
+
+        scheduler.schedule_event(clock, [&fired]() { ++fired; }, 0.0);
+        scheduler.process_events(clock);
+        assert(fired == 1);
+    }
+}
+
+// Simulate the prefix once, then restore it into the same world for every branch (as Controller::run_branches
+// does) and run each to t=2
+void test_branches_continue_from_shared_prefix(const std::string& path) {
+    World reference;
+    SCF reference_scf(path);
+    load(reference, reference_scf);
+    reference.run_until(2.0);
+
+    World world;
+    SCF scf(path);
+    load(world, scf);
+    world.run_until(1.0);
+    const double fork_time = world.clock.now();
+    const PhysicsState cruiser_at_fork = world.state_of("cruiser");
+
+    Checkpoint::RunState fork_state;
+    fork_state.sim_time = fork_time;
+    fork_state.dt = kDt;
+    fork_state.tick_frame = world.engine.get_frame();
+    StateWriter prefix;
+    std::size_t skipped = 0;
+    std::string error;
+    assert(Checkpoint::capture(fork_state, world.registry, world.scheduler, prefix, skipped, error));
+    assert(skipped == 0);
+    const int next_id = Entity::get_next_id();
+
+    std::map<std::string, std::map<std::string, PhysicsState>> results;
+    for (const SCF::Branch& branch : scf.get_branch_plan().branches) {
+        world.registry.shutdown();
+        world.scheduler.clear();
+        Checkpoint::RunState run;
+        assert(Checkpoint::restore(prefix.bytes().data(), prefix.size(), run, world.registry, world.scheduler,
+                                   world.binder(), error));
+        assert(Entity::get_next_id() == next_id); // Every branch hands out the same IDs
+        world.clock.reset(run.sim_time);
+        world.engine.set_frame(run.tick_frame);
+        scf.apply_branch(world.registry, branch);
+        world.run_until(2.0);
+
+        assert(world.registry.get_entity_count() == 3);
+        for (const char* name : {"cruiser", "sleeper", "goal"}) {
+            results[branch.name][name] = world.state_of(name);
+        }
+    }
+
+    // Without overrides a branch is the straight run
+    for (const char* name : {"cruiser", "sleeper", "goal"}) {
+        assert(same_state(results["nominal"][name], reference.state_of(name)));
+    }
+
+    // Overrides only touch their entity
+    for (const char* branch : {"moved", "parked"}) {
+        assert(same_state(results[branch]["sleeper"], reference.state_of("sleeper")));
+        assert(same_state(results[branch]["goal"], reference.state_of("goal")));
+    }
+    const double end_x = reference.state_of("cruiser").position.get_x();
+    assert(std::fabs(results["moved"]["cruiser"].position.get_x() - (end_x + 500.0 - cruiser_at_fork.position.get_x())) < 1e-6);
+
+    // Parked until its WAKE trigger at 1.5, so half a second short of the reference
+    assert(std::fabs(results["parked"]["cruiser"].position.get_x() - (end_x - 5.0)) < 0.05);
+    assert(results["ghost"]["cruiser"].position.get_x() == end_x);
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    const std::string path = write_scenario();
+    test_parse_branch_plan(path);
+    test_scheduler_clear();
+    test_branches_continue_from_shared_prefix(path);
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,310 @@
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Checkpoint.hpp"
+#include "Clock.hpp"
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "Missile.hpp"
+#include "SCF.hpp"
+#include "Scheduler.hpp"
+#include "TickEngine.hpp"
+#include "Waypoint.hpp"
+
+namespace {
+
+constexpr double kDt = 0.001;
+
+struct World {
+    SimulationClock clock;
+    SimEventScheduler scheduler;
+    EntityRegistry registry;
+    TickEngine engine;
+    int shutdowns = 0;
+    int opaque_fired = 0;
+
+    World() {
+        registry.register_classes();
+        registry.attach_scheduler(scheduler);
+    }
+
+    Checkpoint::EventBinder binder() {
+        return [this](const EventTag& tag, EventDescriptionId description_id) -> EventCallback {
+            if (tag.kind == EventKind::Shutdown) {
+                return [this]() { ++shutdowns; };
+            }
+            if (std::shared_ptr<Entity> entity = registry.get_entity(tag.entity_id)) {
+                return SCF::make_trigger_callback(description_id, *entity, tag);
+            }
+            return {};
+        };
+    }
+
+    Checkpoint::RunState run_state() const {
+        Checkpoint::RunState run;
+        run.sim_time = clock.now();
+        run.dt = kDt;
+        run.tick_frame = engine.get_frame();
+        run.seed = 0xC0FFEE;
+        return run;
+    }
+
+    // Same order as Controller::run. at_safe_point(now) runs where the Controller takes checkpoints.
+    template <typename Fn>
+    void run_until(double end, Fn&& at_safe_point) {
+        while (clock.now() < end - 0.5 * kDt) {
+            registry.apply_pending_removals();
+            registry.schedule_entitiy_events(scheduler, clock);
+            at_safe_point(clock.now());
+            scheduler.process_events(clock);
+            engine.tick(registry, clock.now(), kDt);
+            clock.advance(kDt);
+        }
+    }
+};
+
+void request_trigger(Entity& entity, const std::string& type, double time) {
+    const EventDescriptionId type_id = intern_event_description(type);
+    const EventTag tag = SCF::make_trigger_tag(type, entity);
+    entity.request_event(EventRequest{entity.get_id(), time, type_id, SCF::make_trigger_callback(type_id, entity, tag), tag});
+}
+
+// Moving, sleeping and rate-grouped missiles, a waypoint, a despawned entity (leaving a free slot and
+// an ID gap), SCF triggers on both sides of t=1, an untagged event and a tagged shutdown event.
+void build_scenario(World& world) {
+    auto cruiser = std::static_pointer_cast<Missile>(world.registry.create_entity_from_string("missile"));
+    cruiser->set_name("cruiser");
+    cruiser->set_velocity(Vec3(10.0, 0.0, 0.0));
+    cruiser->set_acceleration(Vec3(0.0, 1.0, 0.0));
+    world.registry.register_entity(cruiser);
+
+    auto doomed = world.registry.create_entity_from_string("waypoint");
+    world.registry.register_entity(doomed);
+
+    auto sleeper = std::static_pointer_cast<Missile>(world.registry.create_entity_from_string("missile"));
+    sleeper->set_name("sleeper");
+    sleeper->set_velocity(Vec3(0.0, 0.0, 5.0));
+    sleeper->set_activity(ActivityState::Sleeping);
+    request_trigger(*sleeper, "WAKE", 0.4);
+    request_trigger(*sleeper, "SLEEP", 0.8);
+    request_trigger(*sleeper, "WAKE", 1.5);
+    request_trigger(*sleeper, "STAGE2", 1.5); // Same time, logs only
+    world.registry.register_entity(sleeper);
+
+    auto slow = std::static_pointer_cast<Missile>(world.registry.create_entity_from_string("missile"));
+    slow->set_name("slow");
+    slow->set_velocity(Vec3(1.0, 1.0, 1.0));
+    slow->set_acceleration(Vec3(0.5, 0.0, -0.25));
+    slow->set_update_rate(250.0);
+    world.registry.register_entity(slow);
+
+    auto goal = std::static_pointer_cast<Waypoint>(world.registry.create_entity_from_string("waypoint"));
+    goal->set_name("goal");
+    goal->set_waypoint(Vec3(100.0, 0.0, 0.0), 2.5);
+    goal->set_activity(ActivityState::Static);
+    world.registry.register_entity(goal);
+
+    world.registry.remove_entity(doomed->get_id());
+
+    world.scheduler.schedule_event(world.clock, [&world]() { ++world.opaque_fired; }, 1.8);
+    EventTag shutdown;
+    shutdown.kind = EventKind::Shutdown;
+    world.scheduler.schedule_event(world.clock, [&world]() { ++world.shutdowns; }, 1.9, kNoEventDescription, shutdown);
+}
+
+// Entities created after the restore point get the same ID and slot in both runs
+void spawn_late(World& world, double now, std::shared_ptr<Entity>& late) {
+    if (!late && now >= 1.2) {
+        late = world.registry.spawn<Waypoint>("late");
+    }
+}
+
+void assert_same_world(const World& a, const World& b) {
+    assert(a.registry.get_entity_count() == b.registry.get_entity_count());
+    assert(a.clock.now() == b.clock.now());
+    assert(a.engine.get_frame() == b.engine.get_frame());
+    a.registry.for_each_entity([&a, &b](const Entity& entity) {
+        const std::shared_ptr<Entity> twin = b.registry.get_entity(entity.get_id());
+        assert(twin);
+        assert(twin->get_name() == entity.get_name());
+        assert(twin->get_handle().index == entity.get_handle().index);
+        assert(twin->get_activity() == entity.get_activity());
+        assert(twin->get_update_rate() == entity.get_update_rate());
+        const auto& physics = dynamic_cast<const PhysicsEntity&>(entity);
+        const auto& twin_physics = dynamic_cast<const PhysicsEntity&>(*twin);
+        const PhysicsState state = a.registry.get_physics_store().get_state(physics.get_physics_slot());
+        const PhysicsState twin_state = b.registry.get_physics_store().get_state(twin_physics.get_physics_slot());
+        assert(std::memcmp(&state, &twin_state, sizeof(PhysicsState)) == 0);
+    });
+}
+
+void test_state_stream() {
+    StateWriter out;
+    out.write(uint32_t{7});
+    out.write_string("hello");
+    out.write(2.5);
+
+    StateReader in(out.bytes().data(), out.size());
+    assert(in.read<uint32_t>() == 7);
+    assert(in.read_string() == "hello");
+    assert(in.read<double>() == 2.5);
+    assert(in.is_done());
+
+    // A short buffer fails instead of reading past its end
+    StateReader truncated(out.bytes().data(), out.size() - 1);
+    truncated.read<uint32_t>();
+    truncated.read_string();
+    assert(truncated.read<double>() == 0.0);
+    assert(!truncated.is_ok());
+}
+
+void test_pending_events_in_firing_order() {
+    SimulationClock clock;
+    SimEventScheduler scheduler;
+    EventTag tag;
+    tag.kind = EventKind::Trigger;
+    const EventHandle late = scheduler.schedule_event(clock, []() {}, 3.0, kNoEventDescription, tag);
+    tag.entity_id = 1;
+    scheduler.schedule_event(clock, []() {}, 2.0, kNoEventDescription, tag);
+    tag.entity_id = 2;
+    scheduler.schedule_event(clock, []() {}, 2.0, kNoEventDescription, tag);
+    const EventHandle cancelled = scheduler.schedule_event(clock, []() {}, 1.0);
+    scheduler.cancel(cancelled);
+    scheduler.reschedule(clock, late, 0.5);
+
+    const auto pending = scheduler.get_pending_events();
+    assert(pending.size() == 3);
+    assert(pending[0].execution_time == 0.5 && pending[0].tag.entity_id == -1);
+    assert(pending[1].execution_time == 2.0 && pending[1].tag.entity_id == 1);
+    assert(pending[2].execution_time == 2.0 && pending[2].tag.entity_id == 2);
+}
+
+// Checkpoint at t=1, keep going to t=2, then restore the checkpoint elsewhere and run the same second:
+// the two worlds end up bit-identical.
+void test_restore_continues_identically(SimEventScheduler::Backend backend) {
+    const int first_id = Entity::get_next_id();
+    World original;
+    original.scheduler.configure(backend, kDt);
+    build_scenario(original);
+
+    StateWriter snapshot;
+    std::size_t skipped = 0;
+    int next_id_at_checkpoint = -1;
+    std::shared_ptr<Entity> original_late;
+    original.run_until(2.0, [&](double now) {
+        if (snapshot.size() == 0 && now >= 1.0) {
+            std::string error;
+            assert(Checkpoint::capture(original.run_state(), original.registry, original.scheduler, snapshot, skipped,
+                                       error));
+            next_id_at_checkpoint = Entity::get_next_id();
+        }
+        spawn_late(original, now, original_late);
+    });
+    assert(skipped == 1); // The untagged event
+    assert(original.opaque_fired == 1 && original.shutdowns == 1);
+    assert(original.registry.get_entity_by_name("sleeper")->is_active());
+    const int next_id_after_run = Entity::get_next_id();
+
+    // Restoring sets the ID counter back, so the late spawn gets the same ID again
+    World restored;
+    restored.scheduler.configure(backend, kDt);
+    Checkpoint::RunState run;
+    std::string error;
+    assert(Checkpoint::restore(snapshot.bytes().data(), snapshot.size(), run, restored.registry, restored.scheduler,
+                               restored.binder(), error));
+    assert(Entity::get_next_id() == next_id_at_checkpoint);
+    assert(run.dt == kDt && run.sim_time >= 1.0 - 1e-9);
+    assert(run.seed == 0xC0FFEE);
+    restored.clock.reset(run.sim_time);
+    restored.engine.set_frame(run.tick_frame);
+    assert(restored.registry.get_entity_count() == 4);
+    assert(restored.registry.get_entity_by_name("cruiser")->get_id() == first_id);
+    assert(restored.registry.get_entity_by_name("sleeper")->get_activity() == ActivityState::Sleeping);
+    assert(std::static_pointer_cast<Waypoint>(restored.registry.get_entity_by_name("goal"))
+               ->is_reached(Vec3(98.0, 0.0, 0.0)));
+
+    std::shared_ptr<Entity> restored_late;
+    restored.run_until(2.0, [&](double now) { spawn_late(restored, now, restored_late); });
+    assert(restored.shutdowns == 1 && restored.opaque_fired == 0);
+    assert(Entity::get_next_id() == next_id_after_run);
+    assert(restored_late->get_id() == original_late->get_id());
+    assert_same_world(original, restored);
+
+    // Removing a restored entity cancels its restored events
+    World again;
+    assert(Checkpoint::restore(snapshot.bytes().data(), snapshot.size(), run, again.registry, again.scheduler,
+                               again.binder(), error));
+    const std::size_t events = again.scheduler.size();
+    again.registry.remove_entity(again.registry.get_entity_by_name("sleeper")->get_handle());
+    again.registry.apply_pending_removals();
+    assert(again.scheduler.size() == events - 2); // WAKE and STAGE2 at 1.5; WAKE and SLEEP before 1 already fired
+}
+
+void test_writer_and_bad_files() {
+    const std::string path = "test_checkpoint.ckpt";
+    World world;
+    build_scenario(world);
+    world.run_until(0.5, [](double) {});
+
+    CheckpointWriter writer;
+    assert(writer.open(path, 0.25, world.clock.now()));
+    assert(writer.next_checkpoint_time() > 0.74 && writer.next_checkpoint_time() <= 0.75);
+    assert(!writer.is_due(world.clock.now()));
+    assert(writer.save(world.run_state(), world.registry, world.scheduler));
+    writer.close();
+    assert(writer.get_checkpoints_written() == 1);
+    assert(std::fopen((path + ".tmp").c_str(), "rb") == nullptr);
+
+    World restored;
+    Checkpoint::RunState run;
+    std::string error;
+    assert(Checkpoint::restore_file(path, run, restored.registry, restored.scheduler, restored.binder(), error));
+    assert(restored.registry.get_entity_count() == world.registry.get_entity_count());
+    assert(restored.scheduler.size() == world.scheduler.size() - 1); // Minus the untagged event
+
+    // Only into an empty world
+    assert(!Checkpoint::restore_file(path, run, restored.registry, restored.scheduler, restored.binder(), error));
+
+    // Truncated file
+    std::vector<char> bytes;
+    {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        char buffer[4096];
+        std::size_t read = 0;
+        while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            bytes.insert(bytes.end(), buffer, buffer + read);
+        }
+        std::fclose(file);
+    }
+    for (std::size_t size : {std::size_t{0}, std::size_t{10}, bytes.size() / 2, bytes.size() - 1}) {
+        World target;
+        error.clear();
+        assert(!Checkpoint::restore(bytes.data(), size, run, target.registry, target.scheduler, target.binder(), error));
+        assert(!error.empty());
+    }
+    bytes[0] = 'X';
+    World target;
+    assert(!Checkpoint::restore(bytes.data(), bytes.size(), run, target.registry, target.scheduler, target.binder(), error));
+    assert(error == "Not a checkpoint file");
+
+    assert(!Checkpoint::restore_file("does_not_exist.ckpt", run, target.registry, target.scheduler, target.binder(),
+                                     error));
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    test_state_stream();
+    test_pending_events_in_firing_order();
+    test_restore_continues_identically(SimEventScheduler::Backend::BinaryHeap);
+    test_restore_continues_identically(SimEventScheduler::Backend::TimingWheel);
+    test_writer_and_bad_files();
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Clock.hpp"
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "PhysicsEntity.hpp"
+#include "SCF.hpp"
+#include "Scheduler.hpp"
+#include "TickEngine.hpp"
+
+namespace {
+
+// Coasts at constant velocity; optionally goes to sleep after `awake_ticks` updates.
+class Coaster : public PhysicsEntity {
+public:
+    Coaster(const std::string& name, int awake_ticks = -1) : PhysicsEntity(name), awake_ticks_(awake_ticks) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<Coaster>("coaster", awake_ticks_);
+    }
+
+    void update(const double t, const double dt) override {
+        ++updates;
+        if (updates == awake_ticks_) {
+            set_activity(ActivityState::Sleeping);
+        }
+        PhysicsEntity::update(t, dt);
+    }
+
+    int updates = 0;
+
+private:
+    int awake_ticks_;
+};
+
+class CountingObserver : public TickObserver {
+public:
+    void on_entity_updated(std::size_t, const Entity&) override {
+        ++calls;
+    }
+    int calls = 0;
+};
+
+std::shared_ptr<Coaster> add(EntityRegistry& registry, const std::string& name, ActivityState state,
+                             int awake_ticks = -1) {
+    auto entity = std::make_shared<Coaster>(name, awake_ticks);
+    entity->set_velocity(Vec3(1.0, 0.0, 0.0));
+    entity->set_activity(state);
+    registry.register_entity(entity);
+    return entity;
+}
+
+// Sleeping and static entities are neither updated nor integrated; observers still see them.
+void test_inactive_entities_are_skipped(std::size_t threads) {
+    EntityRegistry registry;
+    auto active = add(registry, "active", ActivityState::Active);
+    auto sleeping = add(registry, "sleeping", ActivityState::Sleeping);
+    auto fixed = add(registry, "fixed", ActivityState::Static);
+    auto napper = add(registry, "napper", ActivityState::Active, 3); // Falls asleep during its 3rd update
+
+    TickEngine engine;
+    engine.configure(threads, 1);
+    CountingObserver observer;
+    for (int tick = 0; tick < 10; ++tick) {
+        engine.tick(registry, tick * 0.1, 0.1, tick == 9 ? &observer : nullptr);
+    }
+
+    assert(active->updates == 10);
+    assert(sleeping->updates == 0 && fixed->updates == 0);
+    assert(napper->updates == 3 && napper->get_activity() == ActivityState::Sleeping);
+    assert(active->get_position().get_x() > 0.99);
+    assert(sleeping->get_position().get_x() == 0.0 && fixed->get_position().get_x() == 0.0);
+    assert(napper->get_position().get_x() > 0.29 && napper->get_position().get_x() < 0.31);
+    assert(observer.calls == 4);
+
+    // Waking takes effect on the next tick
+    sleeping->set_activity(ActivityState::Active);
+    engine.tick(registry, 1.0, 0.1);
+    assert(sleeping->updates == 1 && sleeping->get_position().get_x() > 0.0);
+    assert(fixed->updates == 0);
+}
+
+// A LAUNCH trigger wakes a sleeping SCF entity at its trigger time.
+void test_scf_launch_trigger() {
+    const std::string path = "/tmp/msf_test_entity_activity.xml";
+    FILE* file = std::fopen(path.c_str(), "w");
+    assert(file != nullptr);
+    std::fputs("<?xml version=\"1.0\"?>\n"
+               "<MSFScenario>\n"
+               "  <SimulationSetup><TimeStepInterval>0.01</TimeStepInterval></SimulationSetup>\n"
+               "  <SimulationEntities>\n"
+               "    <SimulationEntity name=\"interceptor\">\n"
+               "      <ModelClass>missile</ModelClass>\n"
+               "      <ModelType>sleeping</ModelType>\n"
+               "      <EmplacementData><position x=\"0\" y=\"0\" z=\"0\"/></EmplacementData>\n"
+               "      <EventTriggers><trigger time=\"0.5\" type=\"LAUNCH\" delay=\"0.0\"/></EventTriggers>\n"
+               "    </SimulationEntity>\n"
+               "    <SimulationEntity name=\"target\">\n"
+               "      <ModelClass>waypoint</ModelClass>\n"
+               "      <ModelType>static</ModelType>\n"
+               "      <EmplacementData><position x=\"100\" y=\"0\" z=\"0\"/></EmplacementData>\n"
+               "    </SimulationEntity>\n"
+               "  </SimulationEntities>\n"
+               "</MSFScenario>\n",
+               file);
+    std::fclose(file);
+
+    EntityRegistry registry;
+    registry.register_classes();
+    msf::SimDt dt = 0.0;
+    SCF scf(path);
+    const bool parsed = scf.parse_scf(registry, dt);
+    assert(parsed);
+    auto interceptor = std::static_pointer_cast<Missile>(registry.get_entity_by_name("interceptor"));
+    assert(interceptor->get_activity() == ActivityState::Sleeping);
+    assert(registry.get_entity_by_name("target")->get_activity() == ActivityState::Static);
+    interceptor->set_velocity(Vec3(10.0, 0.0, 0.0));
+
+    SimulationClock clock;
+    clock.reset(0.0);
+    SimEventScheduler scheduler;
+    registry.attach_scheduler(scheduler);
+    TickEngine engine;
+    double launched_at = -1.0;
+    while (clock.now() < 1.0 - 1e-9) {
+        registry.apply_pending_removals();
+        registry.schedule_entitiy_events(scheduler, clock);
+        scheduler.process_events(clock);
+        if (launched_at < 0.0 && interceptor->is_active()) {
+            launched_at = clock.now();
+        }
+        engine.tick(registry, clock.now(), dt);
+        clock.advance(dt);
+    }
+
+    assert(launched_at > 0.49 && launched_at < 0.51);
+    // Coasted for the ~0.5 s after launch only
+    assert(interceptor->get_position().get_x() > 4.9 && interceptor->get_position().get_x() < 5.1);
+    registry.shutdown();
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    test_inactive_entities_are_skipped(1);
+    test_inactive_entities_are_skipped(3);
+    test_scf_launch_trigger();
+    return 0;
+}
@@ -0,0 +1,137 @@
+#define MSF_TEST_COUNT_ALLOCATIONS
+
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "BlockPool.hpp"
+#include "Clock.hpp"
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "Missile.hpp"
+#include "Scheduler.hpp"
+#include "TestSupport.hpp"
+#include "Waypoint.hpp"
+
+namespace {
+
+// Freed blocks are reused LIFO; oversized requests bypass the pool.
+void test_block_pool_recycles() {
+    auto pool = std::make_shared<msf::BlockPool>(4);
+    assert(pool->block_size() == 0);
+    void* first = pool->allocate(40, alignof(double));
+    assert(pool->block_size() >= 40 && pool->block_size() % alignof(std::max_align_t) == 0);
+    std::vector<void*> blocks{first};
+    for (int i = 0; i < 5; ++i) {
+        blocks.push_back(pool->allocate(40, alignof(double)));
+    }
+    assert(pool->size() == 6 && pool->capacity() == 8);
+
+    void* big = pool->allocate(pool->block_size() * 2, alignof(double));
+    pool->deallocate(big, pool->block_size() * 2, alignof(double));
+    assert(pool->size() == 6);
+
+    pool->deallocate(blocks[2], 40, alignof(double));
+    assert(pool->allocate(40, alignof(double)) == blocks[2]);
+    for (void* block : blocks) {
+        pool->deallocate(block, 40, alignof(double));
+    }
+    assert(pool->size() == 0 && pool->capacity() == 8);
+
+    // Filling the free list is allocation-free; the ninth block grows the pool, which is counted
+    blocks.clear();
+    assert(msf_test::count_allocations([&]() {
+        for (int i = 0; i < 8; ++i) {
+            blocks.push_back(pool->allocate(40, alignof(double)));
+        }
+    }) == 0);
+    assert(msf_test::count_allocations([&]() { blocks.push_back(pool->allocate(40, alignof(double))); }) > 0);
+    assert(pool->capacity() == 12);
+    for (void* block : blocks) {
+        pool->deallocate(block, 40, alignof(double));
+    }
+}
+
+// Spawned entities come from per-class pools; entities may outlive the registry that made them.
+void test_spawn_uses_class_pools() {
+    std::shared_ptr<Missile> survivor;
+    std::weak_ptr<msf::BlockPool> missile_pool;
+    {
+        EntityRegistry registry;
+        registry.register_classes();
+        survivor = registry.spawn<Missile>("survivor");
+        auto waypoint = registry.spawn_entity_from_string("waypoint", "wp");
+        assert(waypoint && waypoint->get_name() == "wp");
+        assert(registry.spawn_entity_from_string("no_such_class", "x") == nullptr);
+        assert(registry.get_entity_count() == 2);
+
+        missile_pool = registry.entity_pool<Missile>();
+        assert(registry.entity_pool<Missile>() != registry.entity_pool<Waypoint>());
+        assert(registry.entity_pool<Missile>()->size() == 1);
+        assert(registry.entity_pool<Waypoint>()->size() == 1);
+
+        registry.despawn(waypoint->get_handle());
+        registry.apply_pending_removals();
+        waypoint.reset();
+        assert(registry.entity_pool<Waypoint>()->size() == 0);
+    }
+    // The pool lives as long as the entities allocated from it
+    assert(!missile_pool.expired() && missile_pool.lock()->size() == 1);
+    assert(survivor->get_name() == "survivor");
+    survivor.reset();
+    assert(missile_pool.expired());
+}
+
+// Once the pools and registry containers have grown, spawn/despawn cycles never allocate.
+void test_spawn_despawn_cycles_do_not_allocate() {
+    constexpr int kPerCycle = 1000;
+    SimulationClock clock;
+    SimEventScheduler scheduler;
+    EntityRegistry registry;
+    registry.attach_scheduler(scheduler);
+    registry.register_classes();
+    registry.spawn<Waypoint>("anchor");
+
+    std::vector<EntityHandle> handles;
+    handles.reserve(2 * kPerCycle);
+    const auto cycle = [&]() {
+        for (int i = 0; i < kPerCycle; ++i) {
+            handles.push_back(registry.spawn<Missile>("debris")->get_handle());
+            handles.push_back(registry.spawn_entity_from_string("waypoint", "decoy")->get_handle());
+        }
+        for (const EntityHandle handle : handles) {
+            registry.despawn(handle);
+        }
+        handles.clear();
+        registry.apply_pending_removals();
+    };
+
+    cycle();
+    const std::size_t missile_capacity = registry.entity_pool<Missile>()->capacity();
+    const std::size_t allocations = msf_test::count_allocations([&]() {
+        for (int i = 0; i < 5; ++i) {
+            cycle();
+        }
+    });
+
+    if (allocations != 0) {
+        std::fprintf(stderr, "unexpected allocations on the spawn path: %zu\n", allocations);
+    }
+    assert(allocations == 0);
+    assert(registry.get_entity_count() == 1);
+    assert(registry.entity_pool<Missile>()->size() == 0);
+    assert(registry.entity_pool<Missile>()->capacity() == missile_capacity);
+    registry.shutdown();
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    test_block_pool_recycles();
+    test_spawn_uses_class_pools();
+    test_spawn_despawn_cycles_do_not_allocate();
+    return 0;
+}
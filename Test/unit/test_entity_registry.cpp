@@ -0,0 +1,172 @@
+#include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Clock.hpp"
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "PhysicsEntity.hpp"
+#include "Scheduler.hpp"
+#include "TickEngine.hpp"
+
+namespace {
+
+// Shuts itself down from update() once the simulation reaches `shutdown_at`.
+class ExpiringEntity : public PhysicsEntity {
+public:
+    ExpiringEntity(const std::string& name, double shutdown_at) : PhysicsEntity(name), shutdown_at_(shutdown_at) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<ExpiringEntity>("expiring", shutdown_at_);
+    }
+
+    void update(const double t, const double dt) override {
+        ++updates;
+        if (t >= shutdown_at_) {
+            shutdown();
+        }
+        PhysicsEntity::update(t, dt);
+    }
+
+    int updates = 0;
+
+private:
+    double shutdown_at_;
+};
+
+std::vector<std::string> dense_names(EntityRegistry& registry) {
+    std::vector<std::string> names;
+    registry.for_each_entity([&names](Entity& entity) { names.push_back(entity.get_name()); });
+    return names;
+}
+
+// Handles resolve in O(1) until their entity is removed, and stay stale after the slot is reused.
+void test_generational_handles() {
+    EntityRegistry registry;
+    auto first = std::make_shared<ExpiringEntity>("first", 1e9);
+    auto second = std::make_shared<ExpiringEntity>("second", 1e9);
+    const EntityHandle first_handle = registry.register_entity(first);
+    const EntityHandle second_handle = registry.register_entity(second);
+    assert(first_handle != second_handle);
+    assert(first->get_handle() == first_handle);
+    assert(registry.get_entity(first_handle) == first);
+    assert(registry.get_handle(second->get_id()) == second_handle);
+    assert(registry.get_entity(second->get_id()) == second);
+
+    registry.remove_entity(first_handle);
+    assert(registry.is_alive(first_handle)); // Deferred until the safe point
+    assert(registry.apply_pending_removals() == 1);
+    assert(!registry.is_alive(first_handle));
+    assert(registry.get_entity(first_handle) == nullptr);
+    assert(registry.get_entity(first->get_id()) == nullptr);
+    assert(!first->get_handle().is_valid());
+
+    // The freed slot is reused with a new generation
+    auto third = std::make_shared<ExpiringEntity>("third", 1e9);
+    const EntityHandle third_handle = registry.register_entity(third);
+    assert(third_handle.index == first_handle.index);
+    assert(third_handle.generation != first_handle.generation);
+    assert(registry.get_entity(first_handle) == nullptr);
+    assert(registry.get_entity(third_handle) == third);
+
+    // Removing through a stale handle does nothing
+    registry.remove_entity(first_handle);
+    assert(registry.apply_pending_removals() == 0);
+    assert(registry.get_entity_count() == 2);
+}
+
+// Iteration order depends only on the sequence of registrations and removals.
+void test_deterministic_order() {
+    std::vector<std::string> orders[2];
+    for (auto& order : orders) {
+        EntityRegistry registry;
+        std::vector<EntityHandle> handles;
+        for (const char* name : {"a", "b", "c", "d", "e"}) {
+            handles.push_back(registry.register_entity(std::make_shared<ExpiringEntity>(name, 1e9)));
+        }
+        assert((dense_names(registry) == std::vector<std::string>{"a", "b", "c", "d", "e"}));
+
+        registry.remove_entity(handles[1]);
+        registry.remove_entity(handles[3]);
+        registry.apply_pending_removals();
+        registry.register_entity(std::make_shared<ExpiringEntity>("f", 1e9));
+        order = dense_names(registry);
+    }
+    assert((orders[0] == std::vector<std::string>{"a", "e", "c", "f"}));
+    assert(orders[0] == orders[1]);
+}
+
+// Entities that shut down during a (parallel) tick stay registered until the safe point, which then
+// cancels their scheduled events.
+void test_shutdown_during_tick() {
+    SimulationClock clock;
+    SimEventScheduler scheduler;
+    EntityRegistry registry;
+    registry.attach_scheduler(scheduler);
+
+    std::vector<std::shared_ptr<ExpiringEntity>> entities;
+    for (int i = 0; i < 64; ++i) {
+        auto entity = std::make_shared<ExpiringEntity>("expiring_" + std::to_string(i), i % 2 == 0 ? 0.0 : 1e9);
+        entity->request_event(EventRequest{entity->get_id(), 5.0, kNoEventDescription, []() {}});
+        registry.register_entity(entity);
+        entities.push_back(entity);
+    }
+    registry.schedule_entitiy_events(scheduler, clock);
+    assert(scheduler.size() == 64);
+
+    TickEngine engine;
+    engine.configure(4, 1);
+    const uint64_t revision = registry.get_revision();
+    engine.tick(registry, 0.0, 0.01);
+    engine.tick(registry, 0.01, 0.01); // Entities that shut down are still ticked until the safe point
+    assert(registry.get_entity_count() == 64);
+    assert(registry.get_revision() == revision);
+
+    assert(registry.apply_pending_removals() == 32);
+    assert(registry.get_entity_count() == 32);
+    assert(scheduler.size() == 32);
+    assert(registry.get_physics_store().size() == 32);
+    for (const auto& entity : entities) {
+        assert(entity->updates == 2);
+        assert(registry.is_alive(entity->get_handle()) == (entity->get_name().back() % 2 == 1));
+    }
+
+    engine.tick(registry, 0.02, 0.01);
+    assert(entities[0]->updates == 2 && entities[1]->updates == 3);
+    registry.shutdown();
+    assert(scheduler.empty());
+}
+
+// More shutdowns than the removal queue holds fall back to a full scan.
+void test_removal_queue_overflow() {
+    EntityRegistry registry;
+    const int count = static_cast<int>(EntityRegistry::kRemovalQueueCapacity) + 100;
+    for (int i = 0; i < count; ++i) {
+        registry.register_entity(std::make_shared<ExpiringEntity>("e", 1e9));
+    }
+    int shut_down = 0;
+    registry.for_each_entity([&shut_down](Entity& entity) {
+        if (entity.get_id() % 3 != 0) {
+            entity.shutdown();
+            entity.shutdown(); // Queued once
+            ++shut_down;
+        }
+    });
+    assert(registry.apply_pending_removals() == static_cast<size_t>(shut_down));
+    assert(registry.get_entity_count() == static_cast<size_t>(count - shut_down));
+    registry.for_each_entity([](Entity& entity) { assert(entity.get_id() % 3 == 0); });
+    assert(registry.apply_pending_removals() == 0);
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    test_generational_handles();
+    test_deterministic_order();
+    test_shutdown_during_tick();
+    test_removal_queue_overflow();
+    return 0;
+}
@@ -0,0 +1,82 @@
+#define MSF_TEST_COUNT_ALLOCATIONS
+
+#include <cassert>
+#include <cstdio>
+#include <memory>
+
+#include "Clock.hpp"
+#include "EntityRegistry.hpp"
+#include "EventRequest.hpp"
+#include "Logger.hpp"
+#include "Scheduler.hpp"
+#include "TestSupport.hpp"
+#include "Waypoint.hpp"
+
+namespace {
+
+constexpr double kDt = 0.001;
+constexpr int kEventsPerTick = 8;
+
+struct Harness {
+    SimulationClock clock;
+    SimEventScheduler scheduler;
+    EntityRegistry registry;
+    std::shared_ptr<Entity> entity;
+    EventDescriptionId description = intern_event_description("ALLOCATION_PROBE");
+    std::size_t fired = 0;
+
+    explicit Harness(SimEventScheduler::Backend backend) {
+        registry.register_classes();
+        entity = registry.create_entity_from_string("waypoint");
+        registry.register_entity(entity);
+        scheduler.configure(backend, kDt);
+    }
+
+    // One simulation tick of the full entity event path: request -> schedule -> fire.
+    void tick() {
+        for (int i = 1; i <= kEventsPerTick; ++i) {
+            entity->request_event(EventRequest{
+                entity->get_id(),
+                clock.now() + (i * 4 + 0.5) * kDt,
+                description,
+                [this]() { ++fired; },
+            });
+        }
+        registry.schedule_entitiy_events(scheduler, clock);
+        scheduler.process_events(clock);
+        clock.advance(kDt);
+    }
+};
+
+void check_backend(SimEventScheduler::Backend backend, int warmup_ticks) {
+    Harness harness(backend);
+
+    // Warm-up grows the node pool, heap storage and wheel slots to their steady-state size.
+    for (int i = 0; i < warmup_ticks; ++i) {
+        harness.tick();
+    }
+    const std::size_t fired_before = harness.fired;
+
+    const std::size_t allocations = msf_test::count_allocations([&]() {
+        for (int i = 0; i < 2000; ++i) {
+            harness.tick();
+        }
+    });
+
+    assert(harness.fired - fired_before >= 2000 * kEventsPerTick - kEventsPerTick * 33);
+    if (allocations != 0) {
+        std::fprintf(stderr, "unexpected allocations on the event path: %zu\n", allocations);
+    }
+    assert(allocations == 0);
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    check_backend(SimEventScheduler::Backend::BinaryHeap, 500);
+    // Level-1 wheel slots are only revisited after a full 256 * 256 tick rotation.
+    check_backend(SimEventScheduler::Backend::TimingWheel, 66000);
+    return 0;
+}
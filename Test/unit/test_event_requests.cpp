@@ -0,0 +1,140 @@
+#include <cassert>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Clock.hpp"
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "MpscQueue.hpp"
+#include "PhysicsEntity.hpp"
+#include "Scheduler.hpp"
+#include "TickEngine.hpp"
+
+namespace {
+
+// Requests one event per update while `active`, from whichever thread runs the update.
+class RequestingEntity : public PhysicsEntity {
+public:
+    RequestingEntity(const std::string& name, int* fired) : PhysicsEntity(name), fired_(fired) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<RequestingEntity>("requesting", fired_);
+    }
+
+    void update(const double t, const double dt) override {
+        if (active) {
+            int* fired = fired_;
+            request_event(EventRequest{get_id(), t + 10.0 * dt, kNoEventDescription, [fired]() { ++*fired; }});
+        }
+        PhysicsEntity::update(t, dt);
+    }
+
+    bool active = false;
+
+private:
+    int* fired_;
+};
+
+void test_mpsc_queue_delivers_every_value_once() {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 50000;
+    msf::MpscQueue<int> queue(1024);
+    assert(queue.capacity() == 1024);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < kPerProducer; ++i) {
+                while (!queue.push(p * kPerProducer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<int> last_seen(kProducers, -1);
+    int received = 0;
+    while (received < kProducers * kPerProducer) {
+        int value = 0;
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        // Values from one producer arrive in the order they were pushed
+        const int producer = value / kPerProducer;
+        assert(value % kPerProducer == last_seen[producer] + 1);
+        last_seen[producer] = value % kPerProducer;
+        ++received;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    int leftover = 0;
+    assert(!queue.pop(leftover));
+}
+
+// Requests made from parallel updates are collected, and only requesting entities are visited.
+void test_requests_from_parallel_updates(int entity_count) {
+    constexpr double kDt = 0.001;
+    SimulationClock clock;
+    SimEventScheduler scheduler;
+    EntityRegistry registry;
+    registry.attach_scheduler(scheduler);
+
+    int fired = 0;
+    std::vector<std::shared_ptr<RequestingEntity>> entities;
+    for (int i = 0; i < entity_count; ++i) {
+        auto entity = std::make_shared<RequestingEntity>("requesting_" + std::to_string(i), &fired);
+        entity->active = (i % 3) == 0;
+        registry.register_entity(entity);
+        entities.push_back(entity);
+    }
+    const int active_count = (entity_count + 2) / 3;
+
+    TickEngine engine;
+    engine.configure(4, 0);
+    for (int tick = 0; tick < 5; ++tick) {
+        engine.tick(registry, clock.now(), kDt);
+        registry.schedule_entitiy_events(scheduler, clock);
+        assert(static_cast<int>(scheduler.size()) == active_count * (tick + 1));
+        for (const auto& entity : entities) {
+            assert(entity->pending_events.empty());
+        }
+        clock.advance(kDt);
+    }
+
+    clock.advance(1.0);
+    scheduler.process_events(clock);
+    assert(fired == active_count * 5);
+}
+
+// A request made before the entity is registered (SCF triggers) is still collected.
+void test_requests_before_registration() {
+    SimulationClock clock;
+    SimEventScheduler scheduler;
+    EntityRegistry registry;
+
+    int fired = 0;
+    auto entity = std::make_shared<RequestingEntity>("early", &fired);
+    entity->request_event(EventRequest{entity->get_id(), 1.0, kNoEventDescription, [&fired]() { ++fired; }});
+    registry.register_entity(entity);
+
+    registry.schedule_entitiy_events(scheduler, clock);
+    assert(scheduler.size() == 1);
+    registry.schedule_entitiy_events(scheduler, clock); // Nothing new, nothing rescheduled
+    assert(scheduler.size() == 1);
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Warning);
+
+    test_mpsc_queue_delivers_every_value_once();
+    test_requests_from_parallel_updates(3000);
+    // More requesting entities than dirty-list slots exercises the full-scan fallback
+    test_requests_from_parallel_updates(3 * static_cast<int>(EntityRegistry::kEventRequestQueueCapacity) + 300);
+    test_requests_before_registration();
+    return 0;
+}
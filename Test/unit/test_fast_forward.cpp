@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Clock.hpp"
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "PhysicsEntity.hpp"
+#include "Scheduler.hpp"
+#include "TickEngine.hpp"
+#include "TrajectoryReader.hpp"
+#include "TrajectoryRecorder.hpp"
+
+namespace {
+
+// Coasts at constant velocity and counts its updates.
+class Coaster : public PhysicsEntity {
+public:
+    explicit Coaster(const std::string& name) : PhysicsEntity(name) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<Coaster>("coaster");
+    }
+
+    void update(const double t, const double dt) override {
+        ++updates;
+        PhysicsEntity::update(t, dt);
+    }
+
+    int updates = 0;
+};
+
+void test_clock_advance_until() {
+    const double dt = 0.001;
+    SimulationClock stepped;
+    SimulationClock jumped;
+    int steps = 0;
+    while (stepped.now() < 0.7371) {
+        stepped.advance(dt);
+        ++steps;
+    }
+    assert(jumped.advance_until(0.7371, dt) == static_cast<uint64_t>(steps));
+    assert(jumped.now() == stepped.now()); // Same rounding as repeated advance()
+
+    // Always at least one step, even when the target is already behind
+    assert(jumped.advance_until(0.0, dt) == 1);
+    jumped.pause_sim_time();
+    assert(jumped.advance_until(10.0, dt) == 0);
+}
+
+void test_registry_idle_queries() {
+    EntityRegistry registry;
+    auto coaster = std::make_shared<Coaster>("coaster");
+    registry.register_entity(coaster);
+    assert(registry.get_active_count() == 1);
+    coaster->set_activity(ActivityState::Sleeping);
+    assert(registry.get_active_count() == 0);
+
+    assert(!registry.has_pending_requests());
+    coaster->request_event(EventRequest{coaster->get_id(), 1.0, intern_event_description("PING"), []() {}});
+    assert(registry.has_pending_requests());
+    SimEventScheduler scheduler;
+    SimulationClock clock;
+    registry.schedule_entitiy_events(scheduler, clock);
+    assert(!registry.has_pending_requests());
+    registry.remove_entity(coaster->get_handle());
+    assert(registry.has_pending_requests());
+    registry.apply_pending_removals();
+    assert(!registry.has_pending_requests());
+}
+
+struct RunResult {
+    std::vector<Vec3> positions;
+    std::vector<double> event_times;
+    int updates = 0;
+    uint64_t loop_iterations = 0;
+    uint64_t frames = 0;
+};
+
+// Same loop body as Controller::run. A sleeper is woken at t=0.5003 and put back to sleep at 1.2;
+// a 250 Hz entity in a rate group wakes with it. The run stops at 3.0.
+RunResult run(bool fast_forward, const std::string& trajectory_path) {
+    const double dt = 0.001;
+    SimulationClock clock;
+    SimEventScheduler scheduler;
+    EntityRegistry registry;
+    registry.attach_scheduler(scheduler);
+
+    auto sleeper = std::make_shared<Coaster>("sleeper");
+    sleeper->set_velocity(Vec3(1.0, 0.5, 0.0));
+    sleeper->set_activity(ActivityState::Sleeping);
+    registry.register_entity(sleeper);
+    auto slow = std::make_shared<Coaster>("slow");
+    slow->set_velocity(Vec3(0.0, 2.0, 0.0));
+    slow->set_update_rate(250.0);
+    slow->set_activity(ActivityState::Sleeping);
+    registry.register_entity(slow);
+    auto fixed = std::make_shared<Coaster>("fixed");
+    fixed->set_activity(ActivityState::Static);
+    registry.register_entity(fixed);
+
+    RunResult result;
+    bool running = true;
+    scheduler.schedule_event(clock, [&]() {
+        result.event_times.push_back(clock.now());
+        sleeper->set_activity(ActivityState::Active);
+        slow->set_activity(ActivityState::Active);
+    }, 0.5003);
+    scheduler.schedule_event(clock, [&]() {
+        result.event_times.push_back(clock.now());
+        sleeper->set_activity(ActivityState::Sleeping);
+        slow->set_activity(ActivityState::Sleeping);
+    }, 1.2);
+    scheduler.schedule_event(clock, [&]() {
+        result.event_times.push_back(clock.now());
+        running = false;
+    }, 3.0);
+
+    TickEngine engine;
+    TrajectoryRecorder recorder;
+    const bool opened = recorder.open(trajectory_path, 7.0);
+    assert(opened);
+    recorder.record(registry, clock.now());
+
+    while (running) {
+        ++result.loop_iterations;
+        registry.apply_pending_removals();
+        registry.schedule_entitiy_events(scheduler, clock);
+        scheduler.process_events(clock);
+        if (!running) {
+            break;
+        }
+
+        if (fast_forward && registry.get_active_count() == 0 && !registry.has_pending_requests() &&
+            std::isfinite(scheduler.next_event_time())) {
+            const double target = std::min(scheduler.next_event_time(), recorder.next_sample_time());
+            engine.skip_ticks(clock.advance_until(target, dt));
+            recorder.record(registry, clock.now());
+            continue;
+        }
+
+        TickObserver* sampler = recorder.begin_sample(registry, clock.now() + dt);
+        engine.tick(registry, clock.now(), dt, sampler);
+        recorder.finish_sample();
+        clock.advance(dt);
+    }
+
+    result.frames = recorder.get_frames_recorded();
+    recorder.close();
+    result.positions = {sleeper->get_position(), slow->get_position(), fixed->get_position()};
+    result.updates = sleeper->updates + slow->updates + fixed->updates;
+    registry.shutdown();
+    return result;
+}
+
+std::vector<TrajectoryReader::Frame> read_frames(const std::string& path) {
+    TrajectoryReader reader;
+    const bool opened = reader.open(path);
+    assert(opened);
+    std::vector<TrajectoryReader::Frame> frames;
+    TrajectoryReader::Frame frame;
+    while (reader.next_frame(frame)) {
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+// Jumping over idle stretches is indistinguishable from stepping through them.
+void test_fast_forward_matches_stepping() {
+    const std::string stepped_path = "/tmp/msf_test_fast_forward_stepped.msft";
+    const std::string jumped_path = "/tmp/msf_test_fast_forward_jumped.msft";
+    const RunResult stepped = run(false, stepped_path);
+    const RunResult jumped = run(true, jumped_path);
+
+    assert(stepped.event_times.size() == 3);
+    assert(jumped.event_times == stepped.event_times);
+    assert(jumped.updates == stepped.updates && stepped.updates == 700 + 175);
+    for (std::size_t i = 0; i < stepped.positions.size(); ++i) {
+        assert(jumped.positions[i].get_x() == stepped.positions[i].get_x());
+        assert(jumped.positions[i].get_y() == stepped.positions[i].get_y());
+    }
+    assert(jumped.frames == stepped.frames && stepped.frames == 22);
+    // Same sample times and states; entity IDs differ because every run registers new entities
+    const auto stepped_frames = read_frames(stepped_path);
+    const auto jumped_frames = read_frames(jumped_path);
+    assert(jumped_frames.size() == stepped_frames.size());
+    for (std::size_t i = 0; i < stepped_frames.size(); ++i) {
+        assert(jumped_frames[i].time == stepped_frames[i].time);
+        assert(jumped_frames[i].columns == stepped_frames[i].columns);
+    }
+
+    // Only the 700 active ticks plus one iteration per event or output time are left
+    assert(stepped.loop_iterations > 3000);
+    assert(jumped.loop_iterations < 750);
+
+    std::remove(stepped_path.c_str());
+    std::remove(jumped_path.c_str());
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    test_clock_advance_until();
+    test_registry_idle_queries();
+    test_fast_forward_matches_stepping();
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Logger.hpp"
+
+namespace {
+
+// Everything the writer thread printed since the last call
+std::string take(std::ostringstream& stream) {
+    msf::Logger::instance().flush();
+    std::string text = stream.str();
+    stream.str("");
+    return text;
+}
+
+void test_formatting(std::ostringstream& out) {
+    const std::string name = "missile_1";
+    MSF_LOG_INFO("Registered entity: ID={}, Name='{}'", 7, name);
+    MSF_LOG_INFO("{} {} {} {}", -42, 18446744073709551615ULL, 0.25, 1e-7);
+    MSF_LOG_INFO("{:.3f} us/tick, {:.1e}", 12.34567, 1234.5);
+    MSF_LOG_INFO("{} {} {} {}", true, 'x', "literal", std::string_view("view"));
+    MSF_LOG_INFO("braces {{}} and missing {}");
+    MSF_LOG(msf::LogLevel::Info, "MISSILE", "Missile '{}' is running t={}", name, 3.0);
+
+    assert(take(out) ==
+           "[INFO] Registered entity: ID=7, Name='missile_1'\n"
+           "[INFO] -42 18446744073709551615 0.25 1e-07\n"
+           "[INFO] 12.346 us/tick, 1.2e+03\n"
+           "[INFO] true x literal view\n"
+           "[INFO] braces {} and missing {}\n"
+           "[MISSILE] Missile 'missile_1' is running t=3\n");
+}
+
+void test_levels(std::ostringstream& out, std::ostringstream& err) {
+    msf::Logger& logger = msf::Logger::instance();
+    logger.set_level(msf::LogLevel::Warning);
+    int evaluated = 0;
+    MSF_LOG_DEBUG("not printed {}", ++evaluated);
+    MSF_LOG_INFO("not printed {}", ++evaluated);
+    MSF_LOG_WARNING("printed {}", ++evaluated);
+    MSF_LOG_ERROR("printed {}", ++evaluated);
+    logger.set_level(msf::LogLevel::Debug);
+
+    // Arguments of filtered statements are never evaluated
+    assert(evaluated == 2);
+    assert(take(out).empty());
+    assert(take(err) == "[WARNING] printed 1\n[ERROR] printed 2\n");
+
+    msf::LogLevel level;
+    assert(msf::parse_log_level("warn", level) && level == msf::LogLevel::Warning);
+    assert(msf::parse_log_level("off", level) && level == msf::LogLevel::Off);
+    assert(!msf::parse_log_level("verbose", level));
+}
+
+void test_long_arguments_are_truncated(std::ostringstream& out) {
+    const std::string long_name(1000, 'a');
+    MSF_LOG_INFO("{} {}", long_name, 5);
+
+    const std::string line = take(out);
+    assert(line.rfind("[INFO] aaaa", 0) == 0);
+    assert(line.size() < 300);
+    assert(line.find(" [...]\n") != std::string::npos);
+}
+
+void test_concurrent_producers(std::ostringstream& out) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                MSF_LOG_INFO("{} {}", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every line arrives intact and each producer's lines stay in order
+    std::istringstream lines(take(out));
+    std::vector<int> next(kThreads, 0);
+    std::string tag;
+    int t = 0;
+    int i = 0;
+    int count = 0;
+    while (lines >> tag >> t >> i) {
+        assert(tag == "[INFO]");
+        assert(i == next[t]);
+        ++next[t];
+        ++count;
+    }
+    assert(count == kThreads * kPerThread);
+    assert(msf::Logger::instance().get_dropped() == 0);
+}
+
+} // namespace
+
+int main() {
+    // Redirect before the writer thread prints anything
+    std::ostringstream out;
+    std::ostringstream err;
+    std::streambuf* original_out = std::cout.rdbuf(out.rdbuf());
+    std::streambuf* original_err = std::cerr.rdbuf(err.rdbuf());
+
+    test_formatting(out);
+    test_levels(out, err);
+    test_long_arguments_are_truncated(out);
+    test_concurrent_producers(out);
+
+    msf::Logger::instance().flush();
+    std::cout.rdbuf(original_out);
+    std::cerr.rdbuf(original_err);
+    return 0;
+}
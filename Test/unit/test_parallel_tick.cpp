@@ -0,0 +1,81 @@
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "EntityRegistry.hpp"
+#include "PhysicsEntity.hpp"
+#include "TestSupport.hpp"
+#include "TickEngine.hpp"
+
+namespace {
+
+// Entity with state-dependent, non-trivial dynamics so any cross-entity interference or
+// reordering of floating point work would show up as a bit difference.
+class SwirlEntity : public PhysicsEntity {
+public:
+    SwirlEntity(const std::string& name, double phase) : PhysicsEntity(name), phase_(phase) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<SwirlEntity>("swirl", phase_);
+    }
+
+    void update(const double t, const double dt) override {
+        set_acceleration(Vec3(std::sin(t + phase_), std::cos(t * 0.5 + phase_), std::sin(phase_ - t))
+                         - get_velocity() * 0.01);
+        PhysicsEntity::update(t, dt);
+    }
+
+private:
+    double phase_;
+};
+
+std::vector<std::shared_ptr<Entity>> populate(EntityRegistry& registry, int count) {
+    std::vector<std::shared_ptr<Entity>> entities;
+    for (int i = 0; i < count; ++i) {
+        auto entity = std::make_shared<SwirlEntity>("swirl_" + std::to_string(i), 0.001 * i);
+        entity->set_position(Vec3(i, -i, 0.5 * i));
+        registry.register_entity(entity);
+        entities.push_back(entity);
+    }
+    return entities;
+}
+
+void run(TickEngine& engine, EntityRegistry& registry, int ticks, double dt) {
+    double t = 0.0;
+    for (int i = 0; i < ticks; ++i) {
+        engine.tick(registry, t, dt);
+        t += dt;
+    }
+}
+
+} // namespace
+
+int main() {
+    constexpr int kEntityCount = 2000;
+    constexpr int kTicks = 200;
+    constexpr double kDt = 0.001;
+
+    EntityRegistry serial_registry;
+    auto serial_entities = populate(serial_registry, kEntityCount);
+    TickEngine serial_engine;
+    serial_engine.configure(1, 0);
+    assert(!serial_engine.is_parallel());
+    run(serial_engine, serial_registry, kTicks, kDt);
+
+    for (std::size_t threads : {2u, 4u, 7u}) {
+        EntityRegistry parallel_registry;
+        auto parallel_entities = populate(parallel_registry, kEntityCount);
+        TickEngine parallel_engine;
+        parallel_engine.configure(threads, threads == 7 ? 13 : 0);
+        assert(parallel_engine.is_parallel());
+        assert(parallel_engine.get_thread_count() == threads);
+        run(parallel_engine, parallel_registry, kTicks, kDt);
+
+        for (int i = 0; i < kEntityCount; ++i) {
+            assert(same_bits(serial_entities[i]->get_position(), parallel_entities[i]->get_position()));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "PhysicsEntity.hpp"
+#include "PhysicsStore.hpp"
+#include "TestSupport.hpp"
+#include "TickEngine.hpp"
+
+namespace {
+
+class ThrustEntity : public PhysicsEntity {
+public:
+    ThrustEntity(const std::string& name, double phase) : PhysicsEntity(name), phase_(phase) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<ThrustEntity>("thrust", phase_);
+    }
+
+    void update(const double t, const double dt) override {
+        set_acceleration(Vec3(std::cos(t + phase_), std::sin(t - phase_), 0.1 * phase_));
+        set_angular_acceleration(Vec3(0.0, phase_, 0.0));
+        PhysicsEntity::update(t, dt);
+    }
+
+private:
+    double phase_;
+};
+
+class NullObserver : public TickObserver {
+public:
+    void on_entity_updated(std::size_t, const Entity&) override {}
+};
+
+std::vector<std::shared_ptr<ThrustEntity>> populate(EntityRegistry& registry, int count) {
+    std::vector<std::shared_ptr<ThrustEntity>> entities;
+    for (int i = 0; i < count; ++i) {
+        auto entity = std::make_shared<ThrustEntity>("thrust_" + std::to_string(i), 0.1 * i);
+        entity->set_position(Vec3(i, 2.0 * i, -i));
+        entity->set_velocity(Vec3(1.0, 0.0, 0.5 * i));
+        registry.register_entity(entity);
+        entities.push_back(entity);
+    }
+    return entities;
+}
+
+// State set before registration moves into the store and back out on removal; slots stay dense.
+void test_attach_detach_keeps_state() {
+    EntityRegistry registry;
+    auto entities = populate(registry, 4);
+    PhysicsStore& store = registry.get_physics_store();
+    assert(store.size() == 4);
+    for (int i = 0; i < 4; ++i) {
+        assert(entities[i]->is_attached());
+        assert(entities[i]->get_physics_slot() == static_cast<std::size_t>(i));
+        assert(same_bits(store.position.get(i), Vec3(i, 2.0 * i, -i)));
+    }
+
+    entities[1]->set_mass(42.0);
+    registry.remove_entity(entities[1]->get_id());
+    registry.apply_pending_removals();
+    assert(store.size() == 3);
+    assert(!entities[1]->is_attached());
+    assert(entities[1]->get_mass() == 42.0);
+    assert(same_bits(entities[1]->get_position(), Vec3(1.0, 2.0, -1.0)));
+
+    // The last slot filled the hole
+    assert(entities[3]->get_physics_slot() == 1);
+    assert(same_bits(entities[3]->get_position(), Vec3(3.0, 6.0, -3.0)));
+    assert(same_bits(entities[3]->get_velocity(), Vec3(1.0, 0.0, 1.5)));
+    assert(same_bits(entities[2]->get_position(), Vec3(2.0, 4.0, -2.0)));
+}
+
+// Deferred batch integration, per-entity integration (observer ticks) and a detached entity all agree.
+void test_deferred_matches_immediate() {
+    EntityRegistry deferred_registry;
+    EntityRegistry immediate_registry;
+    auto deferred = populate(deferred_registry, 16);
+    auto immediate = populate(immediate_registry, 16);
+    ThrustEntity loose("loose", 0.1 * 5);
+    loose.set_position(Vec3(5.0, 10.0, -5.0));
+    loose.set_velocity(Vec3(1.0, 0.0, 2.5));
+
+    TickEngine engine;
+    engine.configure(1, 0);
+    NullObserver observer;
+    const double dt = 0.01;
+    for (int tick = 0; tick < 200; ++tick) {
+        const double t = tick * dt;
+        engine.tick(deferred_registry, t, dt);
+        engine.tick(immediate_registry, t, dt, &observer);
+        loose.update(t, dt);
+    }
+
+    for (int i = 0; i < 16; ++i) {
+        assert(same_bits(deferred[i]->get_position(), immediate[i]->get_position()));
+        assert(same_bits(deferred[i]->get_velocity(), immediate[i]->get_velocity()));
+        assert(same_bits(deferred[i]->get_angular_velocity(), immediate[i]->get_angular_velocity()));
+    }
+    assert(same_bits(loose.get_position(), deferred[5]->get_position()));
+    assert(std::abs(deferred[0]->get_position().get_x()) > 0.0);
+
+    // Outside a tick, updates integrate immediately again
+    const Vec3 before = deferred[0]->get_position();
+    deferred[0]->update(2.0, dt);
+    assert(!same_bits(before, deferred[0]->get_position()));
+}
+
+// Entities still referenced elsewhere keep their state when the registry goes away
+void test_registry_teardown() {
+    std::shared_ptr<ThrustEntity> survivor;
+    {
+        EntityRegistry registry;
+        survivor = populate(registry, 3)[2];
+        survivor->apply_force(Vec3(1.0, 2.0, 3.0));
+        survivor->apply_force(Vec3(1.0, 0.0, 0.0));
+    }
+    assert(!survivor->is_attached());
+    assert(same_bits(survivor->get_position(), Vec3(2.0, 4.0, -2.0)));
+    assert(same_bits(survivor->get_force(), Vec3(2.0, 2.0, 3.0)));
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    test_attach_detach_keeps_state();
+    test_deferred_matches_immediate();
+    test_registry_teardown();
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Clock.hpp"
+#include "EntityRegistry.hpp"
+#include "EventDescription.hpp"
+#include "Logger.hpp"
+#include "PhysicsEntity.hpp"
+#include "Profiler.hpp"
+#include "Scheduler.hpp"
+#include "TickEngine.hpp"
+
+namespace {
+
+void test_disabled_records_nothing() {
+    msf::Profiler& profiler = msf::Profiler::instance();
+    profiler.reset();
+    profiler.set_enabled(false);
+    {
+        MSF_PROFILE_SCOPE("idle");
+    }
+    assert(profiler.get_stats().empty());
+}
+
+#if MSF_PROFILING // Otherwise every scope compiles to nothing and there is nothing to measure
+
+class ProbeEntity : public PhysicsEntity {
+public:
+    explicit ProbeEntity(const std::string& name) : PhysicsEntity(name) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<ProbeEntity>("probe");
+    }
+    void update(const double, const double dt) override {
+        set_position(get_position() + Vec3(dt, 0.0, 0.0));
+    }
+};
+
+const msf::ProfileStat* find_stat(const std::vector<msf::ProfileStat>& stats, msf::ProfileCategory category,
+                                  const std::string& name) {
+    for (const auto& stat : stats) {
+        if (stat.category == category && stat.name == name) {
+            return &stat;
+        }
+    }
+    return nullptr;
+}
+
+std::size_t count_occurrences(const std::string& text, const std::string& needle) {
+    std::size_t count = 0;
+    for (std::size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+void test_nested_scopes() {
+    msf::Profiler& profiler = msf::Profiler::instance();
+    profiler.reset();
+    profiler.set_enabled(true);
+    for (int i = 0; i < 3; ++i) {
+        MSF_PROFILE_SCOPE("outer");
+        {
+            MSF_PROFILE_SCOPE("inner");
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    profiler.set_enabled(false);
+
+    const auto stats = profiler.get_stats();
+    const msf::ProfileStat* outer = find_stat(stats, msf::ProfileCategory::Phase, "outer");
+    const msf::ProfileStat* inner = find_stat(stats, msf::ProfileCategory::Phase, "inner");
+    assert(outer != nullptr && inner != nullptr);
+    assert(outer->count == 3 && inner->count == 3);
+    assert(inner->min_ns >= 1000000);
+    assert(outer->total_ns >= inner->total_ns);
+    assert(outer->min_ns <= outer->max_ns);
+    assert(stats.front().name == "outer"); // Sorted by total time within a category
+}
+
+// Entity updates are grouped by dynamic class across pool threads, events by description.
+void test_entity_classes_and_events() {
+    msf::Profiler& profiler = msf::Profiler::instance();
+    profiler.reset();
+    profiler.set_enabled(true);
+
+    EntityRegistry registry;
+    for (int i = 0; i < 64; ++i) {
+        registry.register_entity(std::make_shared<ProbeEntity>("probe_" + std::to_string(i)));
+    }
+    TickEngine engine;
+    engine.configure(3, 8);
+    for (int tick = 0; tick < 5; ++tick) {
+        engine.tick(registry, tick * 0.01, 0.01);
+    }
+
+    SimulationClock clock;
+    clock.reset(0.0);
+    SimEventScheduler scheduler;
+    int fired = 0;
+    const EventDescriptionId stage = intern_event_description("STAGE2");
+    for (int i = 0; i < 4; ++i) {
+        scheduler.schedule_event(clock, [&fired]() { ++fired; }, 0.0, stage);
+    }
+    scheduler.schedule_event(clock, [&fired]() { ++fired; }, 0.0);
+    scheduler.process_events(clock);
+    profiler.set_enabled(false);
+    assert(fired == 5);
+
+    const auto stats = profiler.get_stats();
+    const msf::ProfileStat* probe = find_stat(stats, msf::ProfileCategory::EntityClass, "(anonymous namespace)::ProbeEntity");
+    assert(probe != nullptr);
+    assert(probe->count == 64 * 5);
+    const msf::ProfileStat* chunks = find_stat(stats, msf::ProfileCategory::Phase, "update_chunk");
+    assert(chunks != nullptr && chunks->count >= 5);
+
+    const msf::ProfileStat* staged = find_stat(stats, msf::ProfileCategory::EventType, "STAGE2");
+    const msf::ProfileStat* unnamed = find_stat(stats, msf::ProfileCategory::EventType, "(unnamed)");
+    assert(staged != nullptr && staged->count == 4);
+    assert(unnamed != nullptr && unnamed->count == 1);
+}
+
+// Only the first N ticks go into the trace; the summary keeps counting after that.
+void test_trace_window() {
+    const std::string path = "/tmp/msf_test_profiler_trace.json";
+    msf::Profiler& profiler = msf::Profiler::instance();
+    profiler.reset();
+    profiler.set_enabled(true);
+    profiler.enable_trace(path, 2);
+
+    EntityRegistry registry;
+    registry.register_entity(std::make_shared<ProbeEntity>("probe"));
+    TickEngine engine;
+    engine.configure(1, 0);
+    for (int tick = 0; tick < 5; ++tick) {
+        MSF_PROFILE_TICK();
+        MSF_PROFILE_SCOPE("tick");
+        engine.tick(registry, tick * 0.01, 0.01);
+    }
+    profiler.set_enabled(false);
+    assert(profiler.get_tick_count() == 5);
+    assert(find_stat(profiler.get_stats(), msf::ProfileCategory::Phase, "tick")->count == 5);
+
+    const bool written = profiler.write_trace();
+    assert(written);
+    std::ifstream file(path);
+    std::stringstream contents;
+    contents << file.rdbuf();
+    const std::string json = contents.str();
+    assert(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+    assert(count_occurrences(json, "\"name\":\"tick\"") == 2);
+    assert(count_occurrences(json, "\"cat\":\"entity\"") == 0);
+    assert(json.find("\"ph\":\"M\"") != std::string::npos);
+    std::remove(path.c_str());
+    profiler.reset();
+}
+
+#endif // MSF_PROFILING
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Warning);
+
+    test_disabled_records_nothing();
+#if MSF_PROFILING
+    test_nested_scopes();
+    test_entity_classes_and_events();
+    test_trace_window();
+#endif
+    return 0;
+}
@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "PhysicsEntity.hpp"
+#include "RandomStream.hpp"
+#include "TestSupport.hpp"
+#include "TickEngine.hpp"
+
+namespace {
+
+// Random walk: each update draws a 3-axis normal gust and a uniform drag factor from its own streams
+class GustEntity : public PhysicsEntity {
+public:
+    static constexpr uint32_t kGustStream = 0;
+    static constexpr uint32_t kDragStream = 1;
+
+    explicit GustEntity(const std::string& name) : PhysicsEntity(name) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<GustEntity>("gust");
+    }
+
+    void update(const double t, const double dt) override {
+        const uint64_t tick = msf::RandomStream::tick_of(t, dt);
+        double gust[3];
+        random_stream(kGustStream).fill_normal(tick, gust, 3);
+        const double drag = random_stream(kDragStream).uniform(tick);
+        set_acceleration(Vec3(gust[0], gust[1], gust[2]) - get_velocity() * drag);
+        PhysicsEntity::update(t, dt);
+    }
+};
+
+void test_philox_known_answers() {
+    // Known-answer vectors of the Random123 reference implementation
+    using msf::Philox4x32;
+    assert((Philox4x32::generate({0, 0, 0, 0}, {0, 0}) ==
+            Philox4x32::Counter{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}));
+    assert((Philox4x32::generate({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}, {0xffffffffu, 0xffffffffu}) ==
+            Philox4x32::Counter{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}));
+    assert((Philox4x32::generate({0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}, {0xa4093822u, 0x299f31d0u}) ==
+            Philox4x32::Counter{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}));
+}
+
+void test_uniform_and_normal_moments() {
+    const msf::RandomStream stream(7, 3, 0);
+    const std::size_t n = 200000;
+    std::vector<double> values(n);
+
+    stream.fill_uniform(11, values.data(), n);
+    double sum = 0.0;
+    double squares = 0.0;
+    for (const double value : values) {
+        assert(value >= 0.0 && value < 1.0);
+        sum += value;
+        squares += value * value;
+    }
+    double mean = sum / n;
+    assert(std::fabs(mean - 0.5) < 0.005);
+    assert(std::fabs(squares / n - mean * mean - 1.0 / 12.0) < 0.002);
+
+    stream.fill_normal(11, values.data(), n);
+    sum = 0.0;
+    squares = 0.0;
+    std::size_t beyond_two_sigma = 0;
+    for (const double value : values) {
+        assert(std::isfinite(value));
+        sum += value;
+        squares += value * value;
+        beyond_two_sigma += std::fabs(value) > 2.0 ? 1 : 0;
+    }
+    mean = sum / n;
+    assert(std::fabs(mean) < 0.01);
+    assert(std::fabs(squares / n - mean * mean - 1.0) < 0.02);
+    assert(std::fabs(static_cast<double>(beyond_two_sigma) / n - 0.0455) < 0.003);
+}
+
+// A variate depends only on its (tick, index), not on how the request was batched
+void test_batching_does_not_change_draws() {
+    const msf::RandomStream stream(42, 9, 2);
+    std::vector<double> all(37);
+    std::vector<double> part(13);
+    for (const bool normal : {false, true}) {
+        const auto fill = [&](double* out, std::size_t n, uint64_t first) {
+            normal ? stream.fill_normal(5, out, n, first) : stream.fill_uniform(5, out, n, first);
+        };
+        fill(all.data(), all.size(), 0);
+        for (const uint64_t first : {0u, 1u, 6u, 17u, 24u}) {
+            fill(part.data(), part.size(), first);
+            assert(std::equal(part.begin(), part.end(), all.begin() + first));
+        }
+        for (uint64_t index = 0; index < all.size(); ++index) {
+            assert((normal ? stream.normal(5, index) : stream.uniform(5, index)) == all[index]);
+        }
+    }
+}
+
+void test_keys_select_independent_streams() {
+    const double reference = msf::RandomStream(1, 0, 0).uniform(0);
+    assert(msf::RandomStream(1, 0, 0).uniform(0) == reference); // Stateless: same key and counter, same value
+    assert(msf::RandomStream(2, 0, 0).uniform(0) != reference);
+    assert(msf::RandomStream(1, 1, 0).uniform(0) != reference);
+    assert(msf::RandomStream(1, 0, 1).uniform(0) != reference);
+    assert(msf::RandomStream(1, 0, 0).uniform(1) != reference);
+    assert(msf::RandomStream(1, 0, 0).uniform(0, 1) != reference);
+    assert(msf::RandomStream(uint64_t{1} << 32, 0, 0).uniform(0) != msf::RandomStream(0, 1, 0).uniform(0));
+
+    assert(msf::RandomStream::tick_of(0.0, 0.001) == 0);
+    assert(msf::RandomStream::tick_of(1.0000000002, 0.001) == 1000);
+    assert(msf::RandomStream::tick_of(0.9999999998, 0.001) == 1000);
+}
+
+struct GustWorld {
+    EntityRegistry registry;
+    TickEngine engine;
+    std::vector<std::shared_ptr<Entity>> entities;
+
+    // Entities are always created in the same order (so get the same IDs) but registered in either order
+    GustWorld(uint64_t seed, std::size_t threads, bool reverse) {
+        registry.set_run_seed(seed);
+        Entity::set_next_id(0);
+        for (int i = 0; i < 64; ++i) {
+            entities.push_back(std::make_shared<GustEntity>("gust_" + std::to_string(i)));
+        }
+        if (reverse) {
+            std::reverse(entities.begin(), entities.end());
+        }
+        for (const auto& entity : entities) {
+            registry.register_entity(entity);
+        }
+        engine.configure(threads, 4);
+    }
+
+    void run(int ticks, double dt) {
+        for (int i = 0; i < ticks; ++i) {
+            engine.tick(registry, i * dt, dt);
+        }
+    }
+
+    Vec3 position_of(const std::string& name) const {
+        return registry.get_entity_by_name(name)->get_position();
+    }
+};
+
+void test_entity_draws_independent_of_threads_and_order() {
+    const double dt = 0.01;
+    GustWorld serial(17, 1, false);
+    GustWorld parallel(17, 4, true);
+    GustWorld reseeded(18, 1, false);
+    serial.run(300, dt);
+    parallel.run(300, dt);
+    reseeded.run(300, dt);
+
+    bool any_moved = false;
+    bool seed_matters = false;
+    for (int i = 0; i < 64; ++i) {
+        const std::string name = "gust_" + std::to_string(i);
+        assert(serial.registry.get_entity_by_name(name)->get_id() == parallel.registry.get_entity_by_name(name)->get_id());
+        assert(same_bits(serial.position_of(name), parallel.position_of(name)));
+        any_moved = any_moved || serial.position_of(name).magnitude() > 0.0;
+        seed_matters = seed_matters || !same_bits(serial.position_of(name), reseeded.position_of(name));
+    }
+    assert(any_moved && seed_matters);
+
+    // Entities that don't share an ID don't share draws
+    assert(!same_bits(serial.position_of("gust_0"), serial.position_of("gust_1")));
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    test_philox_known_answers();
+    test_uniform_and_normal_moments();
+    test_batching_does_not_change_draws();
+    test_keys_select_independent_streams();
+    test_entity_draws_independent_of_threads_and_order();
+    return 0;
+}
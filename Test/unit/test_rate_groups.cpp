@@ -0,0 +1,181 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "PhysicsEntity.hpp"
+#include "SCF.hpp"
+#include "TickEngine.hpp"
+
+namespace {
+
+// Coasts at constant velocity and records the dt of every update.
+class Probe : public PhysicsEntity {
+public:
+    explicit Probe(const std::string& name) : PhysicsEntity(name) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<Probe>("probe");
+    }
+
+    void update(const double t, const double dt) override {
+        dts.push_back(dt);
+        PhysicsEntity::update(t, dt);
+    }
+
+    std::vector<double> dts;
+};
+
+class CountingObserver : public TickObserver {
+public:
+    void on_entity_updated(std::size_t, const Entity&) override {
+        ++calls;
+    }
+    int calls = 0;
+};
+
+void test_rate_divisor() {
+    const double dt = 0.001;
+    assert(TickEngine::rate_divisor(0.0, dt) == 1);
+    assert(TickEngine::rate_divisor(1000.0, dt) == 1);
+    assert(TickEngine::rate_divisor(2000.0, dt) == 1);
+    assert(TickEngine::rate_divisor(500.0, dt) == 2);
+    assert(TickEngine::rate_divisor(300.0, dt) == 2); // Never slower than requested
+    assert(TickEngine::rate_divisor(250.0, dt) == 4);
+    assert(TickEngine::rate_divisor(100.0, dt) == 8);
+    assert(TickEngine::rate_divisor(0.001, dt) == TickEngine::kMaxRateDivisor);
+}
+
+struct World {
+    EntityRegistry registry;
+    std::vector<std::shared_ptr<Probe>> fast;
+    std::vector<std::shared_ptr<Probe>> slow;
+
+    World() {
+        for (int i = 0; i < 16; ++i) {
+            auto probe = std::make_shared<Probe>("probe_" + std::to_string(i));
+            probe->set_velocity(Vec3(1.0, 2.0, 0.5 * (i % 8)));
+            if (i >= 8) { // Contiguous slots, so the group spreads over every phase
+                probe->set_update_rate(250.0);
+                slow.push_back(probe);
+            } else {
+                fast.push_back(probe);
+            }
+            registry.register_entity(probe);
+        }
+    }
+};
+
+// Slow entities run every 4th tick with 4 * dt, spread evenly over the 4 phases, and end up where
+// full-rate entities with the same motion do.
+void test_groups_and_phases(std::size_t threads) {
+    constexpr double kDt = 0.001;
+    World world;
+    TickEngine engine;
+    engine.configure(threads, 1);
+
+    std::size_t previous = 0;
+    for (int tick = 0; tick < 40; ++tick) {
+        engine.tick(world.registry, tick * kDt, kDt);
+        std::size_t slow_updates = 0;
+        for (const auto& probe : world.slow) {
+            slow_updates += probe->dts.size();
+        }
+        assert(slow_updates - previous == 2); // 8 slow entities over 4 phases
+        previous = slow_updates;
+    }
+
+    for (const auto& probe : world.fast) {
+        assert(probe->dts.size() == 40);
+    }
+    for (std::size_t i = 0; i < world.slow.size(); ++i) {
+        const auto& probe = world.slow[i];
+        assert(probe->dts.size() == 10);
+        for (double dt : probe->dts) {
+            assert(dt == 4 * kDt);
+        }
+        // Constant velocity: 10 steps of 4 dt cover the same distance as 40 steps of dt
+        const Vec3 expected = world.fast[i]->get_position();
+        assert(std::abs(probe->get_position().get_x() - expected.get_x()) < 1e-12);
+        assert(std::abs(probe->get_position().get_z() - expected.get_z()) < 1e-12);
+    }
+
+    // Observers still see every entity on every tick
+    CountingObserver observer;
+    engine.tick(world.registry, 40 * kDt, kDt, &observer);
+    assert(observer.calls == 16);
+
+    // Changing a rate regroups on the next tick
+    world.slow[0]->set_update_rate(0.0);
+    const std::size_t before = world.slow[0]->dts.size();
+    engine.tick(world.registry, 41 * kDt, kDt);
+    assert(world.slow[0]->dts.size() == before + 1 && world.slow[0]->dts.back() == kDt);
+}
+
+const char* kScenario = R"(<?xml version="1.0" encoding="UTF-8"?>
+<MSFScenario>
+    <SimulationSetup>
+        <TimeStepInterval>0.001</TimeStepInterval>
+    </SimulationSetup>
+    <SimulationEntities>
+        <SimulationEntity name="every_tick">
+            <ModelClass>missile</ModelClass>
+        </SimulationEntity>
+        <SimulationEntity name="hundred_hz">
+            <ModelClass>missile</ModelClass>
+            <EntityParameters>
+                <parameter name="speed" value="1500.0" unit="m/s"/>
+                <parameter name="update_rate" value="100.0" unit="Hz"/>
+            </EntityParameters>
+        </SimulationEntity>
+        <SimulationEntity name="wrong_unit">
+            <ModelClass>missile</ModelClass>
+            <EntityParameters>
+                <parameter name="update_rate" value="0.1" unit="kHz"/>
+            </EntityParameters>
+        </SimulationEntity>
+        <SimulationEntity name="negative">
+            <ModelClass>missile</ModelClass>
+            <EntityParameters>
+                <parameter name="update_rate" value="-5.0" unit="Hz"/>
+            </EntityParameters>
+        </SimulationEntity>
+    </SimulationEntities>
+</MSFScenario>
+)";
+
+// <parameter name="update_rate"> sets the entity's rate; a wrong unit or a non-positive rate is ignored
+void test_scf_update_rate() {
+    const std::string path = "test_rate_groups.xml";
+    std::ofstream(path) << kScenario;
+
+    EntityRegistry registry;
+    registry.register_classes();
+    SCF scf;
+    scf.set_scf_filepath(path);
+    msf::SimDt dt = 0.0;
+    assert(scf.parse_scf(registry, dt));
+    assert(registry.get_entity_count() == 4);
+    assert(registry.get_entity_by_name("every_tick")->get_update_rate() == 0.0);
+    assert(registry.get_entity_by_name("hundred_hz")->get_update_rate() == 100.0);
+    assert(registry.get_entity_by_name("wrong_unit")->get_update_rate() == 0.0);
+    assert(registry.get_entity_by_name("negative")->get_update_rate() == 0.0);
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    test_rate_divisor();
+    test_groups_and_phases(1);
+    test_groups_and_phases(3);
+    test_scf_update_rate();
+    return 0;
+}
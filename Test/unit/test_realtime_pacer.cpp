@@ -0,0 +1,92 @@
+#include <cassert>
+#include <chrono>
+#include <thread>
+
+#include "Clock.hpp"
+#include "Logger.hpp"
+#include "RealTimePacer.hpp"
+
+namespace {
+
+using Millis = std::chrono::duration<double, std::milli>;
+
+void test_configure_range() {
+    RealTimePacer pacer;
+    assert(!pacer.is_enabled());
+    assert(pacer.configure(1.0) && pacer.is_enabled());
+    assert(!pacer.configure(0.05) && pacer.get_time_scale() == 1.0);
+    assert(!pacer.configure(250.0) && pacer.get_time_scale() == 1.0);
+    assert(pacer.configure(RealTimePacer::kMaxTimeScale));
+    assert(pacer.configure(0.0) && !pacer.is_enabled());
+
+    // Disabled pacing never blocks
+    SimulationClock clock;
+    pacer.start(clock);
+    clock.advance(10.0);
+    const auto start = SimulationClock::WallClock::now();
+    pacer.wait(clock);
+    assert(Millis(SimulationClock::WallClock::now() - start).count() < 50.0);
+    assert(pacer.get_stats().waits == 0);
+}
+
+// 300 ticks of 1 ms at 10x take 30 ms of wall time.
+void test_scaled_pacing() {
+    RealTimePacer pacer;
+    pacer.configure(10.0);
+    SimulationClock clock;
+    pacer.start(clock);
+    const auto start = SimulationClock::WallClock::now();
+    for (int tick = 0; tick < 300; ++tick) {
+        clock.advance(0.001);
+        pacer.wait(clock);
+    }
+    const double elapsed_ms = Millis(SimulationClock::WallClock::now() - start).count();
+    assert(elapsed_ms >= 29.9);
+    assert(elapsed_ms < 200.0); // Loose: shared CI machines get descheduled
+    assert(pacer.get_stats().waits == 300);
+    assert(pacer.get_stats().slept > 0);
+}
+
+// A slow tick is reported as an overrun; the next ticks catch up without waiting. A tick that falls
+// more than kMaxLagSeconds behind drops the backlog instead.
+void test_overruns_and_resync() {
+    RealTimePacer pacer;
+    pacer.configure(1.0);
+    SimulationClock clock;
+    pacer.start(clock);
+
+    clock.advance(0.001);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pacer.wait(clock);
+    assert(pacer.get_stats().overruns == 1);
+    assert(pacer.get_stats().max_lateness_ms >= 18.0);
+    assert(pacer.get_stats().resyncs == 0);
+
+    clock.advance(0.001);
+    pacer.wait(clock); // Still behind: returns at once
+    assert(pacer.get_stats().overruns == 2);
+
+    clock.advance(0.001);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    pacer.wait(clock);
+    assert(pacer.get_stats().resyncs == 1);
+
+    // Anchored to the present again: the next tick waits its full 1 ms
+    const uint64_t overruns = pacer.get_stats().overruns;
+    const auto start = SimulationClock::WallClock::now();
+    clock.advance(0.001);
+    pacer.wait(clock);
+    assert(Millis(SimulationClock::WallClock::now() - start).count() >= 0.8);
+    assert(pacer.get_stats().overruns == overruns);
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    test_configure_range();
+    test_scaled_pacing();
+    test_overruns_and_resync();
+    return 0;
+}
@@ -31,6 +31,8 @@ int main() {
 
     assert(std::fabs(timestep - 0.001) < 1e-12);
     assert(registry.get_entity_count() == 3);
+    assert(registry.get_entity_by_name("missile_0")->get_activity() == ActivityState::Active);
+    assert(registry.get_entity_by_name("end_waypoint")->get_activity() == ActivityState::Static);
 
     SimulationClock clock;
     clock.reset(0.0);
@@ -0,0 +1,241 @@
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Clock.hpp"
+#include "EntityRegistry.hpp"
+#include "Scheduler.hpp"
+
+namespace {
+
+// Small deterministic LCG so both backends see the same schedule.
+struct Lcg {
+    uint64_t state;
+    double next_unit() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(state >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+// Schedule a mix of coincident, near and far events (far enough to cascade through wheel
+// levels 1 and 2), a few of which schedule follow-ups, then step the clock and record firing order.
+std::vector<std::pair<int, double>> run_schedule(SimEventScheduler::Backend backend) {
+    constexpr double kDt = 0.001;
+    SimulationClock clock;
+    clock.reset(0.0);
+
+    SimEventScheduler scheduler;
+    scheduler.configure(backend, kDt);
+
+    std::vector<std::pair<int, double>> fired;
+    Lcg rng{42};
+    int next_id = 0;
+
+    for (int i = 0; i < 500; ++i) {
+        const int id = next_id++;
+        double delay = 0.0;
+        switch (i % 5) {
+            case 0: delay = 1.0; break;                          // many events at exactly the same time
+            case 1: delay = rng.next_unit() * 0.5; break;        // level 0
+            case 2: delay = 0.3 + rng.next_unit() * 30.0; break; // level 1
+            case 3: delay = 66.0 + rng.next_unit() * 4.0; break; // level 2
+            default: delay = std::floor(rng.next_unit() * 100.0) * kDt; break; // tick-aligned
+        }
+        const bool chains = (i % 7) == 0;
+        scheduler.schedule_event(clock, [&, id, chains]() {
+            fired.emplace_back(id, clock.now());
+            if (chains) {
+                const int follow_id = 100000 + id;
+                scheduler.schedule_event(clock, [&, follow_id]() {
+                    fired.emplace_back(follow_id, clock.now());
+                }, 0.25);
+            }
+        }, delay);
+    }
+
+    while (clock.now() < 71.0) {
+        scheduler.process_events(clock);
+        clock.advance(kDt);
+    }
+    scheduler.process_events(clock);
+    assert(scheduler.empty());
+    return fired;
+}
+
+void test_backends_fire_in_identical_order() {
+    const auto heap_order = run_schedule(SimEventScheduler::Backend::BinaryHeap);
+    const auto wheel_order = run_schedule(SimEventScheduler::Backend::TimingWheel);
+
+    assert(heap_order.size() == 500 + 72);
+    assert(heap_order == wheel_order);
+}
+
+void test_same_time_events_are_fifo() {
+    for (auto backend : {SimEventScheduler::Backend::BinaryHeap, SimEventScheduler::Backend::TimingWheel}) {
+        SimulationClock clock;
+        SimEventScheduler scheduler;
+        scheduler.configure(backend, 0.001);
+
+        std::vector<int> order;
+        for (int i = 0; i < 64; ++i) {
+            scheduler.schedule_event(clock, [&order, i]() { order.push_back(i); }, 0.5);
+        }
+        clock.advance(0.5);
+        scheduler.process_events(clock);
+
+        assert(order.size() == 64);
+        for (int i = 0; i < 64; ++i) {
+            assert(order[i] == i);
+        }
+    }
+}
+
+void test_next_event_time_and_migration() {
+    SimulationClock clock;
+    SimEventScheduler scheduler;
+    scheduler.configure(SimEventScheduler::Backend::BinaryHeap, 0.001);
+    assert(scheduler.next_event_time() == std::numeric_limits<double>::infinity());
+
+    int fired = 0;
+    scheduler.schedule_event(clock, [&fired]() { ++fired; }, 5000000.0); // Beyond the wheel horizon
+    scheduler.schedule_event(clock, [&fired]() { ++fired; }, 2.0);
+    scheduler.schedule_event(clock, [&fired]() { ++fired; }, 120.0);
+    assert(scheduler.next_event_time() == 2.0);
+
+    // Switching backends keeps every pending event
+    scheduler.configure(SimEventScheduler::Backend::TimingWheel, 0.001);
+    assert(scheduler.size() == 3);
+    assert(scheduler.next_event_time() == 2.0);
+
+    clock.advance(2.0);
+    scheduler.process_events(clock);
+    assert(fired == 1);
+    assert(scheduler.next_event_time() == 120.0);
+
+    clock.advance(118.0);
+    scheduler.process_events(clock);
+    assert(fired == 2);
+    assert(scheduler.next_event_time() == 5000000.0);
+}
+
+void test_cancel_and_reschedule() {
+    for (auto backend : {SimEventScheduler::Backend::BinaryHeap, SimEventScheduler::Backend::TimingWheel}) {
+        SimulationClock clock;
+        SimEventScheduler scheduler;
+        scheduler.configure(backend, 0.001);
+
+        std::vector<int> order;
+        const EventHandle first = scheduler.schedule_event(clock, [&order]() { order.push_back(1); }, 1.0);
+        const EventHandle second = scheduler.schedule_event(clock, [&order]() { order.push_back(2); }, 2.0);
+        const EventHandle third = scheduler.schedule_event(clock, [&order]() { order.push_back(3); }, 3.0);
+        assert(scheduler.is_pending(first) && scheduler.is_pending(second) && scheduler.is_pending(third));
+
+        assert(scheduler.cancel(second));
+        assert(!scheduler.cancel(second)); // Second cancel is a no-op
+        assert(!scheduler.is_pending(second));
+        assert(scheduler.size() == 2);
+
+        // Move the first event behind the third; the handle stays valid
+        assert(scheduler.reschedule(clock, first, 4.0));
+        assert(scheduler.is_pending(first));
+        assert(scheduler.next_event_time() == 3.0);
+
+        clock.advance(5.0);
+        scheduler.process_events(clock);
+        assert((order == std::vector<int>{3, 1}));
+        assert(scheduler.empty());
+
+        // Handles of fired events are stale, even once their slot has been reused
+        const EventHandle reused = scheduler.schedule_event(clock, [&order]() { order.push_back(4); }, 1.0);
+        assert(reused.index == first.index || reused.index == third.index);
+        assert(!scheduler.cancel(first));
+        assert(!scheduler.cancel(third));
+        assert(!scheduler.reschedule(clock, first, 1.0));
+        assert(!scheduler.cancel(EventHandle{}));
+        assert(scheduler.is_pending(reused));
+    }
+}
+
+void test_mass_cancellation_is_compacted() {
+    for (auto backend : {SimEventScheduler::Backend::BinaryHeap, SimEventScheduler::Backend::TimingWheel}) {
+        SimulationClock clock;
+        SimEventScheduler scheduler;
+        scheduler.configure(backend, 0.001);
+
+        int fired = 0;
+        std::vector<EventHandle> handles;
+        for (int i = 0; i < 20000; ++i) {
+            handles.push_back(scheduler.schedule_event(clock, [&fired]() { ++fired; }, 1.0 + i * 0.01));
+        }
+        // Cancel all but every 100th event, then keep rescheduling one survivor
+        for (int i = 0; i < 20000; ++i) {
+            if (i % 100 != 0) {
+                assert(scheduler.cancel(handles[i]));
+            }
+        }
+        for (int i = 0; i < 5000; ++i) {
+            assert(scheduler.reschedule(clock, handles[0], 0.5));
+        }
+        assert(scheduler.size() == 200);
+        assert(scheduler.next_event_time() == 0.5);
+
+        clock.advance(250.0);
+        for (int i = 0; i < 10; ++i) {
+            scheduler.process_events(clock);
+        }
+        assert(fired == 200);
+        assert(scheduler.empty());
+    }
+}
+
+void test_removed_entity_events_are_cancelled() {
+    SimulationClock clock;
+    SimEventScheduler scheduler;
+    EntityRegistry registry;
+    registry.register_classes();
+    registry.attach_scheduler(scheduler);
+
+    std::shared_ptr<Entity> keep = registry.create_entity_from_string("waypoint");
+    std::shared_ptr<Entity> doomed = registry.create_entity_from_string("waypoint");
+    registry.register_entity(keep);
+    registry.register_entity(doomed);
+
+    std::vector<int> fired;
+    const EventDescriptionId description = intern_event_description("CANCEL_PROBE");
+    for (const auto& entity : {keep, doomed}) {
+        const int id = entity->get_id();
+        for (int i = 1; i <= 3; ++i) {
+            entity->request_event(EventRequest{id, i * 1.0, description, [&fired, id]() { fired.push_back(id); }});
+        }
+    }
+    registry.schedule_entitiy_events(scheduler, clock);
+    assert(scheduler.size() == 6);
+
+    registry.remove_entity(doomed->get_id());
+    assert(scheduler.size() == 6); // Deferred until the safe point
+    registry.apply_pending_removals();
+    assert(scheduler.size() == 3);
+    assert(doomed->scheduled_events.empty());
+
+    clock.advance(10.0);
+    scheduler.process_events(clock);
+    assert((fired == std::vector<int>(3, keep->get_id())));
+
+    registry.shutdown();
+    assert(scheduler.empty());
+}
+
+} // namespace
+
+int main() {
+    test_backends_fire_in_identical_order();
+    test_same_time_events_are_fifo();
+    test_next_event_time_and_migration();
+    test_cancel_and_reschedule();
+    test_mass_cancellation_is_compacted();
+    test_removed_entity_events_are_cancelled();
+    return 0;
+}
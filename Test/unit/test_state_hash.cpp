@@ -0,0 +1,171 @@
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "ArgParse.hpp"
+#include "Controller.hpp"
+#include "Entity.hpp"
+#include "Logger.hpp"
+#include "StateHashFile.hpp"
+
+namespace {
+
+// The chaser wakes at wake_time; the interceptor runs from the start unless given another model type
+std::string scenario(const std::string& wake_time, const std::string& interceptor_type = "dynamic") {
+    return R"(<?xml version="1.0" encoding="UTF-8"?>
+<MSFScenario>
+    <SimulationSetup>
+        <TimeStepInterval>0.01</TimeStepInterval>
+        <ParallelTick threads="1" grain="0"/>
+    </SimulationSetup>
+    <SimulationEntities>
+        <SimulationEntity name="interceptor">
+            <ModelClass>missile</ModelClass>
+            <ModelType>)" + interceptor_type + R"(</ModelType>
+            <EmplacementData>
+                <position x="0.0" y="0.0" z="0.0"/>
+            </EmplacementData>
+        </SimulationEntity>
+        <SimulationEntity name="chaser">
+            <ModelClass>missile</ModelClass>
+            <ModelType>sleeping</ModelType>
+            <EmplacementData>
+                <position x="30.0" y="40.0" z="-12.0"/>
+            </EmplacementData>
+            <EventTriggers>
+                <trigger time=")" + wake_time + R"(" type="WAKE" delay="0.0"/>
+            </EventTriggers>
+        </SimulationEntity>
+        <SimulationEntity name="target">
+            <ModelClass>waypoint</ModelClass>
+            <ModelType>static</ModelType>
+            <EmplacementData>
+                <position x="30.0" y="40.0" z="0.0"/>
+            </EmplacementData>
+        </SimulationEntity>
+    </SimulationEntities>
+</MSFScenario>
+)";
+}
+
+std::string write_file(const std::string& path, const std::string& contents) {
+    std::ofstream(path) << contents;
+    return path;
+}
+
+// Run the scenario with state hashing every 10 ticks and return the hash file
+std::string run(const std::string& scenario_path, const std::string& hash_path, std::size_t threads,
+                const std::string& backend, bool fast_forward) {
+    Entity::set_next_id(0);
+    ArgParse::Options options;
+    options.scenario_path = scenario_path;
+    options.tick_threads = threads;
+    options.scheduler_backend = backend;
+    options.fast_forward = fast_forward;
+    options.state_hash_path = hash_path;
+    options.state_hash_interval = 10;
+    Controller controller;
+    assert(controller.initialize(options));
+    controller.run();
+    return hash_path;
+}
+
+void test_hash_file_layout(const std::string& reference) {
+    StateHashReader reader;
+    assert(reader.open(reference));
+    assert(reader.get_interval_ticks() == 10);
+    assert(reader.get_dt() == 0.01);
+
+    StateHashReader::Sample sample;
+    uint64_t expected_tick = 0;
+    uint64_t samples = 0;
+    while (reader.next_sample(sample)) {
+        assert(sample.tick == expected_tick);
+        assert(sample.entities.size() == 3);
+        assert(sample.entities[0].first == 0 && sample.entities[1].first == 1 && sample.entities[2].first == 2);
+        expected_tick += 10;
+        ++samples;
+    }
+    assert(reader.get_error().empty());
+    assert(samples == 1201); // t = 0 to the shutdown at 120 s
+}
+
+// Parallel ticks, the timing wheel and stepping through idle ticks all leave the state bit-identical
+void test_backends_identical(const std::string& scenario_path, const std::string& reference) {
+    const std::string parallel = run(scenario_path, "test_state_hash_parallel.msfh", 4, "wheel", true);
+    const std::string stepped = run(scenario_path, "test_state_hash_stepped.msfh", 1, "heap", false);
+
+    for (const std::string& other : {parallel, stepped}) {
+        StateHashDivergence divergence;
+        std::string error;
+        assert(compare_state_hashes(reference, other, divergence, error));
+        assert(!divergence.diverged);
+        assert(divergence.reason.empty());
+    }
+    std::remove(parallel.c_str());
+    std::remove(stepped.c_str());
+}
+
+// With every entity asleep until the wake at t=1.0, fast-forward jumps over the idle ticks; it must still
+// land on each sample tick inside the idle stretch
+void test_fast_forward_matches_stepping() {
+    const std::string idle_scenario = write_file("test_state_hash_idle.xml", scenario("1.0", "sleeping"));
+    const std::string jumped = run(idle_scenario, "test_state_hash_idle_ff.msfh", 1, "heap", true);
+    const std::string stepped = run(idle_scenario, "test_state_hash_idle_stepped.msfh", 1, "heap", false);
+
+    StateHashDivergence divergence;
+    std::string error;
+    assert(compare_state_hashes(jumped, stepped, divergence, error));
+    assert(!divergence.diverged);
+    assert(divergence.reason.empty());
+
+    std::remove(jumped.c_str());
+    std::remove(stepped.c_str());
+    std::remove(idle_scenario.c_str());
+}
+
+// A chaser woken half a second late: the first sample after the reference wake names the tick and the chaser
+void test_reports_first_divergence(const std::string& reference) {
+    const std::string late_scenario = write_file("test_state_hash_late.xml", scenario("1.5"));
+    const std::string late = run(late_scenario, "test_state_hash_late.msfh", 1, "heap", true);
+
+    StateHashDivergence divergence;
+    std::string error;
+    assert(compare_state_hashes(reference, late, divergence, error));
+    assert(divergence.diverged);
+    assert(divergence.tick == 110); // The wake at t=1.0 fires after the sample at tick 100
+    assert(divergence.time > 1.09 && divergence.time < 1.11);
+    assert(divergence.entity_id == 1);
+    assert(divergence.reason.find("entity 1") != std::string::npos);
+
+    std::remove(late.c_str());
+    std::remove(late_scenario.c_str());
+}
+
+void test_unreadable_files(const std::string& reference) {
+    const std::string bogus = write_file("test_state_hash_bogus.msfh", "not a state hash file");
+    StateHashDivergence divergence;
+    std::string error;
+    assert(!compare_state_hashes(reference, bogus, divergence, error));
+    assert(!error.empty());
+    assert(!compare_state_hashes("does_not_exist.msfh", reference, divergence, error));
+    std::remove(bogus.c_str());
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    const std::string scenario_path = write_file("test_state_hash.xml", scenario("1.0"));
+    const std::string reference = run(scenario_path, "test_state_hash.msfh", 1, "heap", true);
+    test_hash_file_layout(reference);
+    test_backends_identical(scenario_path, reference);
+    test_fast_forward_matches_stepping();
+    test_reports_first_divergence(reference);
+    test_unreadable_files(reference);
+    std::remove(reference.c_str());
+    std::remove(scenario_path.c_str());
+    return 0;
+}
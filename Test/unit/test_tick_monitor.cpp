@@ -0,0 +1,184 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "EntityRegistry.hpp"
+#include "LatencyHistogram.hpp"
+#include "Logger.hpp"
+#include "PhysicsEntity.hpp"
+#include "TickEngine.hpp"
+#include "TickMonitor.hpp"
+
+namespace {
+
+// Busy-waits for a fixed time in every update.
+class Laggard : public PhysicsEntity {
+public:
+    Laggard(const std::string& name, std::chrono::microseconds delay) : PhysicsEntity(name), delay_(delay) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<Laggard>("laggard", delay_);
+    }
+
+    void update(const double t, const double dt) override {
+        const auto until = std::chrono::steady_clock::now() + delay_;
+        while (std::chrono::steady_clock::now() < until) {
+        }
+        PhysicsEntity::update(t, dt);
+    }
+
+private:
+    std::chrono::microseconds delay_;
+};
+
+bool within(uint64_t value, uint64_t expected, double relative) {
+    const double difference = static_cast<double>(value) - static_cast<double>(expected);
+    return difference >= -relative * expected && difference <= relative * expected;
+}
+
+void test_histogram_buckets() {
+    using msf::LatencyHistogram;
+    // Exact below one sub-bucket range, then within 1/128 of the value
+    for (uint64_t value : {0ull, 1ull, 127ull, 128ull, 129ull, 1000ull, 123456789ull, (1ull << 40) + 12345}) {
+        const std::size_t index = LatencyHistogram::bucket_index(value);
+        assert(index < LatencyHistogram::kBucketCount);
+        const uint64_t upper = LatencyHistogram::bucket_upper_edge(index);
+        assert(upper >= value);
+        assert(upper - value <= value / LatencyHistogram::kSubBucketCount);
+        if (value > 0) {
+            assert(LatencyHistogram::bucket_index(value - 1) <= index);
+        }
+    }
+    assert(LatencyHistogram::bucket_index(LatencyHistogram::kMaxTrackableNs) == LatencyHistogram::kBucketCount - 1);
+}
+
+void test_histogram_percentiles() {
+    msf::LatencyHistogram histogram;
+    assert(histogram.count() == 0 && histogram.percentile(99.0) == 0);
+    for (uint64_t ns = 1; ns <= 100000; ++ns) {
+        histogram.record(ns * 10);
+    }
+    assert(histogram.count() == 100000);
+    assert(histogram.min() == 10 && histogram.max() == 1000000);
+    assert(within(static_cast<uint64_t>(histogram.mean()), 500005, 1e-6));
+    assert(within(histogram.percentile(50.0), 500000, 0.01));
+    assert(within(histogram.percentile(99.0), 990000, 0.01));
+    assert(within(histogram.percentile(99.9), 999000, 0.01));
+    assert(histogram.percentile(100.0) == 1000000);
+
+    // One huge outlier shows up in max but not in p99
+    histogram.record(uint64_t{1} << 50);
+    assert(histogram.max() == uint64_t{1} << 50);
+    assert(within(histogram.percentile(99.0), 990000, 0.01));
+
+    histogram.reset();
+    assert(histogram.count() == 0 && histogram.max() == 0);
+}
+
+// Percentiles can be read while the loop thread records.
+void test_histogram_concurrent_reads() {
+    msf::LatencyHistogram histogram;
+    std::atomic<bool> done{false};
+    std::thread reader([&]() {
+        uint64_t last = 0;
+        while (!done.load()) {
+            const uint64_t count = histogram.count();
+            assert(count >= last);
+            last = count;
+            const uint64_t p99 = histogram.percentile(99.0);
+            assert(p99 <= 2000);
+        }
+    });
+    for (int i = 0; i < 2000000; ++i) {
+        histogram.record(1000 + i % 1000);
+    }
+    done.store(true);
+    reader.join();
+    assert(histogram.count() == 2000000);
+}
+
+// A tick over the deadline is attributed to its slowest phase and entity update.
+void test_deadline_overruns(std::size_t threads) {
+    EntityRegistry registry;
+    for (int i = 0; i < 8; ++i) {
+        registry.register_entity(std::make_shared<Laggard>("quick_" + std::to_string(i), std::chrono::microseconds(0)));
+    }
+    auto slow = std::make_shared<Laggard>("slow", std::chrono::microseconds(3000));
+    registry.register_entity(slow);
+
+    TickEngine engine;
+    engine.configure(threads, 1);
+    engine.set_track_slowest(true);
+    TickMonitor monitor;
+    monitor.set_deadline(2000000); // 2 ms
+
+    for (int tick = 0; tick < 3; ++tick) {
+        monitor.begin_tick(tick * 0.01);
+        monitor.end_phase("process_events");
+        engine.tick(registry, tick * 0.01, 0.01);
+        monitor.end_phase("entity_update");
+        monitor.end_tick(engine.get_slowest_update());
+    }
+    assert(engine.get_slowest_update().entity == slow.get());
+    assert(engine.get_slowest_update().ns >= 3000000);
+
+    // A quick tick is not an overrun
+    slow->set_activity(ActivityState::Sleeping);
+    monitor.begin_tick(0.03);
+    engine.tick(registry, 0.03, 0.01);
+    monitor.end_phase("entity_update");
+    monitor.end_tick(engine.get_slowest_update());
+
+    assert(monitor.get_histogram().count() == 4);
+    assert(monitor.get_histogram().max() >= 3000000);
+    assert(monitor.get_overrun_count() == 3);
+    const auto worst = monitor.get_worst_overruns();
+    assert(worst.size() == 3);
+    assert(worst[0].duration_ns >= worst[1].duration_ns && worst[1].duration_ns >= worst[2].duration_ns);
+    for (const auto& overrun : worst) {
+        assert(overrun.tick < 3);
+        assert(std::string(overrun.phase) == "entity_update");
+        assert(overrun.entity_id == slow->get_id() && overrun.entity_name == "slow");
+        assert(overrun.entity_ns >= 3000000 && overrun.entity_ns <= overrun.phase_ns);
+    }
+
+    // Without a deadline only the histogram is kept
+    TickMonitor unwatched;
+    unwatched.begin_tick(0.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    unwatched.end_phase("entity_update");
+    unwatched.end_tick();
+    assert(unwatched.get_histogram().count() == 1 && unwatched.get_overrun_count() == 0);
+}
+
+// Only the slowest kKeptOverruns are kept.
+void test_worst_overruns_are_bounded() {
+    TickMonitor monitor;
+    monitor.set_deadline(1);
+    for (std::size_t i = 0; i < TickMonitor::kKeptOverruns * 2; ++i) {
+        monitor.begin_tick(0.0);
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+        monitor.end_tick();
+    }
+    assert(monitor.get_overrun_count() == TickMonitor::kKeptOverruns * 2);
+    assert(monitor.get_worst_overruns().size() == TickMonitor::kKeptOverruns);
+    assert(monitor.get_worst_overruns()[0].entity_id == -1);
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    test_histogram_buckets();
+    test_histogram_percentiles();
+    test_histogram_concurrent_reads();
+    test_deadline_overruns(1);
+    test_deadline_overruns(3);
+    test_worst_overruns_are_bounded();
+    return 0;
+}
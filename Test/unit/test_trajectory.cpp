@@ -0,0 +1,304 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "PhysicsEntity.hpp"
+#include "TickEngine.hpp"
+#include "TrajectoryFormat.hpp"
+#include "TrajectoryReader.hpp"
+#include "TrajectoryRecorder.hpp"
+
+namespace {
+
+using namespace trajectory_format;
+
+// Constant velocity body, so every sample has a closed-form expected position.
+class DriftEntity : public PhysicsEntity {
+public:
+    DriftEntity(const std::string& name, const Vec3& start, const Vec3& drift) : PhysicsEntity(name) {
+        set_position(start);
+        set_velocity(drift);
+        set_angular_velocity(Vec3(0.0, 0.0, 0.25));
+    }
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<DriftEntity>("drift", Vec3(), Vec3());
+    }
+
+    void update(const double, const double dt) override {
+        set_position(get_position() + get_velocity() * dt);
+    }
+};
+
+// Entity without physics state; its velocity columns must read back as NaN.
+class MarkerEntity : public Entity {
+public:
+    explicit MarkerEntity(const std::string& name) : Entity(name) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<MarkerEntity>("marker");
+    }
+    void update(const double, const double) override {}
+    void set_position(const Vec3& new_position) override {
+        position_ = new_position;
+    }
+    Vec3 get_position() const override {
+        return position_;
+    }
+    void set_orientation(const Quat& new_orientation) override {
+        orientation_ = new_orientation;
+    }
+    Quat get_orientation() const override {
+        return orientation_;
+    }
+
+private:
+    Vec3 position_;
+    Quat orientation_;
+};
+
+bool near(double a, double b) {
+    return std::fabs(a - b) < 1e-9;
+}
+
+std::string temp_path(const char* name) {
+    return std::string("/tmp/msf_test_") + name + ".msft";
+}
+
+std::vector<TrajectoryReader::Frame> read_all(const std::string& path, TrajectoryReader& reader) {
+    const bool opened = reader.open(path);
+    assert(opened);
+    std::vector<TrajectoryReader::Frame> frames;
+    TrajectoryReader::Frame frame;
+    while (reader.next_frame(frame)) {
+        frames.push_back(frame);
+    }
+    assert(reader.get_error().empty());
+    return frames;
+}
+
+std::size_t index_of(const TrajectoryReader::Frame& frame, int32_t id) {
+    for (std::size_t i = 0; i < frame.size(); ++i) {
+        if (frame.ids[i] == id) {
+            return i;
+        }
+    }
+    assert(false && "entity missing from frame");
+    return 0;
+}
+
+void test_round_trip() {
+    const std::string path = temp_path("round_trip");
+    EntityRegistry registry;
+    auto drift = std::make_shared<DriftEntity>("drift", Vec3(1.0, 2.0, 3.0), Vec3(10.0, 0.0, -2.0));
+    auto marker = std::make_shared<MarkerEntity>("marker");
+    marker->set_position(Vec3(5.0, 6.0, 7.0));
+    marker->set_orientation(Quat(0.0, 1.0, 0.0, 0.0));
+    registry.register_entity(drift);
+    registry.register_entity(marker);
+
+    TrajectoryRecorder recorder;
+    const bool opened = recorder.open(path, 10.0);
+    assert(opened);
+    const double dt = 0.01;
+    double t = 0.0;
+    recorder.record(registry, t);
+    for (int i = 0; i < 100; ++i) {
+        drift->update(t, dt);
+        t += dt;
+        recorder.record(registry, t);
+    }
+    recorder.close();
+    assert(!recorder.is_open());
+    assert(recorder.get_frames_recorded() == 11); // t = 0.0, 0.1, ..., 1.0
+
+    TrajectoryReader reader;
+    const auto frames = read_all(path, reader);
+    assert(near(reader.get_output_interval(), 0.1));
+    assert(reader.get_column_count() == kColumnCount);
+    assert(frames.size() == 11);
+    assert(reader.entity_name(drift->get_id()) == "drift");
+    assert(reader.entity_name(marker->get_id()) == "marker");
+
+    for (std::size_t f = 0; f < frames.size(); ++f) {
+        const auto& frame = frames[f];
+        assert(near(frame.time, 0.1 * static_cast<double>(f)));
+        assert(frame.size() == 2);
+
+        const std::size_t d = index_of(frame, drift->get_id());
+        assert(near(frame.value(kPositionX, d), 1.0 + 10.0 * frame.time));
+        assert(near(frame.value(kPositionY, d), 2.0));
+        assert(near(frame.value(kPositionZ, d), 3.0 - 2.0 * frame.time));
+        assert(near(frame.value(kOrientationW, d), 1.0));
+        assert(near(frame.value(kVelocityX, d), 10.0));
+        assert(near(frame.value(kVelocityZ, d), -2.0));
+        assert(near(frame.value(kAngularVelocityZ, d), 0.25));
+
+        const std::size_t m = index_of(frame, marker->get_id());
+        assert(near(frame.value(kPositionX, m), 5.0));
+        assert(near(frame.value(kOrientationX, m), 1.0));
+        for (uint32_t column = kVelocityX; column < kColumnCount; ++column) {
+            assert(std::isnan(frame.value(column, m)));
+        }
+    }
+    std::remove(path.c_str());
+}
+
+// The number of samples depends only on the output rate, not on the simulation timestep.
+void test_rate_independent_of_timestep() {
+    for (double dt : {0.001, 0.004, 0.03, 0.25}) {
+        const std::string path = temp_path("rate");
+        EntityRegistry registry;
+        registry.register_entity(std::make_shared<DriftEntity>("drift", Vec3(), Vec3(1.0, 0.0, 0.0)));
+
+        TrajectoryRecorder recorder;
+        const bool opened = recorder.open(path, 20.0);
+        assert(opened);
+        const int ticks = static_cast<int>(std::lround(2.0 / dt));
+        recorder.record(registry, 0.0);
+        for (int i = 1; i <= ticks; ++i) {
+            recorder.record(registry, i * dt);
+        }
+        recorder.close();
+
+        TrajectoryReader reader;
+        const auto frames = read_all(path, reader);
+        // A timestep longer than the output interval yields one sample per tick
+        const std::size_t expected = dt <= 0.05 ? 41 : static_cast<std::size_t>(ticks) + 1;
+        assert(frames.size() == expected);
+        // Each sample is taken on the first tick at or after its output time
+        for (std::size_t f = 0; f < frames.size() && dt <= 0.05; ++f) {
+            const double output_time = 0.05 * static_cast<double>(f);
+            assert(frames[f].time >= output_time - 1e-9);
+            assert(frames[f].time < output_time + dt - 1e-9);
+        }
+        std::remove(path.c_str());
+    }
+}
+
+// Entities added or removed mid-run appear in and drop out of later frames with their names.
+void test_membership_changes() {
+    const std::string path = temp_path("membership");
+    EntityRegistry registry;
+    auto first = std::make_shared<DriftEntity>("first", Vec3(), Vec3());
+    registry.register_entity(first);
+
+    TrajectoryRecorder recorder;
+    const bool opened = recorder.open(path, 100.0);
+    assert(opened);
+    recorder.record(registry, 0.0);
+
+    auto second = std::make_shared<MarkerEntity>("second");
+    registry.register_entity(second);
+    recorder.record(registry, 0.01);
+
+    registry.remove_entity(first->get_id());
+    registry.apply_pending_removals();
+    recorder.record(registry, 0.02);
+    recorder.close();
+
+    TrajectoryReader reader;
+    const auto frames = read_all(path, reader);
+    assert(frames.size() == 3);
+    assert(frames[0].size() == 1 && frames[0].ids[0] == first->get_id());
+    assert(frames[1].size() == 2);
+    assert(frames[2].size() == 1 && frames[2].ids[0] == second->get_id());
+    assert(reader.entity_name(first->get_id()) == "first");
+    assert(reader.entity_name(second->get_id()) == "second");
+    std::remove(path.c_str());
+}
+
+// Sampling through TickEngine's observer (serial and parallel) writes the same frames as record().
+void test_fused_sampling_matches_record() {
+    constexpr int kEntities = 300;
+    constexpr int kTicks = 50;
+    constexpr double kDt = 0.01;
+
+    auto record_run = [&](std::size_t threads, bool fused, const std::string& path) {
+        EntityRegistry registry;
+        for (int i = 0; i < kEntities; ++i) {
+            registry.register_entity(std::make_shared<DriftEntity>("drift_" + std::to_string(i), Vec3(i, 0.0, 0.0),
+                                                                   Vec3(0.0, i, 1.0)));
+        }
+        TickEngine engine;
+        engine.configure(threads, 7);
+        TrajectoryRecorder recorder;
+        const bool opened = recorder.open(path, 25.0);
+        assert(opened);
+        double t = 0.0;
+        for (int i = 0; i < kTicks; ++i) {
+            if (fused) {
+                TickObserver* sampler = recorder.begin_sample(registry, t + kDt);
+                engine.tick(registry, t, kDt, sampler);
+                recorder.finish_sample();
+            } else {
+                engine.tick(registry, t, kDt);
+                recorder.record(registry, t + kDt);
+            }
+            t += kDt;
+        }
+        recorder.close();
+    };
+
+    const std::string reference_path = temp_path("reference");
+    record_run(1, false, reference_path);
+    TrajectoryReader reference_reader;
+    const auto reference = read_all(reference_path, reference_reader);
+    assert(reference.size() == 13); // 0.04 .. 0.48 plus the first tick at 0.01
+
+    for (std::size_t threads : {1u, 3u}) {
+        const std::string path = temp_path("fused");
+        record_run(threads, true, path);
+        TrajectoryReader reader;
+        const auto frames = read_all(path, reader);
+        assert(frames.size() == reference.size());
+        for (std::size_t f = 0; f < frames.size(); ++f) {
+            assert(frames[f].time == reference[f].time);
+            // Ids come from a global counter, so match entities by name across registries
+            assert(frames[f].size() == reference[f].size());
+            for (std::size_t i = 0; i < frames[f].size(); ++i) {
+                assert(reader.entity_name(frames[f].ids[i]) == reference_reader.entity_name(reference[f].ids[i]));
+            }
+            assert(frames[f].columns == reference[f].columns);
+        }
+        std::remove(path.c_str());
+    }
+    std::remove(reference_path.c_str());
+}
+
+void test_rejects_bad_input() {
+    TrajectoryRecorder recorder;
+    const bool opened_with_zero_rate = recorder.open(temp_path("bad_rate"), 0.0);
+    assert(!opened_with_zero_rate);
+    assert(!recorder.is_open());
+    const bool opened_missing_dir = recorder.open("/nonexistent_dir/trajectory.msft", 100.0);
+    assert(!opened_missing_dir);
+
+    const std::string path = temp_path("not_trajectory");
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    std::fputs("definitely not a trajectory file", file);
+    std::fclose(file);
+    TrajectoryReader reader;
+    const bool opened = reader.open(path);
+    assert(!opened);
+    assert(!reader.get_error().empty());
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    test_round_trip();
+    test_rate_independent_of_timestep();
+    test_membership_changes();
+    test_fused_sampling_matches_record();
+    test_rejects_bad_input();
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "PhysicsEntity.hpp"
+#include "TestSupport.hpp"
+#include "TickEngine.hpp"
+
+namespace {
+
+class Glider : public PhysicsEntity {
+public:
+    Glider(const std::string& name, double phase) : PhysicsEntity(name), phase_(phase) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<Glider>("glider", phase_);
+    }
+
+    void update(const double t, const double dt) override {
+        ++updates;
+        set_acceleration(Vec3(std::sin(t + phase_), std::cos(t - phase_), phase_));
+        PhysicsEntity::update(t, dt);
+    }
+
+    int updates = 0;
+
+protected:
+    double phase_;
+};
+
+// Subclass of a registered class; its own override must still run.
+class SpinningGlider final : public Glider {
+public:
+    using Glider::Glider;
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<SpinningGlider>("spinning", phase_);
+    }
+
+    void update(const double t, const double dt) override {
+        ++spins;
+        set_angular_acceleration(Vec3(0.0, 0.0, phase_));
+        Glider::update(t, dt);
+    }
+
+    int spins = 0;
+};
+
+// Plugin class nobody registered
+class Drifter final : public PhysicsEntity {
+public:
+    explicit Drifter(const std::string& name) : PhysicsEntity(name) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<Drifter>("drifter");
+    }
+
+    void update(const double t, const double dt) override {
+        set_velocity(Vec3(1.0, t, 0.0));
+        PhysicsEntity::update(t, dt);
+    }
+};
+
+struct World {
+    EntityRegistry registry;
+    std::vector<std::shared_ptr<Glider>> gliders;
+    std::vector<std::shared_ptr<SpinningGlider>> spinners;
+    std::vector<std::shared_ptr<Drifter>> drifters;
+
+    explicit World(int count) {
+        registry.register_update_class<Glider>();
+        for (int i = 0; i < count; ++i) {
+            // Interleaved so the registration order mixes types
+            switch (i % 3) {
+            case 0:
+                gliders.push_back(registry.spawn<Glider>("g" + std::to_string(i), 0.01 * i));
+                break;
+            case 1:
+                drifters.push_back(registry.spawn<Drifter>("d" + std::to_string(i)));
+                break;
+            default:
+                spinners.push_back(registry.spawn<SpinningGlider>("s" + std::to_string(i), 0.01 * i));
+                break;
+            }
+        }
+    }
+};
+
+// The snapshot is grouped by class: registered classes first, then everything else in slot order.
+void test_snapshot_runs() {
+    World world(30);
+    std::vector<Entity*> entities;
+    std::vector<EntityRegistry::UpdateRun> runs;
+    world.registry.collect_entities(entities, &runs);
+    assert(entities.size() == 30);
+    assert(runs.size() == 2);
+    assert(runs[0].begin == 0 && runs[0].end == 10 && runs[0].update != nullptr);
+    assert(runs[1].begin == 10 && runs[1].end == 30 && runs[1].update == nullptr);
+    for (std::size_t i = 0; i < 10; ++i) {
+        assert(entities[i] == world.gliders[i].get());
+    }
+
+    // Registering another class invalidates cached snapshots
+    const uint64_t revision = world.registry.get_revision();
+    world.registry.register_update_class<Drifter>();
+    assert(world.registry.get_revision() != revision);
+    world.registry.collect_entities(entities, &runs);
+    assert(runs.size() == 3 && runs[1].end - runs[1].begin == 10 && runs[1].update != nullptr);
+}
+
+// Bucketed and virtual dispatch, serial and parallel, produce the same state.
+void test_dispatch_paths_agree() {
+    constexpr int kCount = 300;
+    World reference(kCount);
+    TickEngine virtual_engine;
+    virtual_engine.configure(1, 0);
+    virtual_engine.set_bucketed_dispatch(false);
+
+    World serial(kCount);
+    TickEngine serial_engine;
+    serial_engine.configure(1, 0);
+    assert(serial_engine.is_bucketed_dispatch());
+
+    World parallel(kCount);
+    parallel.registry.register_update_class<Drifter>();
+    TickEngine parallel_engine;
+    parallel_engine.configure(3, 7);
+
+    const double dt = 0.01;
+    for (int tick = 0; tick < 50; ++tick) {
+        virtual_engine.tick(reference.registry, tick * dt, dt);
+        serial_engine.tick(serial.registry, tick * dt, dt);
+        parallel_engine.tick(parallel.registry, tick * dt, dt);
+    }
+
+    for (std::size_t i = 0; i < reference.gliders.size(); ++i) {
+        assert(serial.gliders[i]->updates == 50 && parallel.gliders[i]->updates == 50);
+        assert(same_bits(reference.gliders[i]->get_position(), serial.gliders[i]->get_position()));
+        assert(same_bits(reference.gliders[i]->get_position(), parallel.gliders[i]->get_position()));
+    }
+    for (std::size_t i = 0; i < reference.spinners.size(); ++i) {
+        assert(serial.spinners[i]->spins == 50 && parallel.spinners[i]->spins == 50);
+        assert(same_bits(reference.spinners[i]->get_angular_velocity(), serial.spinners[i]->get_angular_velocity()));
+        assert(same_bits(reference.spinners[i]->get_position(), parallel.spinners[i]->get_position()));
+    }
+    for (std::size_t i = 0; i < reference.drifters.size(); ++i) {
+        assert(same_bits(reference.drifters[i]->get_position(), serial.drifters[i]->get_position()));
+        assert(same_bits(reference.drifters[i]->get_position(), parallel.drifters[i]->get_position()));
+    }
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    test_snapshot_runs();
+    test_dispatch_paths_agree();
+    return 0;
+}
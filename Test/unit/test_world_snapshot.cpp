@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EntityRegistry.hpp"
+#include "Logger.hpp"
+#include "PhysicsEntity.hpp"
+#include "TestSupport.hpp"
+#include "TickEngine.hpp"
+
+namespace {
+
+// Steers toward the entity it chases and moves itself there directly, so a chaser updated after its
+// target sees a different target position than one updated before it, unless it reads the snapshot.
+class Chaser : public PhysicsEntity {
+public:
+    Chaser(const std::string& name, const EntityRegistry* registry, bool snapshot_reads)
+        : PhysicsEntity(name), registry_(registry), snapshot_reads_(snapshot_reads) {}
+
+    std::unique_ptr<Entity> create() override {
+        return std::make_unique<Chaser>("chaser", registry_, snapshot_reads_);
+    }
+
+    bool reads_other_entities() const override {
+        return snapshot_reads_;
+    }
+
+    void update(const double t, const double dt) override {
+        const std::shared_ptr<Entity> target = registry_->get_entity(target_id);
+        const Vec3 aim = snapshot_reads_ ? target->get_snapshot_position() : target->get_position();
+        set_position(get_position() + (aim - get_position()) * 0.25);
+        set_acceleration(Vec3(0.0, 0.0, -1.0));
+        PhysicsEntity::update(t, dt);
+    }
+
+    int target_id = -1;
+
+private:
+    const EntityRegistry* registry_;
+    bool snapshot_reads_;
+};
+
+class Observer : public TickObserver {
+public:
+    void on_entity_updated(std::size_t, const Entity&) override {}
+};
+
+// A ring of chasers, each chasing the next. Created in the same order (same IDs), registered in either order.
+struct Ring {
+    static constexpr int kSize = 48;
+
+    EntityRegistry registry;
+    TickEngine engine;
+    std::vector<std::shared_ptr<Chaser>> chasers;
+
+    Ring(bool snapshot_reads, bool reverse, std::size_t threads) {
+        Entity::set_next_id(0);
+        for (int i = 0; i < kSize; ++i) {
+            auto chaser = std::make_shared<Chaser>("chaser_" + std::to_string(i), &registry, snapshot_reads);
+            chaser->set_position(Vec3(std::cos(i * 0.3) * 100.0, std::sin(i * 0.3) * 100.0, i));
+            chasers.push_back(chaser);
+        }
+        for (int i = 0; i < kSize; ++i) {
+            chasers[i]->target_id = chasers[(i + 1) % kSize]->get_id();
+        }
+        std::vector<std::shared_ptr<Chaser>> order = chasers;
+        if (reverse) {
+            std::reverse(order.begin(), order.end());
+        }
+        for (const auto& chaser : order) {
+            registry.register_entity(chaser);
+        }
+        engine.configure(threads, 2);
+    }
+
+    void run(int ticks, double dt, TickObserver* observer = nullptr) {
+        for (int i = 0; i < ticks; ++i) {
+            engine.tick(registry, i * dt, dt, observer);
+        }
+    }
+
+    bool same_as(const Ring& other) const {
+        for (int i = 0; i < kSize; ++i) {
+            if (!same_bits(chasers[i]->get_position(), other.chasers[i]->get_position())) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+void test_snapshot_enabled_by_readers() {
+    EntityRegistry registry;
+    auto plain = std::make_shared<Chaser>("plain", &registry, false);
+    registry.register_entity(plain);
+    assert(!registry.get_physics_store().is_snapshot_enabled());
+
+    auto reader = std::make_shared<Chaser>("reader", &registry, true);
+    registry.register_entity(reader);
+    assert(registry.get_physics_store().is_snapshot_enabled());
+
+    // Outside a tick the snapshot getters return the live state
+    plain->set_position(Vec3(1.0, 2.0, 3.0));
+    assert(same_bits(plain->get_snapshot_position(), Vec3(1.0, 2.0, 3.0)));
+    plain->set_velocity(Vec3(4.0, 5.0, 6.0));
+    assert(same_bits(plain->get_snapshot_velocity(), Vec3(4.0, 5.0, 6.0)));
+
+    // Published: frozen until retired, whatever the live state does
+    PhysicsStore& store = registry.get_physics_store();
+    store.publish_snapshot();
+    plain->set_position(Vec3(7.0, 8.0, 9.0));
+    assert(same_bits(plain->get_snapshot_position(), Vec3(1.0, 2.0, 3.0)));
+    assert(same_bits(plain->get_position(), Vec3(7.0, 8.0, 9.0)));
+    store.retire_snapshot();
+    assert(same_bits(plain->get_snapshot_position(), Vec3(7.0, 8.0, 9.0)));
+}
+
+void test_reads_independent_of_order_and_threads() {
+    const double dt = 0.01;
+    Ring forward(true, false, 1);
+    Ring backward(true, true, 1);
+    Ring parallel(true, true, 4);
+    Ring observed(true, false, 4);
+    Observer observer;
+    forward.run(200, dt);
+    backward.run(200, dt);
+    parallel.run(200, dt);
+    observed.run(200, dt, &observer); // Immediate integration, as when sampling a trajectory
+    assert(forward.same_as(backward));
+    assert(forward.same_as(parallel));
+    assert(forward.same_as(observed));
+
+    // Every chaser saw where its target was when the tick began: one step of the ring by hand
+    Ring stepped(true, false, 1);
+    std::vector<Vec3> before;
+    for (const auto& chaser : stepped.chasers) {
+        before.push_back(chaser->get_position());
+    }
+    stepped.run(1, dt);
+    for (int i = 0; i < Ring::kSize; ++i) {
+        const Vec3 moved = before[i] + (before[(i + 1) % Ring::kSize] - before[i]) * 0.25;
+        const double fall = (0.0 - 1.0 * dt) * dt; // Then one Euler step of the constant acceleration
+        assert(same_bits(stepped.chasers[i]->get_position(), Vec3(moved.get_x(), moved.get_y(), moved.get_z() + fall)));
+    }
+
+    // Reading live state instead makes the result depend on the update order
+    Ring live_forward(false, false, 1);
+    Ring live_backward(false, true, 1);
+    live_forward.run(200, dt);
+    live_backward.run(200, dt);
+    assert(!live_forward.same_as(live_backward));
+}
+
+} // namespace
+
+int main() {
+    msf::Logger::instance().set_level(msf::LogLevel::Off);
+
+    test_snapshot_enabled_by_readers();
+    test_reads_independent_of_order_and_threads();
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "XMLParser.hpp"
+
+namespace {
+
+const char* kDocument = R"(<?xml version="1.0" encoding="UTF-8"?>
+<!-- Leading comment -->
+<Root version='2'>
+    <Setup>
+        <TimeStepInterval>  0.01
+        </TimeStepInterval>
+        <Flag enabled="true" enabled="false"/>
+    </Setup>
+    <!-- <Entity name="commented out"/> -->
+    <Entity name="a" kind="missile">
+        <position x="1.5" y="-2" z="3e2"/>
+    </Entity>
+    <Other/>
+    <Entity name="b"/>
+    <Entity name="c">text<Child/>  more text  </Entity>
+</Root>
+)";
+
+void test_navigation() {
+    XMLParser parser;
+    assert(parser.load_string(kDocument));
+    assert(parser.get_error().empty());
+
+    const XMLParser::XMLNode root = parser.get_root();
+    assert(root.is_valid());
+    assert(root.get_name() == "Root");
+    assert(root.get_attribute("version") == std::optional<std::string>("2"));
+    assert(!root.get_attribute("missing").has_value());
+    assert(!root.get_text().has_value());
+
+    const XMLParser::XMLNode step = parser.find_element("Setup").get_child("TimeStepInterval");
+    assert(step.get_text() == std::optional<std::string>("0.01"));
+    // A repeated attribute reads as its last value
+    assert(parser.find_element("Setup").get_child("Flag").get_attribute("enabled") == std::optional<std::string>("false"));
+
+    const std::vector<XMLParser::XMLNode> entities = root.get_children("Entity");
+    assert(entities.size() == 3);
+    assert(entities[0].get_attribute("name") == std::optional<std::string>("a"));
+    assert(entities[0].get_attribute("kind") == std::optional<std::string>("missile"));
+    assert(entities[0].get_child("position").get_attribute("z") == std::optional<std::string>("3e2"));
+    assert(entities[1].get_attribute("name") == std::optional<std::string>("b"));
+    assert(entities[2].get_text() == std::optional<std::string>("more text")); // Last text run
+    assert(entities[2].get_child("Child").is_valid());
+
+    // Missing nodes are invalid and every getter on them is empty
+    const XMLParser::XMLNode missing = root.get_child("Nope").get_child("Deeper");
+    assert(!missing.is_valid());
+    assert(missing.get_name().empty());
+    assert(!missing.get_attribute("x").has_value());
+    assert(!missing.get_text().has_value());
+    assert(missing.get_children("x").empty());
+    assert(!XMLParser::XMLNode().is_valid());
+
+    // Nodes stay valid while a copy of the parser holds the document
+    XMLParser copy = parser;
+    parser = XMLParser();
+    assert(entities[0].get_child("position").get_attribute("x") == std::optional<std::string>("1.5"));
+    assert(copy.get_root().get_name() == "Root");
+}
+
+void test_load_file_matches_load_string() {
+    const std::string path = "test_xml_parser.xml";
+    std::ofstream(path) << kDocument;
+
+    XMLParser from_file;
+    assert(from_file.load_file(path));
+    XMLParser from_string;
+    assert(from_string.load_string(kDocument));
+    std::remove(path.c_str());
+
+    const std::vector<XMLParser::XMLNode> a = from_file.get_root().get_children("Entity");
+    const std::vector<XMLParser::XMLNode> b = from_string.get_root().get_children("Entity");
+    assert(a.size() == b.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        assert(a[i].get_attribute("name") == b[i].get_attribute("name"));
+        assert(a[i].get_text() == b[i].get_text());
+    }
+    // The mapping is released with the document; the nodes above kept it alive until here
+    assert(from_file.get_root().get_child("Setup").get_child("TimeStepInterval").get_text() ==
+           std::optional<std::string>("0.01"));
+}
+
+void test_errors() {
+    XMLParser parser;
+    assert(!parser.load_file("does_not_exist.xml"));
+    assert(parser.get_error().find("Failed to open file") != std::string::npos);
+    assert(!parser.get_root().is_valid());
+
+    const char* malformed[] = {
+        "",
+        "no markup",
+        "<a><b></a>",
+        "<a><b></b>",
+        "<a x=1/>",
+        "<a x=\"1/>",
+        "<a \"x\"/>",
+        "<a><b x='1'></c></a>",
+    };
+    for (const char* xml : malformed) {
+        assert(!parser.load_string(xml));
+        assert(!parser.get_error().empty());
+        assert(!parser.get_root().is_valid());
+    }
+
+    // A failed load doesn't leave its error behind for the next one
+    assert(parser.load_string("<a/>"));
+    assert(parser.get_error().empty());
+    assert(parser.get_root().get_name() == "a");
+
+    // An empty file is read rather than mapped, and is not a document
+    const std::string path = "test_xml_parser_empty.xml";
+    std::ofstream(path).close();
+    assert(!parser.load_file(path));
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main() {
+    test_navigation();
+    test_load_file_matches_load_string();
+    test_errors();
+    return 0;
+}